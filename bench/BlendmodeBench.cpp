@@ -20,14 +20,16 @@ enum Type {
     kText,
     kRect,
     kSprite,
+    kWideRect,
 };
 }
 
 const char* gTypeNames[] = {
-    "mask", "rect", "sprite",
+    "mask", "rect", "sprite", "widerect",
 };
 
 // Benchmark that draws non-AA rects or AA text with an SkXfermode::Mode.
+// kWideRect draws full-width rects, so that long runs of full-width pipeline stages dominate.
 class XfermodeBench : public Benchmark {
 public:
     XfermodeBench(SkBlendMode mode, Type t) : fBlendMode(mode) {
@@ -83,6 +85,18 @@ protected:
                     }
                     loops -= iterations;
                 } break;
+                case kWideRect: {
+                    SkScalar h = random.nextRangeScalar(50, 100);
+                    SkRect rect = SkRect::MakeXYWH(0,
+                                                   random.nextUScalar1() * (size.fHeight - h),
+                                                   (SkScalar)size.fWidth,
+                                                   h);
+                    int iterations = std::min(100, loops);
+                    for (int j = 0; j < iterations; ++j) {
+                        canvas->drawRect(rect, paint);
+                    }
+                    loops -= iterations;
+                } break;
                 case kSprite:
                     paint.setAlphaf(1.0f);
                     for (int i = 0; i < 10; ++i) {
@@ -142,3 +156,8 @@ BENCH(SkBlendMode::kHue)
 BENCH(SkBlendMode::kSaturation)
 BENCH(SkBlendMode::kColor)
 BENCH(SkBlendMode::kLuminosity)
+
+DEF_BENCH( return new XfermodeBench(SkBlendMode::kSrc,      kWideRect); )
+DEF_BENCH( return new XfermodeBench(SkBlendMode::kSrcOver,  kWideRect); )
+DEF_BENCH( return new XfermodeBench(SkBlendMode::kMultiply, kWideRect); )
+DEF_BENCH( return new XfermodeBench(SkBlendMode::kOverlay,  kWideRect); )
@@ -16,6 +16,10 @@
 static DEFINE_bool(zero_init, false,
                    "Pretend our destination is zero-intialized, simulating Android?");
 
+static DEFINE_int(codec_threads, 0,
+                  "If > 0, decode with SkCodec::Options::fExecutor set to a pool of this many "
+                  "threads.");
+
 CodecBench::CodecBench(SkString baseName, SkData* encoded, SkColorType colorType,
         SkAlphaType alphaType)
     : fColorType(colorType)
@@ -25,6 +29,9 @@ CodecBench::CodecBench(SkString baseName, SkData* encoded, SkColorType colorType
     // Parse filename and the color type to give the benchmark a useful name
     fName.printf("Codec_%s_%s%s", baseName.c_str(), color_type_to_str(colorType),
             alpha_type_to_str(alphaType));
+    if (FLAGS_codec_threads > 0) {
+        fName.appendf("_threads%d", FLAGS_codec_threads);
+    }
     // Ensure that we can create an SkCodec from this data.
     SkASSERT(SkCodec::MakeFromData(fData));
 }
@@ -45,6 +52,10 @@ void CodecBench::onDelayedSetup() {
                             .makeColorSpace(nullptr);
 
     fPixelStorage.reset(fInfo.computeMinByteSize());
+
+    if (FLAGS_codec_threads > 0 && !fExecutor) {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(FLAGS_codec_threads);
+    }
 }
 
 void CodecBench::onDraw(int n, SkCanvas* canvas) {
@@ -53,6 +64,7 @@ void CodecBench::onDraw(int n, SkCanvas* canvas) {
     if (FLAGS_zero_init) {
         options.fZeroInitialized = SkCodec::kYes_ZeroInitialized;
     }
+    options.fExecutor = fExecutor.get();
     for (int i = 0; i < n; i++) {
         codec = SkCodec::MakeFromData(fData);
 #ifdef SK_DEBUG
@@ -10,11 +10,14 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkString.h"
 #include "src/core/SkAutoMalloc.h"
 
+#include <memory>
+
 /**
  *  Time SkCodec.
  */
@@ -36,6 +39,7 @@ private:
     sk_sp<SkData>           fData;
     SkImageInfo             fInfo;          // Set in onDelayedSetup.
     SkAutoMalloc            fPixelStorage;
+    std::unique_ptr<SkExecutor> fExecutor;  // Set in onDelayedSetup with --codec_threads.
     using INHERITED = Benchmark;
 };
 #endif // CodecBench_DEFINED
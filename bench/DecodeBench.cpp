@@ -6,9 +6,13 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/codec/SkCodec.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPictureRecorder.h"
+#include "include/core/SkStream.h"
 #include "modules/skottie/include/Skottie.h"
+#include "src/utils/SkJSON.h"
 #include "tools/Resources.h"
 
 class DecodeBench : public Benchmark {
@@ -54,6 +58,40 @@ private:
     using INHERITED = DecodeBench;
 };
 
+// Decodes with SkCodec::getPixels(), optionally passing an executor in SkCodec::Options.
+class CodecDecodeBench final : public DecodeBench {
+public:
+    CodecDecodeBench(const char* name, const char* source, int threads)
+        : INHERITED(name, source)
+        , fThreads(threads)
+    {}
+
+    void onDelayedSetup() override {
+        INHERITED::onDelayedSetup();
+        fPixels.allocPixels(SkCodec::MakeFromData(fData)->getInfo()
+                                                        .makeColorType(kN32_SkColorType)
+                                                        .makeAlphaType(kPremul_SkAlphaType));
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkCodec::Options options;
+        options.fExecutor = fExecutor.get();
+        while (loops-- > 0) {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(fData);
+            SkAssertResult(SkCodec::kSuccess == codec->getPixels(fPixels.pixmap(), &options));
+        }
+    }
+
+private:
+    const int                   fThreads;
+    SkBitmap                    fPixels;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+    using INHERITED = DecodeBench;
+};
 
 class SkottieDecodeBench final : public DecodeBench {
 public:
@@ -72,6 +110,33 @@ private:
     using INHERITED = DecodeBench;
 };
 
+// Loads the animation from its pre-parsed binary encoding (see skjson::DOM::writeBinary).
+class SkottieBinaryDecodeBench final : public DecodeBench {
+public:
+    SkottieBinaryDecodeBench(const char* name, const char* source)
+        : INHERITED(name, source)
+    {}
+
+    void onDelayedSetup() override {
+        INHERITED::onDelayedSetup();
+
+        const skjson::DOM dom(static_cast<const char*>(fData->data()), fData->size());
+        SkDynamicMemoryWStream stream;
+        dom.writeBinary(&stream);
+        fData = stream.detachAsData();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            const auto anim = skottie::Animation::Make(reinterpret_cast<const char*>(fData->data()),
+                                                       fData->size());
+        }
+    }
+
+private:
+    using INHERITED = DecodeBench;
+};
+
 class SkottiePictureDecodeBench final : public DecodeBench {
 public:
     SkottiePictureDecodeBench(const char* name, const char* source)
@@ -100,6 +165,12 @@ DEF_BENCH(return new SkottieDecodeBench("skottie_medium", //  10947
                                         "skottie/skottie-sphere-effect.json"));
 DEF_BENCH(return new SkottieDecodeBench("skottie_small",  //   1112
                                         "skottie/skottie_sample_multiframe.json"));
+DEF_BENCH(return new SkottieBinaryDecodeBench("skottie_large_binary",
+                                              "skottie/skottie-text-scale-to-fit-minmax.json"));
+DEF_BENCH(return new SkottieBinaryDecodeBench("skottie_medium_binary",
+                                              "skottie/skottie-sphere-effect.json"));
+DEF_BENCH(return new SkottieBinaryDecodeBench("skottie_small_binary",
+                                              "skottie/skottie_sample_multiframe.json"));
 // Created from PhoneHub assets SVG source, with https://lottiefiles.com/svg-to-lottie
 DEF_BENCH(return new SkottieDecodeBench("skottie_phonehub_connecting.json",    // 216x216
                                         "skottie/skottie-phonehub-connecting.json"));
@@ -233,3 +304,10 @@ DEF_BENCH(return new BitmapDecodeBench("png_small"    /*  32x  32*/, "images/man
 DEF_BENCH(return new BitmapDecodeBench("png_phonehub_connecting"   , "images/Connecting.png"));
 DEF_BENCH(return new BitmapDecodeBench("png_phonehub_generic_error", "images/Generic_Error.png"));
 DEF_BENCH(return new BitmapDecodeBench("png_phonehub_onboard"      , "images/Onboard.png"));
+
+DEF_BENCH(return new CodecDecodeBench("codec_png_large", "images/mandrill_1600.png", 0));
+DEF_BENCH(return new CodecDecodeBench("codec_png_large_threads2",
+                                      "images/mandrill_1600.png", 2));
+DEF_BENCH(return new CodecDecodeBench("codec_jpeg_restart", "images/restart_markers.jpg", 0));
+DEF_BENCH(return new CodecDecodeBench("codec_jpeg_restart_threads4",
+                                      "images/restart_markers.jpg", 4));
@@ -46,6 +46,7 @@ static const GradData gGradData[] = {
     { 3, gColors, nullptr, "_3color" },
     { 2, gShallowColors, nullptr, "_shallow" },
     { 2, gColors, gPos, "_pos" },
+    { 12, gColors, nullptr, "_12color" }, // too many stops for one AVX2 register, not AVX-512
 };
 
 /// Ignores scale
@@ -260,6 +261,7 @@ DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[0]); )
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[1]); )
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[2]); )
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[4]); )
+DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[5]); )
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[0], SkTileMode::kRepeat); )
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[1], SkTileMode::kRepeat); )
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[2], SkTileMode::kRepeat); )
@@ -6,7 +6,9 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkTaskGroup.h"
 
 namespace {
 static void* gGlobalAddress;
@@ -14,8 +16,8 @@ class TestKey : public SkResourceCache::Key {
 public:
     intptr_t fValue;
 
-    TestKey(intptr_t value) : fValue(value) {
-        this->init(&gGlobalAddress, 0, sizeof(fValue));
+    TestKey(intptr_t value, uint64_t sharedID = 0) : fValue(value) {
+        this->init(&gGlobalAddress, sharedID, sizeof(fValue));
     }
 };
 struct TestRec : public SkResourceCache::Rec {
@@ -72,6 +74,63 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Every thread repeatedly looks up the same spread of recs in the global cache, as raster
+// threads do for bitmaps and masks, so the time is dominated by the cache's synchronization.
+// Each thread does the same amount of work regardless of the thread count, so with perfect
+// scaling the time stays flat as threads grow.
+class ImageCacheThreadedBench : public Benchmark {
+    enum {
+        CACHE_COUNT = 500
+    };
+public:
+    explicit ImageCacheThreadedBench(int threads) : fThreads(threads) {
+        fName.printf("imagecache_global_%dthreads", fThreads);
+    }
+
+    ~ImageCacheThreadedBench() override {
+        SkResourceCache::PostPurgeSharedID(kSharedID);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads, false);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkTaskGroup group(*fExecutor);
+        group.batch(fThreads, [&](int threadIndex) {
+            for (int work = 0; work < loops; work++) {
+                // Start each thread at a different rec so they don't march in lockstep.
+                for (int i = 0; i < CACHE_COUNT; i++) {
+                    TestKey key((i + threadIndex * 7) % CACHE_COUNT, kSharedID);
+                    if (!SkResourceCache::Find(key, TestRec::Visitor, nullptr)) {
+                        SkResourceCache::Add(new TestRec(key, key.fValue));
+                    }
+                }
+            }
+        });
+        group.wait();
+    }
+
+private:
+    // Tags this bench's recs so they can be purged from the global cache when it is done.
+    static constexpr uint64_t kSharedID = 0x1ca6ecac4eULL;
+
+    using INHERITED = Benchmark;
+    const int fThreads;
+    SkString fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new ImageCacheBench(); )
+DEF_BENCH( return new ImageCacheThreadedBench(1); )
+DEF_BENCH( return new ImageCacheThreadedBench(4); )
+DEF_BENCH( return new ImageCacheThreadedBench(16); )
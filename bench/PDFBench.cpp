@@ -9,10 +9,13 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
+#include "include/core/SkDocument.h"
 #include "include/core/SkExecutor.h"
+#include "include/core/SkFont.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkString.h"
 #include "include/effects/SkGradientShader.h"
 #include "include/private/SkTo.h"
 #include "include/utils/SkRandom.h"
@@ -302,6 +305,64 @@ struct PDFClipPathBenchmark : public Benchmark {
     }
 };
 
+// Multi-page throughput: each page has text, vector art, and its own image to encode,
+// so with an executor, content compression, image encoding and font subsetting overlap.
+struct PDFMultiPageBench : public Benchmark {
+    PDFMultiPageBench(int pages, bool threaded) : fPages(pages), fThreaded(threaded) {
+        fName.printf("PDFMultiPage_%d_%s", pages, threaded ? "threaded" : "serial");
+    }
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+    void onDelayedSetup() override {
+        if (fThreaded) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+        SkRandom rand;
+        for (int i = 0; i < fPages; i++) {
+            SkBitmap bm;
+            bm.allocN32Pixels(128, 128);
+            for (int y = 0; y < 128; y++) {
+                for (int x = 0; x < 128; x++) {
+                    *bm.getAddr32(x, y) = rand.nextU() | 0xFF000000;
+                }
+            }
+            bm.setImmutable();
+            fImages.push_back(bm.asImage());
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        SkFont font;
+        font.setSize(12);
+        SkPaint paint;
+        while (loops-- > 0) {
+            SkNullWStream wStream;
+            SkPDF::Metadata metadata;
+            metadata.fExecutor = fExecutor.get();
+            sk_sp<SkDocument> doc = SkPDF::MakeDocument(&wStream, metadata);
+            for (int page = 0; page < fPages; page++) {
+                SkCanvas* canvas = doc->beginPage(612, 792);
+                // Each page draws a different image, so none are deduplicated.
+                canvas->drawImage(fImages[page], 36, 36);
+                for (int line = 0; line < 40; line++) {
+                    canvas->drawString("The quick brown fox jumps over the lazy dog.",
+                                       36, 200 + 14 * line, font, paint);
+                }
+                canvas->drawCircle(306, 700, 50 + page % 20, paint);
+                doc->endPage();
+            }
+            doc->close();
+        }
+    }
+
+    const int fPages;
+    const bool fThreaded;
+    SkString fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+    std::vector<sk_sp<SkImage>> fImages;
+};
+
 }  // namespace
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
@@ -310,6 +371,8 @@ DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WritePDFTextBenchmark;)
 DEF_BENCH(return new PDFClipPathBenchmark;)
+DEF_BENCH(return new PDFMultiPageBench(100, false);)
+DEF_BENCH(return new PDFMultiPageBench(100, true);)
 
 #ifdef SK_PDF_ENABLE_SLOW_TESTS
 #include "include/core/SkExecutor.h"
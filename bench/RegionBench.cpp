@@ -7,8 +7,11 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkRegion.h"
 #include "include/core/SkString.h"
+#include "include/private/SkTo.h"
 #include "include/utils/SkRandom.h"
 
+#include <vector>
+
 static bool union_proc(SkRegion& a, SkRegion& b) {
     SkRegion result;
     return result.op(a, b, SkRegion::kUnion_Op);
@@ -116,9 +119,52 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Builds a region from many small rects, as damage tracking does, either one union at a time or
+// all at once with setRects().
+class RegionBuildBench : public Benchmark {
+public:
+    RegionBuildBench(int count, bool bulk) : fBulk(bulk) {
+        fName.printf("region_build_%s_%d", bulk ? "setrects" : "union", count);
+
+        SkRandom rand;
+        for (int i = 0; i < count; i++) {
+            int x = rand.nextU() % 1920,
+                y = rand.nextU() % 1080;
+            fRects.push_back(SkIRect::MakeXYWH(x, y, rand.nextRangeU(4, 64),
+                                                     rand.nextRangeU(4, 32)));
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            SkRegion rgn;
+            if (fBulk) {
+                rgn.setRects(fRects.data(), SkToInt(fRects.size()));
+            } else {
+                for (const SkIRect& r : fRects) {
+                    rgn.op(r, SkRegion::kUnion_Op);
+                }
+            }
+        }
+    }
+
+private:
+    std::vector<SkIRect> fRects;
+    bool                 fBulk;
+    SkString             fName;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #define SMALL   16
+#define LARGE   128
 
 DEF_BENCH(return new RegionBench(SMALL, union_proc, "union");)
 DEF_BENCH(return new RegionBench(SMALL, sect_proc, "intersect");)
@@ -129,3 +175,11 @@ DEF_BENCH(return new RegionBench(SMALL, containsrect_proc, "containsrect");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrgn_proc, "intersectsrgn");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrect_proc, "intersectsrect");)
 DEF_BENCH(return new RegionBench(SMALL, containsxy_proc, "containsxy");)
+
+DEF_BENCH(return new RegionBench(LARGE, union_proc, "union");)
+DEF_BENCH(return new RegionBench(LARGE, sect_proc, "intersect");)
+DEF_BENCH(return new RegionBench(LARGE, diff_proc, "difference");)
+DEF_BENCH(return new RegionBench(LARGE, diffrect_proc, "differencerect");)
+
+DEF_BENCH(return new RegionBuildBench(1000, false);)
+DEF_BENCH(return new RegionBuildBench(1000, true);)
@@ -10,9 +10,11 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/chromium/SkChromeRemoteGlyphCache.h"
+#include "src/core/SkStrikeCache.h"
 #include "src/core/SkStrikeSpec.h"
 #include "src/core/SkTLazy.h"
 #include "src/core/SkTaskGroup.h"
@@ -118,6 +120,72 @@ DEF_BENCH( return new SkGlyphCacheBasic(32 * 1024 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(32 * 1024 * 1024); )
 
+// Every thread repeatedly looks up the same spread of already-cached strikes, so the time is
+// dominated by the strike cache's own synchronization. Each thread does the same amount of work
+// regardless of the thread count, so with perfect scaling the time stays flat as threads grow.
+class SkStrikeCacheLookupBench : public Benchmark {
+public:
+    explicit SkStrikeCacheLookupBench(int threads) : fThreads(threads) {
+        fName.printf("SkStrikeCacheLookup_%dthreads", fThreads);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads, false);
+        fCache = std::make_unique<SkStrikeCache>();
+
+        sk_sp<SkTypeface> typefaces[] = {
+                ToolUtils::create_portable_typeface("serif", SkFontStyle::Italic()),
+                ToolUtils::create_portable_typeface("sans-serif", SkFontStyle::Normal())};
+        SkPaint defaultPaint;
+        for (const sk_sp<SkTypeface>& typeface : typefaces) {
+            SkFont font(typeface);
+            font.setEdging(SkFont::Edging::kAntiAlias);
+            font.setSubpixel(true);
+            for (SkScalar size = 8; size < 72; size++) {
+                font.setSize(size);
+                fSpecs.push_back(SkStrikeSpec::MakeMask(
+                        font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                        SkScalerContextFlags::kNone, SkMatrix::I()));
+                (void)fSpecs.back().findOrCreateStrike(fCache.get());
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkTaskGroup group(*fExecutor);
+        group.batch(fThreads, [&](int threadIndex) {
+            for (int work = 0; work < loops; work++) {
+                // Start each thread at a different strike so they don't march in lockstep.
+                for (size_t i = 0; i < fSpecs.size(); i++) {
+                    const SkStrikeSpec& spec = fSpecs[(i + threadIndex * 7) % fSpecs.size()];
+                    (void)spec.findOrCreateStrike(fCache.get());
+                }
+            }
+        });
+        group.wait();
+    }
+
+private:
+    using INHERITED = Benchmark;
+    const int fThreads;
+    SkString fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+    std::unique_ptr<SkStrikeCache> fCache;
+    std::vector<SkStrikeSpec> fSpecs;
+};
+
+DEF_BENCH( return new SkStrikeCacheLookupBench(1); )
+DEF_BENCH( return new SkStrikeCacheLookupBench(4); )
+DEF_BENCH( return new SkStrikeCacheLookupBench(16); )
+DEF_BENCH( return new SkStrikeCacheLookupBench(32); )
+
 namespace {
 class DiscardableManager : public SkStrikeServer::DiscardableHandleManager,
                            public SkStrikeClient::DiscardableHandleManager {
@@ -8,15 +8,23 @@
 #include "bench/ResultsWriter.h"
 #include "bench/SkSLBench.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkSpan.h"
+#include "include/core/SkString.h"
+#include "include/effects/SkRuntimeEffect.h"
+#include "include/private/SkMutex.h"
+#include "src/core/SkRuntimeEffectPriv.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/mock/GrMockCaps.h"
 #include "src/sksl/SkSLCompiler.h"
 #include "src/sksl/SkSLModuleLoader.h"
 #include "src/sksl/SkSLParser.h"
+#include "src/sksl/SkSLUtil.h"
 #include "src/sksl/codegen/SkSLVMCodeGenerator.h"
 #include "src/sksl/ir/SkSLProgram.h"
 
+#include <map>
 #include <regex>
 
 #include "src/sksl/generated/sksl_shared.minified.sksl"
@@ -628,3 +636,175 @@ DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_graphite",
                                                    SkSL::ProgramKind::kGraphiteVertex,
                                                    SkSL::ProgramKind::kGraphiteFragment,
                                            });)
+
+// Builds `count` distinct runtime shaders, loosely modeled on the effects an app creates at startup.
+static std::vector<std::string> make_runtime_effect_corpus(int count) {
+    static constexpr const char* kIntrinsics[] = {
+            "sin", "cos", "fract", "abs", "sqrt", "exp", "log2", "inversesqrt",
+    };
+    std::vector<std::string> corpus;
+    corpus.reserve(count);
+    for (int index = 0; index < count; ++index) {
+        SkString src = SkStringPrintf(
+                "uniform half4 color;"
+                "uniform float scale;"
+                "float wave_%d(float x) { return %s(x * scale + %d.5); }"
+                "half4 main(float2 xy) {"
+                "    float v = 0;"
+                "    for (int i = 0; i < %d; ++i) {"
+                "        v += wave_%d(xy.x + float(i));"
+                "    }"
+                "    return color * half(mix(0.%d, v, fract(xy.y)));"
+                "}",
+                index, kIntrinsics[index % std::size(kIntrinsics)], index,
+                1 + index % 7, index, index % 10);
+        corpus.emplace_back(src.c_str(), src.size());
+    }
+    return corpus;
+}
+
+class SkSLBatchCompileBench : public Benchmark {
+public:
+    SkSLBatchCompileBench(bool threaded) : fThreaded(threaded) {}
+
+    const char* onGetName() override {
+        return fThreaded ? "sksl_compile_1000_runtime_effects_threaded"
+                         : "sksl_compile_1000_runtime_effects";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fSources = make_runtime_effect_corpus(1000);
+        if (fThreaded) {
+            fExecutor = SkExecutor::MakeWorkStealingThreadPool();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const SkSL::ShaderCaps* caps = SkSL::ShaderCapsFactory::Standalone();
+        SkSL::ProgramSettings settings;
+        for (int i = 0; i < loops; i++) {
+            if (fThreaded) {
+                std::vector<std::string> errors;
+                auto programs = SkSL::Compiler::ConvertPrograms(
+                        *fExecutor, caps, SkSL::ProgramKind::kRuntimeShader,
+                        SkSpan(fSources), settings, &errors);
+                for (size_t index = 0; index < programs.size(); ++index) {
+                    if (!programs[index]) {
+                        SK_ABORT("shader compilation failed: %s\n", errors[index].c_str());
+                    }
+                }
+            } else {
+                SkSL::Compiler compiler(caps);
+                for (const std::string& source : fSources) {
+                    if (!compiler.convertProgram(SkSL::ProgramKind::kRuntimeShader, source,
+                                                 settings)) {
+                        SK_ABORT("shader compilation failed: %s\n", compiler.errorText().c_str());
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    bool fThreaded;
+    std::vector<std::string> fSources;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH(return new SkSLBatchCompileBench(/*threaded=*/false);)
+DEF_BENCH(return new SkSLBatchCompileBench(/*threaded=*/true);)
+
+// Makes runtime effects through a SkRuntimeEffect::PersistentCache which starts out empty (cold),
+// or already holds every effect (warm). Warm effects only compile their program when it is first
+// needed, so the last variant also asks each of them for it, as drawing would.
+class SkSLPersistentCacheBench : public Benchmark {
+public:
+    enum class Mode { kCold, kWarm, kWarmCompiled };
+
+    SkSLPersistentCacheBench(Mode mode) : fMode(mode) {}
+
+    const char* onGetName() override {
+        switch (fMode) {
+            case Mode::kCold:         return "sksl_runtime_effect_persistent_cache_cold";
+            case Mode::kWarm:         return "sksl_runtime_effect_persistent_cache_warm";
+            case Mode::kWarmCompiled: return "sksl_runtime_effect_persistent_cache_warm_compiled";
+        }
+        SkUNREACHABLE;
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        for (const std::string& source : make_runtime_effect_corpus(100)) {
+            fSources.emplace_back(source.c_str(), source.size());
+        }
+        if (fMode != Mode::kCold) {
+            this->makeEffects();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            if (fMode == Mode::kCold) {
+                fCache.reset();
+            }
+            this->makeEffects();
+        }
+    }
+
+private:
+    class Cache final : public SkRuntimeEffect::PersistentCache {
+    public:
+        sk_sp<SkData> load(const SkData& key) override {
+            SkAutoMutexExclusive lock(fMutex);
+            auto found = fEntries.find(AsString(key));
+            return found != fEntries.end() ? found->second : nullptr;
+        }
+
+        void store(const SkData& key, const SkData& data) override {
+            SkAutoMutexExclusive lock(fMutex);
+            fEntries[AsString(key)] = SkData::MakeWithCopy(data.data(), data.size());
+        }
+
+        void reset() {
+            SkAutoMutexExclusive lock(fMutex);
+            fEntries.clear();
+        }
+
+    private:
+        static std::string AsString(const SkData& data) {
+            return std::string(static_cast<const char*>(data.data()), data.size());
+        }
+
+        SkMutex fMutex;
+        std::map<std::string, sk_sp<SkData>> fEntries;
+    };
+
+    void makeEffects() {
+        SkRuntimeEffect::SetPersistentCache(&fCache);
+        for (const SkString& source : fSources) {
+            auto [effect, error] = SkRuntimeEffect::MakeForShader(source);
+            if (!effect) {
+                SK_ABORT("shader compilation failed: %s\n", error.c_str());
+            }
+            if (fMode == Mode::kWarmCompiled) {
+                SkRuntimeEffectPriv::Program(*effect);
+            }
+        }
+        SkRuntimeEffect::SetPersistentCache(nullptr);
+    }
+
+    Mode fMode;
+    std::vector<SkString> fSources;
+    Cache fCache;
+};
+
+DEF_BENCH(return new SkSLPersistentCacheBench(SkSLPersistentCacheBench::Mode::kCold);)
+DEF_BENCH(return new SkSLPersistentCacheBench(SkSLPersistentCacheBench::Mode::kWarm);)
+DEF_BENCH(return new SkSLPersistentCacheBench(SkSLPersistentCacheBench::Mode::kWarmCompiled);)
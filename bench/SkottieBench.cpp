@@ -0,0 +1,56 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkData.h"
+#include "modules/skottie/include/Skottie.h"
+#include "tools/Resources.h"
+
+// Seeks an animation through all of its frames (animator evaluation and scene revalidation, no
+// rendering).
+class SkottieSeekBench final : public Benchmark {
+public:
+    SkottieSeekBench(const char* name, const char* source)
+        : fName(SkStringPrintf("skottie_seek_%s", name))
+        , fSource(source)
+    {}
+
+private:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        const auto data = GetResourceAsData(fSource);
+        SkASSERT(data);
+
+        fAnimation = skottie::Animation::Make(static_cast<const char*>(data->data()),
+                                              data->size());
+        SkASSERT(fAnimation);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const auto frames = fAnimation->duration() * fAnimation->fps();
+
+        while (loops-- > 0) {
+            for (double frame = 0; frame < frames; ++frame) {
+                fAnimation->seekFrame(frame);
+            }
+        }
+    }
+
+    const SkString            fName;
+    const char*               fSource;
+    sk_sp<skottie::Animation> fAnimation;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH(return new SkottieSeekBench("masking", "skottie/skottie-masking-translucent.json"));
+DEF_BENCH(return new SkottieSeekBench("glyphs",  "skottie/skottie-text-animatedglyphs-01.json"));
@@ -144,6 +144,8 @@ static DEFINE_int(flushEvery, 10, "Flush --outResultsFile every Nth run.");
 static DEFINE_bool(gpuStats, false, "Print GPU stats after each gpu benchmark?");
 static DEFINE_bool(gpuStatsDump, false, "Dump GPU stats after each benchmark to json");
 static DEFINE_bool(dmsaaStatsDump, false, "Dump DMSAA stats after each benchmark to json");
+static DEFINE_bool(opBatchingStatsDump, false,
+                   "Dump op batching stats for one frame of each GPU benchmark to json");
 static DEFINE_bool(keepAlive, false, "Print a message every so often so that we don't time out");
 static DEFINE_bool(csv, false, "Print status in CSV format");
 static DEFINE_string(sourceType, "",
@@ -398,6 +400,26 @@ static double time(int loops, Benchmark* bench, Target* target) {
     return elapsed;
 }
 
+// Replaces the context's op batching stats with the ops from a single frame of the bench.
+static bool get_op_batching_stats(Benchmark* bench, SkCanvas* canvas) {
+    auto dContext = GrAsDirectContext(canvas->recordingContext());
+    if (!dContext) {
+        return false;
+    }
+    // Flush the timed frames first. Ops only record stats in OpsTasks created after this.
+    dContext->flushAndSubmit();
+    auto& stats = dContext->priv().opBatchingStats();
+    stats = {};
+    stats.fEnabled = true;
+    canvas->clear(SK_ColorWHITE);
+    bench->preDraw(canvas);
+    bench->draw(1, canvas);
+    bench->postDraw(canvas);
+    dContext->flushAndSubmit();
+    stats.fEnabled = false;
+    return true;
+}
+
 static double estimate_timer_overhead() {
     double overhead = 0;
     for (int i = 0; i < FLAGS_overheadLoops; i++) {
@@ -1412,6 +1434,7 @@ int main(int argc, char** argv) {
     }
 
     GrRecordingContextPriv::DMSAAStats combinedDMSAAStats;
+    GrRecordingContextPriv::OpBatchingStats combinedOpBatchingStats;
 
     SkTArray<Config> configs;
     create_configs(&configs);
@@ -1534,6 +1557,12 @@ int main(int argc, char** argv) {
                     dmsaaStats.dump();
                     combinedDMSAAStats.merge(dmsaaStats);
                 }
+                if (FLAGS_opBatchingStatsDump && get_op_batching_stats(bench.get(), canvas)) {
+                    const auto& opBatchingStats =
+                            canvas->recordingContext()->priv().opBatchingStats();
+                    opBatchingStats.dumpKeyValuePairs(&keys, &values);
+                    combinedOpBatchingStats.merge(opBatchingStats);
+                }
             }
 
             bench->perCanvasPostDraw(canvas);
@@ -1655,6 +1684,11 @@ int main(int argc, char** argv) {
         combinedDMSAAStats.dump();
     }
 
+    if (FLAGS_opBatchingStatsDump) {
+        SkDebugf("<<Total Combined Op Batching Stats>>\n");
+        combinedOpBatchingStats.dump();
+    }
+
     SkGraphics::PurgeAllCaches();
 
     log.beginBench("memory_usage", 0, 0);
@@ -1453,6 +1453,8 @@ static Result compare_bitmaps(const SkBitmap& reference, const SkBitmap& bitmap)
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 static DEFINE_bool(gpuStats, false, "Append GPU stats to the log for each GPU task?");
+static DEFINE_bool(opBatchingStats, false,
+                   "Append op batching stats, as JSON, to the log for each GPU task?");
 static DEFINE_bool(preAbandonGpuContext, false,
                    "Test abandoning the GrContext before running the test.");
 static DEFINE_bool(abandonGpuContext, false,
@@ -1561,6 +1563,7 @@ Result GPUSink::onDraw(const Src& src, SkBitmap* dst, SkWStream*, SkString* log,
         canvas = wrapCanvas(canvas);
     }
 
+    direct->priv().opBatchingStats().fEnabled = FLAGS_opBatchingStats;
     Result result = src.draw(direct, canvas);
     if (!result.isOk()) {
         return result;
@@ -1571,6 +1574,15 @@ Result GPUSink::onDraw(const Src& src, SkBitmap* dst, SkWStream*, SkString* log,
         direct->priv().dumpGpuStats(log);
         direct->priv().dumpContextStats(log);
     }
+    if (FLAGS_opBatchingStats) {
+        SkDynamicMemoryWStream stream;
+        SkJSONWriter writer(&stream, SkJSONWriter::Mode::kPretty);
+        direct->priv().opBatchingStats().dumpJSON(&writer);
+        writer.flush();
+        sk_sp<SkData> json = stream.detachAsData();
+        log->append(static_cast<const char*>(json->data()), json->size());
+        log->append("\n");
+    }
 
     this->readBack(surface.get(), dst);
 
@@ -30,6 +30,7 @@
 
 class SkAndroidCodec;
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkImage;
 class SkPngChunkReader;
@@ -292,6 +293,7 @@ public:
             , fSubset(nullptr)
             , fFrameIndex(0)
             , fPriorFrame(kNoFrame)
+            , fExecutor(nullptr)
         {}
 
         ZeroInitialized            fZeroInitialized;
@@ -335,6 +337,17 @@ public:
          *  If set to kNoFrame, the codec will decode any necessary required frame(s) first.
          */
         int                        fPriorFrame;
+
+        /**
+         *  If not NULL, getPixels() may use this executor to decode concurrently. The result
+         *  is identical to a serial decode.
+         *
+         *  Baseline JPEGs with restart markers are split into bands that decode in parallel.
+         *  Non-interlaced PNGs swizzle and color transform rows on the executor while the
+         *  calling thread inflates the next ones. Other images are decoded serially. Ignored
+         *  by scanline and incremental decodes.
+         */
+        SkExecutor*                fExecutor;
     };
 
     /**
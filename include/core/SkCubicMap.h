@@ -28,6 +28,13 @@ public:
 
     float computeYFromX(float x) const;
 
+    /**
+     *  Equivalent to ys[i] = maps[i]->computeYFromX(xs[i]), for i in [0..count), but solves
+     *  several cubics at a time (SIMD).
+     */
+    static void ComputeYFromX(const SkCubicMap* const maps[], const float xs[], float ys[],
+                              int count);
+
     SkPoint computeFromT(float t) const;
 
 private:
@@ -22,6 +22,13 @@ public:
     static std::unique_ptr<SkExecutor> MakeLIFOThreadPool(int threads = 0,
                                                           bool allowBorrowing = true);
 
+    // Create a thread pool SkExecutor where each thread has its own queue of work. There are no
+    // explicit affinity hints: work added from one of the pool's threads goes on that thread's
+    // queue and is run from there newest-first; idle threads steal the oldest work from a random
+    // other queue.
+    static std::unique_ptr<SkExecutor> MakeWorkStealingThreadPool(int threads = 0,
+                                                                  bool allowBorrowing = true);
+
     // There is always a default SkExecutor available by calling SkExecutor::GetDefault().
     static SkExecutor& GetDefault();
     static void SetDefault(SkExecutor*);  // Does not take ownership.  Not thread safe.
@@ -163,6 +163,29 @@ public:
      *  Call early in main() to allow Skia to use a JIT to accelerate CPU-bound operations.
      */
     static void AllowJIT();
+
+    /**
+     *  Raster drawing builds and optimizes a program for each combination of shader, clip,
+     *  blender and destination format it sees. With this enabled, each program built is also
+     *  kept in a form that SaveRasterPrograms() can return, so that a later process can pass it
+     *  to LoadRasterPrograms() and skip building and optimizing those programs again.
+     *
+     *  This is off by default. Disabling it drops any programs saved or loaded so far.
+     */
+    static void SetRasterProgramCacheEnabled(bool);
+
+    /**
+     *  Returns every raster program kept since SetRasterProgramCacheEnabled(true), including
+     *  those loaded by LoadRasterPrograms(), or nullptr if there are none.
+     */
+    static sk_sp<SkData> SaveRasterPrograms();
+
+    /**
+     *  Loads data returned by SaveRasterPrograms(), enabling the raster program cache.
+     *  Returns false, loading nothing, if the data is malformed. Programs saved by a different
+     *  build of Skia or on a CPU with different features load, but are never used.
+     */
+    static bool LoadRasterPrograms(const SkData&);
 };
 
 class SkAutoGraphics {
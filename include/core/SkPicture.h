@@ -82,6 +82,25 @@ public:
     static sk_sp<SkPicture> MakeFromData(const void* data, size_t size,
                                          const SkDeserialProcs* procs = nullptr);
 
+    /** Recreates SkPicture that was serialized into data, without copying its drawing
+        commands. Unlike MakeFromData(), the returned SkPicture keeps a reference to data
+        and plays back directly from it, as do the encoded images it draws. This is meant
+        for large pictures loaded with SkData::MakeFromFileName() or SkData::MakeFromFD():
+        the file is mapped rather than read, so loading is cheaper and only the parts of the
+        picture that are drawn need to be resident.
+
+        Paths, paints, text and vertices are still copied when the picture is created.
+        Pictures serialized by older versions of Skia may have their drawing commands copied
+        as well. Invalid drawing commands are found when the picture is drawn rather than
+        when it is created; playback stops at the first one.
+
+        @param data   container for serial data
+        @param procs  custom serial data decoders; may be nullptr
+        @return       SkPicture constructed from data
+    */
+    static sk_sp<SkPicture> MakeFromMappedData(sk_sp<SkData> data,
+                                               const SkDeserialProcs* procs = nullptr);
+
     /** \class SkPicture::AbortCallback
         AbortCallback is an abstract class. An implementation of AbortCallback may
         passed as a parameter to SkPicture::playback, to stop it before all drawing
@@ -239,12 +258,14 @@ private:
     SkPicture();
     friend class SkBigPicture;
     friend class SkEmptyPicture;
+    friend class SkMappedPicture;
     friend class SkPicturePriv;
 
     void serialize(SkWStream*, const SkSerialProcs*, class SkRefCntSet* typefaces,
         bool textBlobsOnly=false) const;
     static sk_sp<SkPicture> MakeFromStream(SkStream*, const SkDeserialProcs*,
-                                           class SkTypefacePlayback*);
+                                           class SkTypefacePlayback*,
+                                           const SkData* mapping = nullptr);
     friend class SkPictureData;
 
     /** Return true if the SkStream/Buffer represents a serialized picture, and
@@ -28,6 +28,7 @@
 class SkCanvas;
 class SkCapabilities;
 class SkDeferredDisplayList;
+class SkExecutor;
 class SkPaint;
 class SkSurfaceCharacterization;
 class GrBackendRenderTarget;
@@ -161,6 +162,24 @@ public:
         return MakeRaster(imageInfo, 0, props);
     }
 
+    /** Allocates raster SkSurface whose SkCanvas splits large draws into bands and rasterizes
+        them concurrently on executor. Pixels produced are identical to those of a surface
+        returned by MakeRaster(); only the wall-clock time to produce them differs.
+        Text and small draws are still rasterized on the calling thread.
+
+        Each draw call returns only after all of its bands are complete, so the pixels may be
+        read at any time from the calling thread. executor must outlive the returned SkSurface.
+
+        @param imageInfo     width, height, SkColorType, SkAlphaType, SkColorSpace,
+                             of raster surface; width and height must be greater than zero
+        @param executor      runs band tasks; if nullptr, behaves like MakeRaster()
+        @param surfaceProps  LCD striping orientation and setting for device independent fonts;
+                             may be nullptr
+        @return              SkSurface if all parameters are valid; otherwise, nullptr
+    */
+    static sk_sp<SkSurface> MakeRasterThreaded(const SkImageInfo& imageInfo, SkExecutor* executor,
+                                               const SkSurfaceProps* surfaceProps = nullptr);
+
     /** Allocates raster SkSurface. SkCanvas returned by SkSurface draws directly into pixels.
         Allocates and zeroes pixel memory. Pixel memory size is height times width times
         four. Pixel memory is deleted when SkSurface is deleted.
@@ -134,7 +134,9 @@ struct Metadata {
     /** Executor to handle threaded work within PDF Backend. If this is nullptr,
         then all work will be done serially on the main thread. To have worker
         threads assist with various tasks, set this to a valid SkExecutor
-        instance. Currently used for executing Deflate algorithm in parallel.
+        instance. Currently used for executing Deflate algorithm, encoding
+        images, and subsetting fonts in parallel. Pages wait for queued work
+        when it holds too much uncompressed content, bounding memory use.
 
         If set, the PDF output will be non-reproducible in the order and
         internal numbering of objects, but should render the same.
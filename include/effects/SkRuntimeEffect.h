@@ -145,6 +145,31 @@ public:
         SkString errorText;
     };
 
+    /**
+     * Optional store for the compiled form of runtime effects, persisted by the client between
+     * sessions. When set, MakeForColorFilter/MakeForShader/MakeForBlender look up an effect by its
+     * source, kind and options. An effect found in the cache is made from its stored uniforms,
+     * children and flags without compiling anything; its SkSL is only compiled the first time the
+     * effect is drawn. The cache must be thread-safe.
+     */
+    class SK_API PersistentCache {
+    public:
+        virtual ~PersistentCache() = default;
+
+        // Returns the data for the key if it exists in the cache, otherwise returns null.
+        virtual sk_sp<SkData> load(const SkData& key) = 0;
+
+        virtual void store(const SkData& key, const SkData& data) = 0;
+
+    protected:
+        PersistentCache() = default;
+        PersistentCache(const PersistentCache&) = delete;
+        PersistentCache& operator=(const PersistentCache&) = delete;
+    };
+
+    // The cache is not owned, and must outlive any effect creation. Pass nullptr to disable it.
+    static void SetPersistentCache(PersistentCache*);
+
     // MakeForColorFilter and MakeForShader verify that the SkSL code is valid for those stages of
     // the Skia pipeline. In all of the signatures described below, color parameters and return
     // values are flexible. They are listed as being 'vec4', but they can also be 'half4' or
@@ -286,6 +311,27 @@ private:
                     std::vector<SkSL::SampleUsage>&& sampleUsages,
                     uint32_t flags);
 
+    // Data for an effect made from a persistent cache entry; see compileCachedProgram().
+    struct CachedProgram;
+
+    SkRuntimeEffect(std::unique_ptr<CachedProgram> cached,
+                    const Options& options,
+                    std::vector<Uniform>&& uniforms,
+                    std::vector<Child>&& children,
+                    std::vector<SkSL::SampleUsage>&& sampleUsages,
+                    uint32_t flags);
+
+    static sk_sp<SkRuntimeEffect> MakeFromCacheEntry(const SkData& entry,
+                                                     SkString sksl,
+                                                     const Options& options,
+                                                     SkSL::ProgramKind kind);
+
+    // Effects made from a persistent cache entry compile their program on first use, so these
+    // (and not fBaseProgram or fMain directly) must be used by anything that draws the effect.
+    const SkSL::Program& program() const;
+    const SkSL::FunctionDefinition& main() const;
+    void compileCachedProgram() const;
+
     sk_sp<SkRuntimeEffect> makeUnoptimizedClone();
 
     static Result MakeFromSource(SkString sksl, const Options& options, SkSL::ProgramKind kind);
@@ -296,6 +342,8 @@ private:
 
     static SkSL::ProgramSettings MakeSettings(const Options& options);
 
+    static uint32_t ComputeHash(const std::string& source, const Options& options);
+
     uint32_t hash() const { return fHash; }
     bool usesSampleCoords()   const { return (fFlags & kUsesSampleCoords_Flag);   }
     bool samplesOutsideMain() const { return (fFlags & kSamplesOutsideMain_Flag); }
@@ -305,11 +353,11 @@ private:
     const SkFilterColorProgram* getFilterColorProgram() const;
 
 #if SK_SUPPORT_GPU
-    friend class GrSkSLFP;             // fBaseProgram, fSampleUsages
+    friend class GrSkSLFP;             // program(), fSampleUsages
     friend class GrGLSLSkSLFP;         //
 #endif
 
-    friend class SkRTShader;            // fBaseProgram, fMain
+    friend class SkRTShader;            // program(), main()
     friend class SkRuntimeBlender;      //
     friend class SkRuntimeColorFilter;  //
 
@@ -318,13 +366,18 @@ private:
 
     uint32_t fHash;
 
-    std::unique_ptr<SkSL::Program> fBaseProgram;
-    const SkSL::FunctionDefinition& fMain;
+    // Only set for effects made from a persistent cache entry. Their fBaseProgram, fMain and
+    // fFilterColorProgram are filled in by compileCachedProgram(), under fCompileOnce.
+    std::unique_ptr<CachedProgram> fCached;
+    mutable SkOnce fCompileOnce;
+
+    mutable std::unique_ptr<SkSL::Program> fBaseProgram;
+    mutable const SkSL::FunctionDefinition* fMain;
     std::vector<Uniform> fUniforms;
     std::vector<Child> fChildren;
     std::vector<SkSL::SampleUsage> fSampleUsages;
 
-    std::unique_ptr<SkFilterColorProgram> fFilterColorProgram;
+    mutable std::unique_ptr<SkFilterColorProgram> fFilterColorProgram;
 
     uint32_t fFlags;  // Flags
 };
@@ -41,6 +41,52 @@ class TextBlobRedrawCoordinator;
 class SkString;
 #endif
 
+#if GR_GPU_STATS && GR_TEST_UTILS
+// Records how OpsTask merges and chains ops, and why ops fail to combine, keyed by op name.
+// Nothing is recorded unless fEnabled is set before the ops are added to an OpsTask.
+struct GrOpBatchingStats {
+    // Why an op could not be merged or chained with one of the op chains it was tried against.
+    enum class Failure {
+        kDifferentOpType,         // The chain holds a different GrOp subclass.
+        kDifferentClip,           // The applied clips differ.
+        kDifferentDstRead,        // The dst texture requirements (or dst proxies) differ.
+        kOverlappingDstRead,      // Both need non-overlapping draws, but their bounds touch.
+        kDifferentProcessors,     // The processor sets (i.e. the paints) differ.
+        kDifferentAAType,         // The AA types differ and neither op could adopt the other's.
+        kDifferentStencil,        // The user stencil settings differ.
+        kDifferentPipelineFlags,  // The pipeline flags differ.
+        kOpDeclined,              // combineIfPossible() refused for an op specific reason.
+
+        kLast = kOpDeclined
+    };
+    static constexpr int kFailureCount = static_cast<int>(Failure::kLast) + 1;
+    static const char* FailureName(Failure);
+
+    struct OpTypeStats {
+        int fRecorded = 0;
+        int fCandidates = 0;            // Op chains which the op was tried against.
+        int fMerged = 0;                // Ops merged into another op.
+        int fChained = 0;               // Ops chained onto another op without merging.
+        int fFailures[kFailureCount] = {};
+        int fStoppedAtOverlap = 0;      // Searches stopped to preserve painter's order.
+        int fStoppedAtMaxDistance = 0;  // Searches stopped after the maximum lookback.
+        int fExecuted = 0;              // Ops left to execute after combining.
+    };
+
+    OpTypeStats& opType(const char* name) { return fOpTypes[name]; }
+
+    void dumpKeyValuePairs(SkTArray<SkString>* keys, SkTArray<double>* values) const;
+    void dumpJSON(SkJSONWriter*) const;
+    void dump() const;
+    void merge(const GrOpBatchingStats&);
+
+    bool fEnabled = false;
+    int fNumOpChainsExecuted = 0;
+    SkTArray<int> fOpsExecutedPerFlush;
+    std::map<std::string, OpTypeStats> fOpTypes;
+};
+#endif
+
 class GrRecordingContext : public GrImageContext {
 public:
     ~GrRecordingContext() override;
@@ -252,6 +298,9 @@ protected:
     };
 
     DMSAAStats fDMSAAStats;
+
+    using OpBatchingStats = GrOpBatchingStats;
+    OpBatchingStats fOpBatchingStats;
 #endif
 
     Stats* stats() { return &fStats; }
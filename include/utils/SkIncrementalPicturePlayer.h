@@ -0,0 +1,81 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkIncrementalPicturePlayer_DEFINED
+#define SkIncrementalPicturePlayer_DEFINED
+
+#include "include/core/SkColor.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkTypes.h"
+
+#include <vector>
+
+class SkBBoxHierarchy;
+class SkBigPicture;
+class SkCanvas;
+class SkPicture;
+class SkSurface;
+
+/**
+ *  Plays back a sequence of pictures into a persistent surface, redrawing only the parts of
+ *  the surface that changed from one picture to the next.
+ *
+ *  Pictures are drawn in the surface's device space (i.e. with an identity matrix). Ops are
+ *  culled using the picture's bounding box hierarchy, so the cost of update() scales with the
+ *  area redrawn rather than with the size of the picture. Pictures recorded without an
+ *  SkBBHFactory get one built the first time they are drawn, which pays off when the same
+ *  picture is updated more than once.
+ */
+class SK_API SkIncrementalPicturePlayer {
+public:
+    /**
+     *  Pixels not covered by the picture are cleared to clearColor.
+     */
+    explicit SkIncrementalPicturePlayer(sk_sp<SkSurface> surface,
+                                        SkColor4f clearColor = SkColors::kTransparent);
+    ~SkIncrementalPicturePlayer();
+
+    /**
+     *  Clears the surface and draws all of picture.
+     */
+    void draw(sk_sp<SkPicture> picture);
+
+    /**
+     *  Replaces the previously drawn picture with picture, redrawing only the pixels inside
+     *  dirty (in device space). The caller promises that picture and the previous picture
+     *  draw the same pixels outside of dirty.
+     *
+     *  If nothing has been drawn yet, this behaves like draw().
+     *  Returns the number of pixels redrawn.
+     */
+    int64_t update(sk_sp<SkPicture> picture, const SkRect dirty[], int count);
+
+    /**
+     *  Redraws the pixels inside dirty from the current picture, e.g. after something else
+     *  drew over them. Returns the number of pixels redrawn.
+     */
+    int64_t update(const SkRect dirty[], int count);
+
+    SkSurface* surface() const { return fSurface.get(); }
+    const SkPicture* picture() const { return fPicture.get(); }
+
+private:
+    void setPicture(sk_sp<SkPicture>);
+    void drawInto(const SkIRect& deviceRect);
+
+    sk_sp<SkSurface>             fSurface;
+    const SkColor4f              fClearColor;
+    sk_sp<SkPicture>             fPicture;
+    const SkBigPicture*          fBigPicture = nullptr;  // Owned by fPicture, when it's big.
+    sk_sp<const SkBBoxHierarchy> fBBH;
+
+    // Scratch space for coalescing damage, reused across updates.
+    std::vector<SkIRect>         fDamage;
+};
+
+#endif
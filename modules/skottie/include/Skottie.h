@@ -35,7 +35,7 @@ class Scene;
 
 namespace skottie {
 
-namespace internal { class Animator; }
+namespace internal { class Animator; class KeyframeBatch; }
 
 using ImageAsset = skresources::ImageAsset;
 using ResourceProvider = skresources::ResourceProvider;
@@ -95,6 +95,8 @@ public:
                                          // frames are only resolved when needed, at seek() time.
             kPreferEmbeddedFonts = 0x02, // Attempt to use the embedded fonts (glyph paths,
                                          // normally used as fallback) over native Skia typefaces.
+            kAllowClone          = 0x04, // Retain the parsed JSON (and share the loaded image
+                                         // assets) so the animation can be clone()d.
         };
 
         explicit Builder(uint32_t flags = 0);
@@ -157,6 +159,9 @@ public:
 
         /**
          * Animation factories.
+         *
+         * The input can be Lottie JSON, or its pre-parsed binary encoding (as produced by
+         * tools/skottie2bin), which loads faster.
          */
         sk_sp<Animation> make(SkStream*);
         sk_sp<Animation> make(const char* data, size_t length);
@@ -264,15 +269,32 @@ public:
     const SkString& version() const { return fVersion; }
     const SkSize&      size() const { return fSize;    }
 
+    /**
+     * Returns an independent copy of this animation, which can be seeked and rendered
+     * concurrently with the original (on a different thread).
+     *
+     * The clone shares the parsed JSON and the image assets with the original, but gets its own
+     * scene graph and animators.  Property and marker observers are not notified for clones,
+     * and the resource provider, precomp interceptor and expression manager are shared -- these
+     * must be thread-safe if the clones are used from several threads.
+     *
+     * Returns nullptr unless the animation was built with Builder::kAllowClone.
+     */
+    sk_sp<Animation> clone() const;
+
 private:
     enum Flags : uint32_t {
         kRequiresTopLevelIsolation = 1 << 0, // Needs to draw into a layer due to layer blending.
     };
 
+    // Parsed JSON and resources, shared with clones.
+    struct Source;
+
     Animation(std::unique_ptr<sksg::Scene>,
               std::vector<sk_sp<internal::Animator>>&&,
               SkString ver, const SkSize& size,
-              double inPoint, double outPoint, double duration, double fps, uint32_t flags);
+              double inPoint, double outPoint, double duration, double fps, uint32_t flags,
+              std::shared_ptr<const Source>);
 
     const std::unique_ptr<sksg::Scene>           fScene;
     const std::vector<sk_sp<internal::Animator>> fAnimators;
@@ -283,6 +305,8 @@ private:
                                                  fDuration,
                                                  fFPS;
     const uint32_t                               fFlags;
+    const std::shared_ptr<const Source>          fSource;
+    const std::unique_ptr<internal::KeyframeBatch> fKeyframeBatch;
 
     using INHERITED = SkNVRefCnt<Animation>;
 };
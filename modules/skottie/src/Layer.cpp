@@ -276,6 +276,16 @@ protected:
         return changed;
     }
 
+    void onPrepareSeek(float t, KeyframeBatch* batch) override {
+        const auto active = (t >= fIn && t < fOut) || (t > fOut && t <= fIn);
+
+        const auto dispatch_count = active ? fLayerAnimators.size()
+                                           : fTransformAnimatorsCount;
+        for (size_t i = 0; i < dispatch_count; ++i) {
+            fLayerAnimators[i]->prepareSeek(t, batch);
+        }
+    }
+
 private:
     const AnimatorScope           fLayerAnimators;
     const sk_sp<sksg::RenderNode> fLayerNode;
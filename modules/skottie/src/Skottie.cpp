@@ -24,6 +24,7 @@
 #include "modules/skottie/src/SkottiePriv.h"
 #include "modules/skottie/src/SkottieValue.h"
 #include "modules/skottie/src/Transform.h"
+#include "modules/skottie/src/animator/KeyframeAnimator.h"
 #include "modules/skottie/src/text/TextAdapter.h"
 #include "modules/sksg/include/SkSGInvalidationController.h"
 #include "modules/sksg/include/SkSGOpacityEffect.h"
@@ -324,6 +325,17 @@ sk_sp<Animation> Animation::Builder::make(SkStream* stream) {
     return this->make(static_cast<const char*>(data->data()), data->size());
 }
 
+struct Animation::Source {
+    Source(const char* data, size_t data_len) : fDOM(data, data_len) {}
+
+    const skjson::DOM         fDOM;
+    sk_sp<ResourceProvider>   fResourceProvider;
+    sk_sp<SkFontMgr>          fFontMgr;
+    sk_sp<PrecompInterceptor> fPrecompInterceptor;
+    sk_sp<ExpressionManager>  fExpressionManager;
+    uint32_t                  fBuilderFlags = 0;
+};
+
 sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
@@ -331,15 +343,20 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     class NullResourceProvider final : public ResourceProvider {
         sk_sp<SkData> load(const char[], const char[]) const override { return nullptr; }
     };
-    auto resolvedProvider = fResourceProvider
+    sk_sp<ResourceProvider> resolvedProvider = fResourceProvider
             ? fResourceProvider : sk_make_sp<NullResourceProvider>();
+    if (fFlags & kAllowClone) {
+        // Clones should reuse the image assets (and their decoded frames).
+        resolvedProvider = skresources::CachingResourceProvider::Make(std::move(resolvedProvider));
+    }
 
     fStats = Stats{};
 
     fStats.fJsonSize = data_len;
     const auto t0 = std::chrono::steady_clock::now();
 
-    const skjson::DOM dom(data, data_len);
+    auto source = std::make_shared<Source>(data, data_len);
+    const auto& dom = source->fDOM;
     if (!dom.root().is<skjson::ObjectValue>()) {
         // TODO: more error info.
         if (fLogger) {
@@ -373,6 +390,14 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     }
 
     SkASSERT(resolvedProvider);
+    if (fFlags & kAllowClone) {
+        source->fResourceProvider   = resolvedProvider;
+        source->fFontMgr            = fFontMgr;
+        source->fPrecompInterceptor = fPrecompInterceptor;
+        source->fExpressionManager  = fExpressionManager;
+        source->fBuilderFlags       = fFlags;
+    }
+
     internal::AnimationBuilder builder(std::move(resolvedProvider), fFontMgr,
                                        std::move(fPropertyObserver),
                                        std::move(fLogger),
@@ -395,6 +420,11 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
         flags |= Animation::Flags::kRequiresTopLevelIsolation;
     }
 
+    if (!(fFlags & kAllowClone)) {
+        // Not needed past this point.
+        source.reset();
+    }
+
     return sk_sp<Animation>(new Animation(std::move(ainfo.fScene),
                                           std::move(ainfo.fAnimators),
                                           std::move(version),
@@ -403,7 +433,8 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
                                           outPoint,
                                           duration,
                                           fps,
-                                          flags));
+                                          flags,
+                                          std::move(source)));
 }
 
 sk_sp<Animation> Animation::Builder::makeFromFile(const char path[]) {
@@ -416,7 +447,8 @@ sk_sp<Animation> Animation::Builder::makeFromFile(const char path[]) {
 Animation::Animation(std::unique_ptr<sksg::Scene> scene,
                      std::vector<sk_sp<internal::Animator>>&& animators,
                      SkString version, const SkSize& size,
-                     double inPoint, double outPoint, double duration, double fps, uint32_t flags)
+                     double inPoint, double outPoint, double duration, double fps, uint32_t flags,
+                     std::shared_ptr<const Source> source)
     : fScene(std::move(scene))
     , fAnimators(std::move(animators))
     , fVersion(std::move(version))
@@ -425,10 +457,40 @@ Animation::Animation(std::unique_ptr<sksg::Scene> scene,
     , fOutPoint(outPoint)
     , fDuration(duration)
     , fFPS(fps)
-    , fFlags(flags) {}
+    , fFlags(flags)
+    , fSource(std::move(source))
+    , fKeyframeBatch(std::make_unique<internal::KeyframeBatch>()) {}
 
 Animation::~Animation() = default;
 
+sk_sp<Animation> Animation::clone() const {
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    if (!fSource) {
+        return nullptr;
+    }
+
+    // The JSON has already been validated, and any errors reported, when building the original.
+    Builder::Stats stats;
+    internal::AnimationBuilder builder(fSource->fResourceProvider, fSource->fFontMgr,
+                                       nullptr, nullptr, nullptr,
+                                       fSource->fPrecompInterceptor,
+                                       fSource->fExpressionManager,
+                                       &stats, fSize, fDuration, fFPS, fSource->fBuilderFlags);
+    auto ainfo = builder.parse(fSource->fDOM.root().as<skjson::ObjectValue>());
+
+    return sk_sp<Animation>(new Animation(std::move(ainfo.fScene),
+                                          std::move(ainfo.fAnimators),
+                                          fVersion,
+                                          fSize,
+                                          fInPoint,
+                                          fOutPoint,
+                                          fDuration,
+                                          fFPS,
+                                          fFlags,
+                                          fSource));
+}
+
 void Animation::render(SkCanvas* canvas, const SkRect* dstR) const {
     this->render(canvas, dstR, 0);
 }
@@ -470,6 +532,12 @@ void Animation::seekFrame(double t, sksg::InvalidationController* ic) {
     const auto kLastValidFrame = std::nextafterf(fOutPoint, fInPoint),
                      comp_time = SkTPin<float>(fInPoint + t, fInPoint, kLastValidFrame);
 
+    // Solve the keyframe easing curves for all animators in one go, then seek.
+    for (const auto& anim : fAnimators) {
+        anim->prepareSeek(comp_time, fKeyframeBatch.get());
+    }
+    fKeyframeBatch->solve();
+
     for (const auto& anim : fAnimators) {
         anim->seek(comp_time);
     }
@@ -5,6 +5,8 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkStream.h"
@@ -849,3 +851,62 @@ DEF_TEST(Skottie_Layer_NoType, r) {
     // passes if we don't crash
     REPORTER_ASSERT(r, anim);
 }
+
+DEF_TEST(Skottie_Clone, r) {
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 10,
+             "h": 10,
+             "fr": 10,
+             "ip": 0,
+             "op": 10,
+             "layers": [
+               {
+                 "ty": 1,
+                 "ind": 0,
+                 "ip": 0,
+                 "op": 10,
+                 "ks": {
+                   "o": { "a": 1, "k": [ { "t": 0, "s": [0] }, { "t": 10, "s": [100] } ] }
+                 },
+                 "sw": 10,
+                 "sh": 10,
+                 "sc": "#ffffff"
+               }
+             ]
+           })";
+
+    {
+        auto anim = Animation::Make(json, strlen(json));
+        REPORTER_ASSERT(r, anim);
+        REPORTER_ASSERT(r, !anim->clone());
+    }
+
+    auto anim = Animation::Builder(Animation::Builder::kAllowClone).make(json, strlen(json));
+    REPORTER_ASSERT(r, anim);
+    auto clone = anim->clone();
+    REPORTER_ASSERT(r, clone);
+    REPORTER_ASSERT(r, clone->size() == anim->size());
+    REPORTER_ASSERT(r, clone->duration() == anim->duration());
+
+    auto render = [](const sk_sp<Animation>& a) {
+        SkBitmap bm;
+        bm.allocN32Pixels(10, 10);
+        SkCanvas canvas(bm);
+        canvas.clear(SK_ColorTRANSPARENT);
+        a->render(&canvas);
+        return SkColorGetA(bm.getColor(5, 5));
+    };
+
+    // Seeking one does not affect the other.
+    anim->seekFrame(0);
+    clone->seekFrame(9);
+    const auto anim_alpha  = render(anim),
+               clone_alpha = render(clone);
+    REPORTER_ASSERT(r, anim_alpha == 0);
+    REPORTER_ASSERT(r, clone_alpha > 0);
+
+    anim->seekFrame(9);
+    REPORTER_ASSERT(r, render(anim) == clone_alpha);
+}
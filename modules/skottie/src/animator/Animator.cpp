@@ -29,6 +29,12 @@ Animator::StateChanged AnimatablePropertyContainer::onSeek(float t) {
     return changed;
 }
 
+void AnimatablePropertyContainer::onPrepareSeek(float t, KeyframeBatch* batch) {
+    for (const auto& animator : fAnimators) {
+        animator->prepareSeek(t, batch);
+    }
+}
+
 void AnimatablePropertyContainer::attachDiscardableAdapter(
         sk_sp<AnimatablePropertyContainer> child) {
     if (!child) {
@@ -25,17 +25,25 @@ namespace internal {
 
 class AnimationBuilder;
 class AnimatorBuilder;
+class KeyframeBatch;
 
 class Animator : public SkRefCnt {
 public:
     using StateChanged = bool;
     StateChanged seek(float t) { return this->onSeek(t); }
 
+    // Optional first pass of seek(t): keyframe animators queue their cubic easing on |batch|, to
+    // be solved for all of them at once (KeyframeBatch::solve) before they are seeked.  Animators
+    // which are not reached by this pass just compute their easing when seeked.
+    void prepareSeek(float t, KeyframeBatch* batch) { this->onPrepareSeek(t, batch); }
+
 protected:
     Animator() = default;
 
     virtual StateChanged onSeek(float t) = 0;
 
+    virtual void onPrepareSeek(float, KeyframeBatch*) {}
+
 private:
     Animator(const Animator&) = delete;
     Animator& operator=(const Animator&) = delete;
@@ -71,6 +79,7 @@ protected:
 
 private:
     StateChanged onSeek(float) final;
+    void onPrepareSeek(float, KeyframeBatch*) final;
 
     bool bindImpl(const AnimationBuilder&, const skjson::ObjectValue*, AnimatorBuilder&);
 
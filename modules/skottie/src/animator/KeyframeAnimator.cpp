@@ -13,8 +13,45 @@
 
 namespace skottie::internal {
 
+void KeyframeBatch::solve() {
+    fYs.resize(fXs.size());
+    SkCubicMap::ComputeYFromX(fMaps.data(), fXs.data(), fYs.data(), SkToInt(fXs.size()));
+
+    for (size_t i = 0; i < fYs.size(); ++i) {
+        *fResults[i] = fYs[i];
+    }
+
+    fMaps.clear();
+    fXs.clear();
+    fYs.clear();
+    fResults.clear();
+}
+
 KeyframeAnimator::~KeyframeAnimator() = default;
 
+void KeyframeAnimator::onPrepareSeek(float t, KeyframeBatch* batch) {
+    SkASSERT(!fKFs.empty());
+
+    // Mirrors getLERPInfo(), for the cubic segment case.
+    if (t <= fKFs.front().t || t >= fKFs.back().t || t == fEasedT) {
+        return;
+    }
+
+    if (!fCurrentSegment.contains(t)) {
+        fCurrentSegment = this->find_segment(t);
+    }
+    const auto* kf0 = fCurrentSegment.kf0;
+    if (kf0->mapping < Keyframe::kCubicIndexOffset) {
+        return;
+    }
+
+    const auto mapper_index = SkToSizeT(kf0->mapping - Keyframe::kCubicIndexOffset);
+    fEasedT = t;
+    batch->add(&fCMs[mapper_index],
+               (t - kf0->t) / (fCurrentSegment.kf1->t - kf0->t),
+               &fEasedWeight);
+}
+
 KeyframeAnimator::LERPInfo KeyframeAnimator::getLERPInfo(float t) const {
     SkASSERT(!fKFs.empty());
 
@@ -76,10 +113,11 @@ float KeyframeAnimator::compute_weight(const KFSegment &seg, float t) const {
     // Linear weight.
     auto w = (t - seg.kf0->t) / (seg.kf1->t - seg.kf0->t);
 
-    // Optional cubic mapper.
+    // Optional cubic mapper (possibly solved ahead of time, see onPrepareSeek).
     if (seg.kf0->mapping >= Keyframe::kCubicIndexOffset) {
         const auto mapper_index = SkToSizeT(seg.kf0->mapping - Keyframe::kCubicIndexOffset);
-        w = fCMs[mapper_index].computeYFromX(w);
+        w = t == fEasedT ? fEasedWeight
+                         : fCMs[mapper_index].computeYFromX(w);
     }
 
     return w;
@@ -59,6 +59,26 @@ struct Keyframe {
     inline static constexpr uint32_t kCubicIndexOffset = 2;
 };
 
+// Cubic easing queued by keyframe animators during Animator::prepareSeek(), and solved for all
+// of them at once (SoA/SIMD, see SkCubicMap::ComputeYFromX).
+class KeyframeBatch final : SkNoncopyable {
+public:
+    void add(const SkCubicMap* cm, float x, float* y) {
+        fMaps.push_back(cm);
+        fXs.push_back(x);
+        fResults.push_back(y);
+    }
+
+    // Writes the queued results, and resets the batch.
+    void solve();
+
+private:
+    std::vector<const SkCubicMap*> fMaps;
+    std::vector<float>             fXs,
+                                   fYs;
+    std::vector<float*>            fResults;
+};
+
 class KeyframeAnimator : public Animator {
 public:
     ~KeyframeAnimator() override;
@@ -103,9 +123,16 @@ private:
     // Given a |t| and a containing KFSegment, compute the local interpolation weight.
     float compute_weight(const KFSegment& seg, float t) const;
 
+    // Queues the cubic easing for |t| (if any) on the batch.
+    void onPrepareSeek(float t, KeyframeBatch*) final;
+
     const std::vector<Keyframe>   fKFs; // Keyframe records, one per AE/Lottie keyframe.
     const std::vector<SkCubicMap> fCMs; // Optional cubic mappers (Bezier interpolation).
     mutable KFSegment             fCurrentSegment = { nullptr, nullptr }; // Cached segment.
+
+    // Cubic easing weight for fEasedT, as solved by a KeyframeBatch.
+    float                         fEasedT      = SK_FloatNaN,
+                                  fEasedWeight = 0;
 };
 
 class AnimatorBuilder : public SkNoncopyable {
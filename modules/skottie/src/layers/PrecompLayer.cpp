@@ -72,6 +72,17 @@ public:
         return changed;
     }
 
+    void onPrepareSeek(float t, KeyframeBatch* batch) override {
+        // Remapped time is only known after seeking the remapper.
+        if (fRemapper) {
+            return;
+        }
+
+        for (const auto& anim : fAnimators) {
+            anim->prepareSeek((t + fTimeBias) * fTimeScale, batch);
+        }
+    }
+
 private:
     const AnimatorScope       fAnimators;
     const sk_sp<TimeRemapper> fRemapper;
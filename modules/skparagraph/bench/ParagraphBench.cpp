@@ -11,7 +11,9 @@
 #include "modules/skparagraph/src/ParagraphImpl.h"
 #include "tools/Resources.h"
 
+#include <cctype>
 #include <cfloat>
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPictureRecorder.h"
 #include "modules/skparagraph/utils/TestFontCollection.h"
 
@@ -46,15 +48,127 @@ struct ParagraphBench : public Benchmark {
         SkCanvas* canvas = rec.beginRecording({0,0, 2000,3000});
         while (loops-- > 0) {
             paragraph->layout(fWidth);
-            auto impl = static_cast<ParagraphImpl*>(paragraph.get());
             paragraph->paint(canvas, 0, 0);
             paragraph->markDirty();
-            impl->resetCache();
+            fontCollection->getParagraphCache()->reset();
         }
     }
 };
 }  // namespace
 
+// Types (and deletes) a character in the middle of a word in a ~100KB paragraph, laying it out
+// again after each keystroke: either reusing the shaped text around the edit, or from scratch.
+struct ParagraphKeystrokeBench : public Benchmark {
+    ParagraphKeystrokeBench(bool incremental)
+            : fName(incremental ? "paragraph_keystroke_100k" : "paragraph_keystroke_100k_full")
+            , fIncremental(incremental) {}
+    const char* fName;
+    bool fIncremental;
+    std::unique_ptr<Paragraph> fParagraph;
+    size_t fCaret = 0;
+    bool fTyped = false;
+    const char* onGetName() override { return fName; }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    void onDelayedSetup() override {
+        auto data = GetResourceAsData("text/english.txt");
+        if (!data) {
+            return;
+        }
+        SkString text;
+        while (text.size() < 100 * 1024) {
+            text.append((const char*)data->data(), data->size());
+        }
+
+        auto fontCollection = sk_make_sp<FontCollection>();
+        fontCollection->setDefaultFontManager(SkFontMgr::RefDefault());
+        // Every keystroke makes a new text; don't let the cache remember the old ones
+        fontCollection->getParagraphCache()->turnOn(false);
+        ParagraphStyle paragraph_style;
+        paragraph_style.turnHintingOff();
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.addText(text.c_str(), text.size());
+        fParagraph = builder.Build();
+        fParagraph->layout(500);
+
+        fCaret = text.size() / 2;
+        while (!isalpha(text[fCaret - 1]) || !isalpha(text[fCaret])) {
+            ++fCaret;
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fParagraph) {
+            return;
+        }
+        while (loops-- > 0) {
+            if (fTyped) {
+                fParagraph->replaceText(fCaret, fCaret + 1, SkString());
+            } else {
+                fParagraph->replaceText(fCaret, fCaret, SkString("x"));
+            }
+            fTyped = !fTyped;
+            if (!fIncremental) {
+                fParagraph->markDirty();
+            }
+            fParagraph->layout(500);
+        }
+    }
+};
+DEF_BENCH(return new ParagraphKeystrokeBench(true);)
+DEF_BENCH(return new ParagraphKeystrokeBench(false);)
+
+// Lays out a document of many small paragraphs with Paragraph::LayoutAll, shaping them from
+// scratch each time.
+struct ParagraphBatchBench : public Benchmark {
+    ParagraphBatchBench(int threads) : fThreads(threads) {
+        fName.printf("paragraph_batch_%dthreads", threads);
+    }
+    SkString fName;
+    int fThreads;
+    sk_sp<FontCollection> fFontCollection;
+    std::vector<std::unique_ptr<Paragraph>> fParagraphs;
+    std::vector<Paragraph*> fPointers;
+    std::vector<SkScalar> fWidths;
+    std::unique_ptr<SkExecutor> fExecutor;
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    void onDelayedSetup() override {
+        auto data = GetResourceAsData("text/english.txt");
+        if (!data) {
+            return;
+        }
+        fFontCollection = sk_make_sp<FontCollection>();
+        fFontCollection->setDefaultFontManager(SkFontMgr::RefDefault());
+        ParagraphStyle paragraph_style;
+        paragraph_style.turnHintingOff();
+        for (int i = 0; i < 256; ++i) {
+            // Make every paragraph different so they aren't shaped just once
+            SkString text;
+            text.printf("%d. ", i);
+            text.append((const char*)data->data(), data->size());
+            ParagraphBuilderImpl builder(paragraph_style, fFontCollection);
+            builder.addText(text.c_str(), text.size());
+            fParagraphs.push_back(builder.Build());
+            fPointers.push_back(fParagraphs.back().get());
+            fWidths.push_back(500);
+        }
+        if (fThreads > 1) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads, false);
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            for (auto paragraph : fPointers) {
+                paragraph->markDirty();
+            }
+            fFontCollection->getParagraphCache()->reset();
+            Paragraph::LayoutAll(fPointers, fWidths, fExecutor.get());
+        }
+    }
+};
+DEF_BENCH(return new ParagraphBatchBench(1);)
+DEF_BENCH(return new ParagraphBatchBench(4);)
+DEF_BENCH(return new ParagraphBatchBench(16);)
+
 #define PARAGRAPH_BENCH(X) DEF_BENCH(return new ParagraphBench(50000, "text/" #X ".txt", "paragraph_" #X);)
 //PARAGRAPH_BENCH(arabic)
 //PARAGRAPH_BENCH(emoji)
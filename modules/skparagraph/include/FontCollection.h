@@ -2,11 +2,13 @@
 #ifndef FontCollection_DEFINED
 #define FontCollection_DEFINED
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <set>
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkRefCnt.h"
+#include "include/private/SkMutex.h"
 #include "include/private/SkTHash.h"
 #include "modules/skparagraph/include/FontArguments.h"
 #include "modules/skparagraph/include/ParagraphCache.h"
@@ -17,6 +19,8 @@ namespace textlayout {
 
 class TextStyle;
 class Paragraph;
+// Paragraphs sharing a collection can be laid out on different threads (see
+// Paragraph::LayoutAll); the font managers should be set up before that starts.
 class FontCollection : public SkRefCnt {
 public:
     FontCollection();
@@ -42,12 +46,18 @@ public:
     void enableFontFallback();
     bool fontFallbackEnabled() { return fEnableFontFallback; }
 
-    ParagraphCache* getParagraphCache() { return &fParagraphCache; }
+    ParagraphCache* getParagraphCache() { return fParagraphCache.get(); }
+    // Lets several collections share one cache (e.g. across the documents open in an editor).
+    // They should resolve font families to the same typefaces, since those are part of the
+    // cached results but not of the key. Passing nullptr gives this collection its own cache.
+    void setParagraphCache(sk_sp<ParagraphCache> paragraphCache);
 
     void clearCaches();
 
 private:
     std::vector<sk_sp<SkFontMgr>> getFontManagerOrder() const;
+    // The cached misses depend on the managers and on fEnableFontFallback
+    void resetFallbacks();
 
     sk_sp<SkTypeface> matchTypeface(const SkString& familyName, SkFontStyle fontStyle);
 
@@ -68,15 +78,36 @@ private:
         };
     };
 
-    bool fEnableFontFallback;
-    SkTHashMap<FamilyKey, std::vector<sk_sp<SkTypeface>>, FamilyKey::Hasher> fTypefaces;
+    struct FallbackKey {
+        FallbackKey(SkUnichar unicode, SkFontStyle style, const SkString& locale)
+                : fUnicode(unicode), fFontStyle(style), fLocale(locale) {}
+
+        SkUnichar fUnicode;
+        SkFontStyle fFontStyle;
+        SkString fLocale;
+
+        bool operator==(const FallbackKey& other) const;
+
+        struct Hasher {
+            size_t operator()(const FallbackKey& key) const;
+        };
+    };
+
+    // Read by the layout threads, so it can be flipped while they run
+    std::atomic<bool> fEnableFontFallback;
+    SkMutex fMutex{"FontCollection.fMutex"};
+    SkTHashMap<FamilyKey, std::vector<sk_sp<SkTypeface>>, FamilyKey::Hasher> fTypefaces
+            SK_GUARDED_BY(fMutex);
+    // Also remembers the characters no font has
+    SkTHashMap<FallbackKey, sk_sp<SkTypeface>, FallbackKey::Hasher> fFallbackTypefaces
+            SK_GUARDED_BY(fMutex);
     sk_sp<SkFontMgr> fDefaultFontManager;
     sk_sp<SkFontMgr> fAssetFontManager;
     sk_sp<SkFontMgr> fDynamicFontManager;
     sk_sp<SkFontMgr> fTestFontManager;
 
     std::vector<SkString> fDefaultFamilyNames;
-    ParagraphCache fParagraphCache;
+    sk_sp<ParagraphCache> fParagraphCache;
 };
 }  // namespace textlayout
 }  // namespace skia
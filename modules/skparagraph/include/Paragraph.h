@@ -2,12 +2,14 @@
 #ifndef Paragraph_DEFINED
 #define Paragraph_DEFINED
 
+#include "include/core/SkSpan.h"
 #include "modules/skparagraph/include/FontCollection.h"
 #include "modules/skparagraph/include/Metrics.h"
 #include "modules/skparagraph/include/ParagraphStyle.h"
 #include "modules/skparagraph/include/TextStyle.h"
 
 class SkCanvas;
+class SkExecutor;
 
 namespace skia {
 namespace textlayout {
@@ -37,6 +39,13 @@ public:
 
     virtual void layout(SkScalar width) = 0;
 
+    // Lays out paragraphs[i] at widths[i] on the executor's threads (or on this thread if it is
+    // null), returning once they are all laid out. The paragraphs must all be different, but they
+    // can share a FontCollection.
+    static void LayoutAll(SkSpan<Paragraph* const> paragraphs,
+                          SkSpan<const SkScalar> widths,
+                          SkExecutor* executor);
+
     virtual void paint(SkCanvas* canvas, SkScalar x, SkScalar y) = 0;
 
     // Returns a vector of bounding boxes that enclose all text between
@@ -69,6 +78,10 @@ public:
     // Experimental API that allows fast way to update "immutable" paragraph
     virtual void updateTextAlign(TextAlign textAlign) = 0;
     virtual void updateText(size_t from, SkString text) = 0;
+    // Replaces the UTF-8 text in [from, to) with text (which must not cut through a placeholder).
+    // Style ranges follow the text around them; the new text gets the style of the text before
+    // it. Small edits only reshape the words around them on the next layout.
+    virtual void replaceText(size_t from, size_t to, const SkString& text) = 0;
     virtual void updateFontSize(size_t from, size_t to, SkScalar fontSize) = 0;
     virtual void updateForegroundPaint(size_t from, size_t to, SkPaint paint) = 0;
     virtual void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) = 0;
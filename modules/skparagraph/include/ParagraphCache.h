@@ -2,11 +2,14 @@
 #ifndef ParagraphCache_DEFINED
 #define ParagraphCache_DEFINED
 
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
 #include "include/private/SkMutex.h"
-#include "src/core/SkLRUCache.h"
+#include "include/private/SkTHash.h"
+#include "src/core/SkTInternalLList.h"
+#include <atomic>
 #include <functional>  // std::function
-
-#define PARAGRAPH_CACHE_STATS
+#include <memory>
 
 namespace skia {
 namespace textlayout {
@@ -25,50 +28,75 @@ class ParagraphImpl;
 class ParagraphCacheKey;
 class ParagraphCacheValue;
 
-class ParagraphCache {
+// Caches the shaping results of paragraphs, keyed on their text and font-related styles.
+// It is thread-safe, and can be shared between FontCollections (see
+// FontCollection::setParagraphCache) as long as they resolve the same font families to the same
+// typefaces.
+class ParagraphCache : public SkRefCnt {
 public:
     ParagraphCache();
-    ~ParagraphCache();
+    explicit ParagraphCache(size_t byteLimit);
+    ~ParagraphCache() override;
 
     void abandon();
     void reset();
     bool updateParagraph(ParagraphImpl* paragraph);
     bool findParagraph(ParagraphImpl* paragraph);
 
+    // The least recently used paragraphs are evicted to keep the (approximate) memory used by
+    // the cache under this limit. Returns the previous limit.
+    size_t setByteLimit(size_t byteLimit);
+    size_t getByteLimit() const;
+
+    struct Stats {
+        int    fLookups = 0;    // findParagraph calls made while the cache is on
+        int    fHits = 0;
+        int    fMisses = 0;
+        int    fEvictions = 0;  // paragraphs dropped to stay under the byte limit
+        int    fCount = 0;      // paragraphs in the cache
+        size_t fBytesUsed = 0;
+    };
+    // Counters accumulate until reset().
+    Stats getStats() const;
+
     // For testing
     void setChecker(std::function<void(ParagraphImpl* impl, const char*, bool)> checker) {
         fChecker = std::move(checker);
     }
     void printStatistics();
     void turnOn(bool value) { fCacheIsOn = value; }
-    int count() { return fLRUCacheMap.count(); }
+    int count();
 
     bool isPossiblyTextEditing(ParagraphImpl* paragraph);
 
  private:
 
     struct Entry;
-    void updateFrom(const ParagraphImpl* paragraph, Entry* entry);
-    void updateTo(ParagraphImpl* paragraph, const Entry* entry);
+    void updateTo(ParagraphImpl* paragraph, const ParagraphCacheValue& value);
+    void remove(Entry* entry);
+    void purgeAsNeeded();
 
      mutable SkMutex fParagraphMutex;
      std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
 
-    static const int kMaxEntries = 128;
+    static constexpr size_t kDefaultByteLimit = 16 * 1024 * 1024;
 
     struct KeyHash {
         uint32_t operator()(const ParagraphCacheKey& key) const;
     };
+    struct EntryTraits {
+        static const ParagraphCacheKey& GetKey(const Entry* entry);
+        static uint32_t Hash(const ParagraphCacheKey& key) { return KeyHash()(key); }
+    };
 
-    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap;
-    bool fCacheIsOn;
-    ParagraphCacheValue* fLastCachedValue;
+    SkTHashTable<Entry*, ParagraphCacheKey, EntryTraits> fEntries SK_GUARDED_BY(fParagraphMutex);
+    SkTInternalLList<Entry> fLRU SK_GUARDED_BY(fParagraphMutex);
+    size_t fByteLimit SK_GUARDED_BY(fParagraphMutex);
+    std::atomic<bool> fCacheIsOn;
+    // The text of the last paragraph added, to guess whether the next one is being edited.
+    SkString fLastCachedText SK_GUARDED_BY(fParagraphMutex);
 
-#ifdef PARAGRAPH_CACHE_STATS
-    int fTotalRequests;
-    int fCacheMisses;
-    int fHashMisses; // cache hit but hash table missed
-#endif
+    Stats fStats SK_GUARDED_BY(fParagraphMutex);
 };
 
 }  // namespace textlayout
@@ -25,38 +25,58 @@ size_t FontCollection::FamilyKey::Hasher::operator()(const FontCollection::Famil
            std::hash<std::optional<FontArguments>>()(key.fFontArguments);
 }
 
+bool FontCollection::FallbackKey::operator==(const FontCollection::FallbackKey& other) const {
+    return fUnicode == other.fUnicode &&
+           fFontStyle == other.fFontStyle &&
+           fLocale == other.fLocale;
+}
+
+size_t FontCollection::FallbackKey::Hasher::operator()(const FontCollection::FallbackKey& key) const {
+    return std::hash<SkUnichar>()(key.fUnicode) ^
+           std::hash<uint32_t>()(key.fFontStyle.weight()) ^
+           std::hash<uint32_t>()(key.fFontStyle.slant()) ^
+           std::hash<std::string>()(key.fLocale.c_str());
+}
+
 FontCollection::FontCollection()
         : fEnableFontFallback(true)
-        , fDefaultFamilyNames({SkString(DEFAULT_FONT_FAMILY)}) { }
+        , fDefaultFamilyNames({SkString(DEFAULT_FONT_FAMILY)})
+        , fParagraphCache(sk_make_sp<ParagraphCache>()) { }
 
 size_t FontCollection::getFontManagersCount() const { return this->getFontManagerOrder().size(); }
 
 void FontCollection::setAssetFontManager(sk_sp<SkFontMgr> font_manager) {
     fAssetFontManager = font_manager;
+    this->resetFallbacks();
 }
 
 void FontCollection::setDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
     fDynamicFontManager = font_manager;
+    this->resetFallbacks();
 }
 
 void FontCollection::setTestFontManager(sk_sp<SkFontMgr> font_manager) {
     fTestFontManager = font_manager;
+    this->resetFallbacks();
 }
 
 void FontCollection::setDefaultFontManager(sk_sp<SkFontMgr> fontManager,
                                            const char defaultFamilyName[]) {
     fDefaultFontManager = std::move(fontManager);
     fDefaultFamilyNames.emplace_back(defaultFamilyName);
+    this->resetFallbacks();
 }
 
 void FontCollection::setDefaultFontManager(sk_sp<SkFontMgr> fontManager,
                                            const std::vector<SkString>& defaultFamilyNames) {
     fDefaultFontManager = std::move(fontManager);
     fDefaultFamilyNames = defaultFamilyNames;
+    this->resetFallbacks();
 }
 
 void FontCollection::setDefaultFontManager(sk_sp<SkFontMgr> fontManager) {
     fDefaultFontManager = fontManager;
+    this->resetFallbacks();
 }
 
 // Return the available font managers in the order they should be queried.
@@ -84,11 +104,16 @@ std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<S
 std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<SkString>& familyNames, SkFontStyle fontStyle, const std::optional<FontArguments>& fontArgs) {
     // Look inside the font collections cache first
     FamilyKey familyKey(familyNames, fontStyle, fontArgs);
-    auto found = fTypefaces.find(familyKey);
-    if (found) {
-        return *found;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        auto found = fTypefaces.find(familyKey);
+        if (found) {
+            return *found;
+        }
     }
 
+    // Don't hold the lock while asking the font managers (another thread looking for the same
+    // families will find the same typefaces)
     std::vector<sk_sp<SkTypeface>> typefaces;
     for (const SkString& familyName : familyNames) {
         sk_sp<SkTypeface> match = matchTypeface(familyName, fontStyle);
@@ -121,6 +146,7 @@ std::vector<sk_sp<SkTypeface>> FontCollection::findTypefaces(const std::vector<S
         }
     }
 
+    SkAutoMutexExclusive lock(fMutex);
     fTypefaces.set(familyKey, typefaces);
     return typefaces;
 }
@@ -144,18 +170,31 @@ sk_sp<SkTypeface> FontCollection::matchTypeface(const SkString& familyName, SkFo
 // Find ANY font in available font managers that resolves the unicode codepoint
 sk_sp<SkTypeface> FontCollection::defaultFallback(SkUnichar unicode, SkFontStyle fontStyle, const SkString& locale) {
 
+    FallbackKey fallbackKey(unicode, fontStyle, locale);
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        auto found = fFallbackTypefaces.find(fallbackKey);
+        if (found) {
+            return *found;
+        }
+    }
+
+    sk_sp<SkTypeface> typeface;
     for (const auto& manager : this->getFontManagerOrder()) {
         std::vector<const char*> bcp47;
         if (!locale.isEmpty()) {
             bcp47.push_back(locale.c_str());
         }
-        sk_sp<SkTypeface> typeface(manager->matchFamilyStyleCharacter(
+        typeface.reset(manager->matchFamilyStyleCharacter(
                 nullptr, fontStyle, bcp47.data(), bcp47.size(), unicode));
         if (typeface != nullptr) {
-            return typeface;
+            break;
         }
     }
-    return nullptr;
+
+    SkAutoMutexExclusive lock(fMutex);
+    fFallbackTypefaces.set(fallbackKey, typeface);
+    return typeface;
 }
 
 sk_sp<SkTypeface> FontCollection::defaultFallback() {
@@ -173,12 +212,31 @@ sk_sp<SkTypeface> FontCollection::defaultFallback() {
 }
 
 
-void FontCollection::disableFontFallback() { fEnableFontFallback = false; }
-void FontCollection::enableFontFallback() { fEnableFontFallback = true; }
+void FontCollection::disableFontFallback() {
+    fEnableFontFallback = false;
+    this->resetFallbacks();
+}
+void FontCollection::enableFontFallback() {
+    fEnableFontFallback = true;
+    this->resetFallbacks();
+}
+
+void FontCollection::resetFallbacks() {
+    SkAutoMutexExclusive lock(fMutex);
+    fFallbackTypefaces.reset();
+}
+
+void FontCollection::setParagraphCache(sk_sp<ParagraphCache> paragraphCache) {
+    fParagraphCache = paragraphCache ? std::move(paragraphCache) : sk_make_sp<ParagraphCache>();
+}
 
 void FontCollection::clearCaches() {
-    fParagraphCache.reset();
-    fTypefaces.reset();
+    fParagraphCache->reset();
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        fTypefaces.reset();
+        fFallbackTypefaces.reset();
+    }
     SkShaper::PurgeCaches();
 }
 
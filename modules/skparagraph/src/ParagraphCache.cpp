@@ -26,12 +26,17 @@ namespace {
 
 class ParagraphCacheKey {
 public:
-    ParagraphCacheKey(const ParagraphImpl* paragraph)
-        : fText(paragraph->fText.c_str(), paragraph->fText.size())
+    ParagraphCacheKey(ParagraphImpl* paragraph)
+        : fText(paragraph->fText)  // Shares the (immutable) string rather than copying it.
         , fPlaceholders(paragraph->fPlaceholders)
         , fTextStyles(paragraph->fTextStyles)
         , fParagraphStyle(paragraph->paragraphStyle()) {
-        fHash = computeHash();
+        // The hash walks all of the text and styles, so the paragraph keeps it until they change:
+        // a layout that misses the cache looks the paragraph up and then adds it.
+        if (!paragraph->fParagraphCacheKeyHash) {
+            paragraph->fParagraphCacheKeyHash = this->computeHash();
+        }
+        fHash = *paragraph->fParagraphCacheKeyHash;
     }
 
     ParagraphCacheKey(const ParagraphCacheKey& other) = default;
@@ -51,6 +56,11 @@ public:
 
     const SkString& text() const { return fText; }
 
+    size_t bytesUsed() const {
+        return fText.size() + fPlaceholders.size() * sizeof(Placeholder) +
+               fTextStyles.size() * sizeof(Block);
+    }
+
 private:
     static uint32_t mix(uint32_t hash, uint32_t data);
     uint32_t computeHash() const;
@@ -94,6 +104,24 @@ public:
     bool fHasLineBreaks;
     bool fHasWhitespacesInside;
     TextIndex fTrailingSpaces;
+
+    // An estimate of the memory held, for the cache's byte limit.
+    size_t bytesUsed() const {
+        size_t bytes = sizeof(*this) + fKey.bytesUsed();
+        for (auto& run : fRuns) {
+            // glyphs, positions, offsets, cluster indexes and justification shifts
+            bytes += sizeof(Run) + run.size() * (sizeof(SkGlyphID) + 3 * sizeof(SkPoint) +
+                                                 sizeof(uint32_t));
+        }
+        bytes += fClusters.size() * sizeof(Cluster);
+        bytes += fClustersIndexFromCodeUnit.size() * sizeof(size_t);
+        bytes += fCodeUnitProperties.size() * sizeof(SkUnicode::CodeUnitFlags);
+        bytes += fWords.size() * sizeof(size_t);
+        bytes += fBidiRegions.size() * sizeof(SkUnicode::BidiRegion);
+        bytes += fUTF8IndexForUTF16Index.size() * sizeof(TextIndex);
+        bytes += fUTF16IndexForUTF8Index.size() * sizeof(size_t);
+        return bytes;
+    }
 };
 
 uint32_t ParagraphCacheKey::mix(uint32_t hash, uint32_t data) {
@@ -234,39 +262,47 @@ bool ParagraphCacheKey::operator==(const ParagraphCacheKey& other) const {
 }
 
 struct ParagraphCache::Entry {
+    explicit Entry(std::shared_ptr<const ParagraphCacheValue> value)
+        : fValue(std::move(value))
+        , fBytes(fValue->bytesUsed()) {}
 
-    Entry(ParagraphCacheValue* value) : fValue(value) {}
-    std::unique_ptr<ParagraphCacheValue> fValue;
+    // Shared so that a paragraph can copy from it outside the lock, even if it gets evicted.
+    std::shared_ptr<const ParagraphCacheValue> fValue;
+    size_t fBytes;
+
+    SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
 };
 
-ParagraphCache::ParagraphCache()
+const ParagraphCacheKey& ParagraphCache::EntryTraits::GetKey(const Entry* entry) {
+    return entry->fValue->fKey;
+}
+
+ParagraphCache::ParagraphCache() : ParagraphCache(kDefaultByteLimit) { }
+
+ParagraphCache::ParagraphCache(size_t byteLimit)
     : fChecker([](ParagraphImpl* impl, const char*, bool){ })
-    , fLRUCacheMap(kMaxEntries)
+    , fByteLimit(byteLimit)
     , fCacheIsOn(true)
-    , fLastCachedValue(nullptr)
-#ifdef PARAGRAPH_CACHE_STATS
-    , fTotalRequests(0)
-    , fCacheMisses(0)
-    , fHashMisses(0)
-#endif
 { }
 
-ParagraphCache::~ParagraphCache() { }
+ParagraphCache::~ParagraphCache() {
+    this->reset();
+}
 
-void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
+void ParagraphCache::updateTo(ParagraphImpl* paragraph, const ParagraphCacheValue& value) {
 
     paragraph->fRuns.reset();
-    paragraph->fRuns = entry->fValue->fRuns;
-    paragraph->fClusters = entry->fValue->fClusters;
-    paragraph->fClustersIndexFromCodeUnit = entry->fValue->fClustersIndexFromCodeUnit;
-    paragraph->fCodeUnitProperties = entry->fValue->fCodeUnitProperties;
-    paragraph->fWords = entry->fValue->fWords;
-    paragraph->fBidiRegions = entry->fValue->fBidiRegions;
-    paragraph->fUTF8IndexForUTF16Index = entry->fValue->fUTF8IndexForUTF16Index;
-    paragraph->fUTF16IndexForUTF8Index = entry->fValue->fUTF16IndexForUTF8Index;
-    paragraph->fHasLineBreaks = entry->fValue->fHasLineBreaks;
-    paragraph->fHasWhitespacesInside = entry->fValue->fHasWhitespacesInside;
-    paragraph->fTrailingSpaces = entry->fValue->fTrailingSpaces;
+    paragraph->fRuns = value.fRuns;
+    paragraph->fClusters = value.fClusters;
+    paragraph->fClustersIndexFromCodeUnit = value.fClustersIndexFromCodeUnit;
+    paragraph->fCodeUnitProperties = value.fCodeUnitProperties;
+    paragraph->fWords = value.fWords;
+    paragraph->fBidiRegions = value.fBidiRegions;
+    paragraph->fUTF8IndexForUTF16Index = value.fUTF8IndexForUTF16Index;
+    paragraph->fUTF16IndexForUTF8Index = value.fUTF16IndexForUTF8Index;
+    paragraph->fHasLineBreaks = value.fHasLineBreaks;
+    paragraph->fHasWhitespacesInside = value.fHasWhitespacesInside;
+    paragraph->fTrailingSpaces = value.fTrailingSpaces;
     for (auto& run : paragraph->fRuns) {
         run.setOwner(paragraph);
     }
@@ -275,13 +311,28 @@ void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
     }
 }
 
+ParagraphCache::Stats ParagraphCache::getStats() const {
+    SkAutoMutexExclusive lock(fParagraphMutex);
+    Stats stats = fStats;
+    stats.fCount = fEntries.count();
+    return stats;
+}
+
+int ParagraphCache::count() {
+    SkAutoMutexExclusive lock(fParagraphMutex);
+    return fEntries.count();
+}
+
 void ParagraphCache::printStatistics() {
+    Stats stats = this->getStats();
     SkDebugf("--- Paragraph Cache ---\n");
-    SkDebugf("Total requests: %d\n", fTotalRequests);
-    SkDebugf("Cache misses: %d\n", fCacheMisses);
-    SkDebugf("Cache miss %%: %f\n", (fTotalRequests > 0) ? 100.f * fCacheMisses / fTotalRequests : 0.f);
-    int cacheHits = fTotalRequests - fCacheMisses;
-    SkDebugf("Hash miss %%: %f\n", (cacheHits > 0) ? 100.f * fHashMisses / cacheHits : 0.f);
+    SkDebugf("Lookups: %d\n", stats.fLookups);
+    SkDebugf("Cache misses: %d\n", stats.fMisses);
+    SkDebugf("Cache miss %%: %f\n",
+             (stats.fLookups > 0) ? 100.f * stats.fMisses / stats.fLookups : 0.f);
+    SkDebugf("Evictions: %d\n", stats.fEvictions);
+    SkDebugf("Paragraphs: %d (%zu of %zu bytes)\n",
+             stats.fCount, stats.fBytesUsed, this->getByteLimit());
     SkDebugf("---------------------\n");
 }
 
@@ -291,35 +342,68 @@ void ParagraphCache::abandon() {
 
 void ParagraphCache::reset() {
     SkAutoMutexExclusive lock(fParagraphMutex);
-#ifdef PARAGRAPH_CACHE_STATS
-    fTotalRequests = 0;
-    fCacheMisses = 0;
-    fHashMisses = 0;
-#endif
-    fLRUCacheMap.reset();
-    fLastCachedValue = nullptr;
+    fStats = Stats();
+    fEntries.reset();
+    while (Entry* entry = fLRU.head()) {
+        fLRU.remove(entry);
+        delete entry;
+    }
+    fLastCachedText.reset();
+}
+
+size_t ParagraphCache::setByteLimit(size_t byteLimit) {
+    SkAutoMutexExclusive lock(fParagraphMutex);
+    size_t prevLimit = fByteLimit;
+    fByteLimit = byteLimit;
+    this->purgeAsNeeded();
+    return prevLimit;
+}
+
+size_t ParagraphCache::getByteLimit() const {
+    SkAutoMutexExclusive lock(fParagraphMutex);
+    return fByteLimit;
+}
+
+void ParagraphCache::remove(Entry* entry) {
+    fParagraphMutex.assertHeld();
+    fStats.fBytesUsed -= entry->fBytes;
+    fEntries.remove(entry->fValue->fKey);
+    fLRU.remove(entry);
+    delete entry;
+}
+
+void ParagraphCache::purgeAsNeeded() {
+    fParagraphMutex.assertHeld();
+    while (fStats.fBytesUsed > fByteLimit && fLRU.tail()) {
+        this->remove(fLRU.tail());
+        ++fStats.fEvictions;
+    }
 }
 
 bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
     if (!fCacheIsOn) {
         return false;
     }
-#ifdef PARAGRAPH_CACHE_STATS
-    ++fTotalRequests;
-#endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
-
-    if (!entry) {
-        // We have a cache miss
-#ifdef PARAGRAPH_CACHE_STATS
-        ++fCacheMisses;
-#endif
-        fChecker(paragraph, "missingParagraph", true);
-        return false;
+    std::shared_ptr<const ParagraphCacheValue> value;
+    {
+        SkAutoMutexExclusive lock(fParagraphMutex);
+        ++fStats.fLookups;
+        Entry** entry = fEntries.find(key);
+        if (!entry) {
+            // We have a cache miss
+            ++fStats.fMisses;
+            fChecker(paragraph, "missingParagraph", true);
+            return false;
+        }
+        ++fStats.fHits;
+        if (*entry != fLRU.head()) {
+            fLRU.remove(*entry);
+            fLRU.addToHead(*entry);
+        }
+        value = (*entry)->fValue;
     }
-    updateTo(paragraph, entry->get());
+    updateTo(paragraph, *value);
     fChecker(paragraph, "foundParagraph", true);
     return true;
 }
@@ -328,38 +412,46 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
     if (!fCacheIsOn) {
         return false;
     }
-#ifdef PARAGRAPH_CACHE_STATS
-    ++fTotalRequests;
-#endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
-
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
-    if (!entry) {
-        // isTooMuchMemoryWasted(paragraph) not needed for now
-        if (isPossiblyTextEditing(paragraph)) {
-            // Skip this paragraph
+    {
+        SkAutoMutexExclusive lock(fParagraphMutex);
+        if (fEntries.find(key)) {
+            // We do not have to update the paragraph
             return false;
         }
-        ParagraphCacheValue* value = new ParagraphCacheValue(std::move(key), paragraph);
-        fLRUCacheMap.insert(value->fKey, std::make_unique<Entry>(value));
-        fChecker(paragraph, "addedParagraph", true);
-        fLastCachedValue = value;
-        return true;
-    } else {
-        // We do not have to update the paragraph
+    }
+    // isTooMuchMemoryWasted(paragraph) not needed for now
+    if (isPossiblyTextEditing(paragraph)) {
+        // Skip this paragraph
         return false;
     }
+
+    // Copy the shaping results without holding the lock.
+    auto value = std::make_shared<const ParagraphCacheValue>(std::move(key), paragraph);
+
+    SkAutoMutexExclusive lock(fParagraphMutex);
+    if (fEntries.find(value->fKey)) {
+        // Another thread added the same paragraph meanwhile
+        return false;
+    }
+    Entry* entry = new Entry(std::move(value));
+    fEntries.set(entry);
+    fLRU.addToHead(entry);
+    fStats.fBytesUsed += entry->fBytes;
+    fLastCachedText = entry->fValue->fKey.text();
+    fChecker(paragraph, "addedParagraph", true);
+    this->purgeAsNeeded();
+    return true;
 }
 
 // Special situation: (very) long paragraph that is close to the last formatted paragraph
 #define NOCACHE_PREFIX_LENGTH 40
 bool ParagraphCache::isPossiblyTextEditing(ParagraphImpl* paragraph) {
-    if (fLastCachedValue == nullptr) {
-        return false;
+    SkString lastText;
+    {
+        SkAutoMutexExclusive lock(fParagraphMutex);
+        lastText = fLastCachedText;
     }
-
-    auto& lastText = fLastCachedValue->fKey.text();
     auto& text = paragraph->fText;
 
     if ((lastText.size() < NOCACHE_PREFIX_LENGTH) || (text.size() < NOCACHE_PREFIX_LENGTH)) {
@@ -1,6 +1,7 @@
 // Copyright 2019 Google LLC.
 
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMetrics.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPictureRecorder.h"
@@ -17,6 +18,7 @@
 #include "modules/skparagraph/src/Run.h"
 #include "modules/skparagraph/src/TextLine.h"
 #include "modules/skparagraph/src/TextWrapper.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/utils/SkUTF.h"
 #include <math.h>
 #include <algorithm>
@@ -61,6 +63,24 @@ Paragraph::Paragraph(ParagraphStyle style, sk_sp<FontCollection> fonts)
             , fExceededMaxLines(0)
 { }
 
+void Paragraph::LayoutAll(SkSpan<Paragraph* const> paragraphs,
+                          SkSpan<const SkScalar> widths,
+                          SkExecutor* executor) {
+    SkASSERT(paragraphs.size() == widths.size());
+    if (!executor || paragraphs.size() < 2) {
+        for (size_t i = 0; i < paragraphs.size(); ++i) {
+            paragraphs[i]->layout(widths[i]);
+        }
+        return;
+    }
+
+    SkTaskGroup taskGroup(*executor);
+    taskGroup.batch(SkToInt(paragraphs.size()), [&](int i) {
+        paragraphs[i]->layout(widths[i]);
+    });
+    taskGroup.wait();
+}
+
 ParagraphImpl::ParagraphImpl(const SkString& text,
                              ParagraphStyle style,
                              SkTArray<Block, true> blocks,
@@ -248,8 +268,15 @@ bool ParagraphImpl::computeCodeUnitProperties() {
         return false;
     }
 
-    // Get some information about trailing spaces / hard line breaks
+    this->scanCodeUnitProperties();
+    return true;
+}
+
+// Get some information about trailing spaces / hard line breaks
+void ParagraphImpl::scanCodeUnitProperties() {
     fTrailingSpaces = fText.size();
+    fHasLineBreaks = false;
+    fHasWhitespacesInside = false;
     TextIndex firstWhitespace = EMPTY_INDEX;
     for (auto i = 0ul; i < fCodeUnitProperties.size(); ++i) {
         auto flags = fCodeUnitProperties[i];
@@ -271,8 +298,6 @@ bool ParagraphImpl::computeCodeUnitProperties() {
     if (firstWhitespace < fTrailingSpaces) {
         fHasWhitespacesInside = true;
     }
-
-    return true;
 }
 
 static bool is_ascii_7bit_space(int c) {
@@ -494,6 +519,18 @@ bool ParagraphImpl::shapeTextIntoEndlessLine() {
         return true;
     }
 
+    if (!this->shapeText()) {
+        return false;
+    } else {
+        // Add the paragraph to the cache
+        fFontCollection->getParagraphCache()->updateParagraph(this);
+        return true;
+    }
+}
+
+// Shapes the text and builds the cluster table, bypassing the cache
+bool ParagraphImpl::shapeText() {
+
     if (!computeCodeUnitProperties()) {
         return false;
     }
@@ -506,13 +543,7 @@ bool ParagraphImpl::shapeTextIntoEndlessLine() {
 
     this->applySpacingAndBuildClusterTable();
 
-    if (!result) {
-        return false;
-    } else {
-        // Add the paragraph to the cache
-        fFontCollection->getParagraphCache()->updateParagraph(this);
-        return true;
-    }
+    return result;
 }
 
 void ParagraphImpl::breakShapedTextIntoLines(SkScalar maxWidth) {
@@ -1001,11 +1032,239 @@ SkString ParagraphImpl::getEllipsis() const {
 }
 
 void ParagraphImpl::updateText(size_t from, SkString text) {
-  fText.remove(from, from + text.size());
-  fText.insert(from, text);
-  fState = kUnknown;
-  fOldWidth = 0;
-  fOldHeight = 0;
+  this->replaceText(from, from + text.size(), text);
+}
+
+void ParagraphImpl::replaceText(size_t from, size_t to, const SkString& text) {
+    SkASSERT(from <= to && to <= fText.size());
+    if (from == to && text.isEmpty()) {
+        return;
+    }
+
+    if (fState >= kShaped && this->reshapeAroundEdit(from, to, text)) {
+        // The runs and clusters are up to date; the lines have to be broken again
+        fState = kMarked;
+    } else {
+        SkString edited(fText.c_str(), from);
+        edited.append(text);
+        edited.append(fText.c_str() + to, fText.size() - to);
+        fText = std::move(edited);
+        this->moveStyleRanges(from, to, text.size());
+        fState = kUnknown;
+    }
+    fPicture = nullptr;
+    fParagraphCacheKeyHash.reset();
+    fOldWidth = 0;
+    fOldHeight = 0;
+}
+
+// The style ranges around [from, to) move with the text when it's replaced by length bytes;
+// the ranges that started or ended inside of it collapse to the end of the new text.
+void ParagraphImpl::moveStyleRanges(size_t from, size_t to, size_t length) {
+    auto moveStart = [=](size_t start) {
+        if (start == 0 || start < from) {
+            return start;
+        }
+        return start <= to ? from + length : start - to + from + length;
+    };
+    auto moveEnd = [=](size_t end) {
+        if (end < from) {
+            return end;
+        }
+        return end <= to ? from + length : end - to + from + length;
+    };
+
+    for (auto& block : fTextStyles) {
+        block.fRange = TextRange(moveStart(block.fRange.start), moveEnd(block.fRange.end));
+    }
+    for (auto& placeholder : fPlaceholders) {
+        placeholder.fRange = TextRange(moveStart(placeholder.fRange.start),
+                                       moveEnd(placeholder.fRange.end));
+        placeholder.fTextBefore = TextRange(moveStart(placeholder.fTextBefore.start),
+                                            moveEnd(placeholder.fTextBefore.end));
+    }
+}
+
+// Replaces [from, to) with text, reshaping only the words it touches and splicing their glyphs
+// into the run that holds them. The words are shaped on their own, from the whitespace before
+// them to the whitespace after them; shaping does not join glyphs across whitespace, so the rest
+// of the run stays as it is (unless the font kerns against spaces).
+// Returns false, leaving the paragraph untouched, when the edit could change more than that:
+// with bidi text, letter or word spacing, hard line breaks, placeholders or style changes
+// nearby, or if the new words need another font.
+bool ParagraphImpl::reshapeAroundEdit(size_t from, size_t to, const SkString& text) {
+
+    if (fParagraphStyle.getTextDirection() != TextDirection::kLtr ||
+        fBidiRegions.size() != 1 || fBidiRegions.front().level != 0) {
+        return false;
+    }
+    for (auto& block : fTextStyles) {
+        if (!SkScalarNearlyZero(block.fStyle.getLetterSpacing()) ||
+            !SkScalarNearlyZero(block.fStyle.getWordSpacing())) {
+            return false;
+        }
+    }
+
+    // Find the words around the edit (with the whitespaces that follow them)
+    auto isWhitespace = [this](TextIndex index) {
+        return codeUnitHasProperty(index, SkUnicode::CodeUnitFlags::kPartOfWhiteSpaceBreak);
+    };
+    TextIndex start = from;
+    while (start > 0 && !isWhitespace(start - 1)) {
+        --start;
+    }
+    TextIndex end = to;
+    while (end < fText.size() && !isWhitespace(end)) {
+        ++end;
+    }
+    while (end < fText.size() && isWhitespace(end)) {
+        ++end;
+    }
+    for (auto i = start; i <= end; ++i) {
+        if (codeUnitHasProperty(i, SkUnicode::CodeUnitFlags::kHardLineBreakBefore)) {
+            return false;
+        }
+    }
+
+    // They have to be in one run and one style
+    auto run = std::find_if(fRuns.begin(), fRuns.end(), [start, end](const Run& run) {
+        return run.fTextRange.start <= start && end <= run.fTextRange.end;
+    });
+    if (run == fRuns.end() || run->isPlaceholder() || !run->leftToRight()) {
+        return false;
+    }
+    auto block = std::find_if(fTextStyles.begin(), fTextStyles.end(),
+                              [start, end](const Block& block) {
+        return block.fRange.width() > 0 && block.fRange.start <= start && end <= block.fRange.end;
+    });
+    if (block == fTextStyles.end()) {
+        return false;
+    }
+
+    // Find their glyphs (cluster indexes grow with the glyphs in a left-to-right run)
+    auto clusterIndexes = run->clusterIndexes();
+    auto findGlyph = [&](TextIndex index) -> GlyphIndex {
+        return std::lower_bound(clusterIndexes.begin(), clusterIndexes.end(),
+                                index - run->fClusterStart) - clusterIndexes.begin();
+    };
+    GlyphRange glyphs(findGlyph(start), findGlyph(end));
+    if (run->globalClusterIndex(glyphs.start) != start ||
+        run->globalClusterIndex(glyphs.end) != end) {
+        return false;
+    }
+    for (auto glyph = glyphs.start; glyph < glyphs.end; ++glyph) {
+        if (run->fGlyphs[glyph] == 0) {
+            // Unresolved glyphs are counted by the shaper; let it count them again
+            return false;
+        }
+    }
+
+    // The text after the edit moves; make sure the runs after it can move with it
+    SkString words(fText.c_str() + start, from - start);
+    words.append(text);
+    words.append(fText.c_str() + to, end - to);
+    if (words.isEmpty()) {
+        return false;
+    }
+    TextIndex newEnd = start + words.size();
+    for (auto next = run + 1; next != fRuns.end(); ++next) {
+        if (next->fClusterStart + newEnd < end) {
+            return false;
+        }
+    }
+
+    // Shape the new words as a paragraph of their own
+    SkTArray<Block, true> blocks;
+    blocks.emplace_back(0, words.size(), block->fStyle);
+    SkTArray<Placeholder, true> placeholders;
+    placeholders.emplace_back(words.size(), words.size(), PlaceholderStyle(), block->fStyle,
+                              BlockRange(0, 1), TextRange(0, words.size()));
+    ParagraphImpl edited(words, fParagraphStyle, std::move(blocks), std::move(placeholders),
+                         fFontCollection, fUnicode);
+    edited.fClustersIndexFromCodeUnit.push_back_n(words.size() + 1, EMPTY_INDEX);
+    if (!edited.shapeText() ||
+        edited.fUnresolvedGlyphs != 0 ||
+        edited.fHasLineBreaks ||
+        edited.fBidiRegions.size() != 1 || edited.fBidiRegions.front().level != 0 ||
+        edited.fRuns.size() != 1) {
+        return false;
+    }
+    const Run& replacement = edited.fRuns.front();
+    if (replacement.isPlaceholder() || !replacement.leftToRight() ||
+        !(replacement.fTextRange == TextRange(0, words.size())) ||
+        replacement.fFont != run->fFont) {
+        return false;
+    }
+
+    // Splice the new glyphs into the run and move the runs after it, both in the text and
+    // along the line
+    SkTArray<Run, false> runs;
+    runs.reserve_back(fRuns.size());
+    bool afterEdit = false;
+    SkScalar tailShift = 0;
+    for (auto& r : fRuns) {
+        if (&r == run) {
+            auto& spliced = runs.emplace_back(r, glyphs, replacement,
+                                              TextRange(start, end), TextRange(start, newEnd));
+            tailShift = spliced.fAdvance.fX - r.fAdvance.fX;
+            afterEdit = true;
+            continue;
+        }
+        if (!afterEdit) {
+            runs.emplace_back(r);
+            continue;
+        }
+        auto& copy = runs.emplace_back(r, tailShift);
+        copy.fTextRange = TextRange(r.fTextRange.start + newEnd - end,
+                                    r.fTextRange.end + newEnd - end);
+        copy.fClusterStart = r.fClusterStart + newEnd - end;
+    }
+
+    // Splice the new words into the text and its properties; the code units at the edges keep
+    // the line breaks they had (the shaper saw the new words without the text before them)
+    SkString newText(fText.c_str(), start);
+    newText.append(edited.fText);
+    newText.append(fText.c_str() + end, fText.size() - end);
+
+    constexpr auto kBreaks = SkUnicode::CodeUnitFlags::kSoftLineBreakBefore |
+                             SkUnicode::CodeUnitFlags::kHardLineBreakBefore;
+    SkTArray<SkUnicode::CodeUnitFlags, true> properties;
+    properties.reserve_back(newText.size() + 1);
+    properties.push_back_n(SkToInt(start), fCodeUnitProperties.data());
+    properties.push_back_n(SkToInt(words.size()), edited.fCodeUnitProperties.data());
+    properties.push_back_n(SkToInt(fCodeUnitProperties.size() - end),
+                           fCodeUnitProperties.data() + end);
+    properties[start] = (properties[start] & ~kBreaks) | (fCodeUnitProperties[start] & kBreaks);
+
+    SkTArray<ResolvedFontDescriptor> fontSwitches;
+    for (auto& fontSwitch : fFontSwitches) {
+        if (fontSwitch.fTextStart <= start) {
+            fontSwitches.push_back(fontSwitch);
+        } else if (fontSwitch.fTextStart >= end) {
+            fontSwitches.emplace_back(fontSwitch.fTextStart + newEnd - end, fontSwitch.fFont);
+        }
+    }
+
+    fText = std::move(newText);
+    fRuns = std::move(runs);
+    fCodeUnitProperties = std::move(properties);
+    fFontSwitches = std::move(fontSwitches);
+    fBidiRegions.front().end = fText.size();
+    this->moveStyleRanges(from, to, text.size());
+    this->scanCodeUnitProperties();
+
+    fClusters.reset();
+    fClustersIndexFromCodeUnit.reset();
+    fClustersIndexFromCodeUnit.push_back_n(fText.size() + 1, EMPTY_INDEX);
+    this->buildClusterTable();
+
+    fWords.clear();
+    if (!fUTF16IndexForUTF8Index.empty()) {
+        fUTF8IndexForUTF16Index.reset();
+        fUTF16IndexForUTF8Index.reset();
+        this->fillUTF16Mapping();
+    }
+    return true;
 }
 
 void ParagraphImpl::updateFontSize(size_t from, size_t to, SkScalar fontSize) {
@@ -1020,6 +1279,7 @@ void ParagraphImpl::updateFontSize(size_t from, size_t to, SkScalar fontSize) {
   }
 
   fState = kUnknown;
+  fParagraphCacheKeyHash.reset();
   fOldWidth = 0;
   fOldHeight = 0;
 }
@@ -1072,13 +1332,17 @@ TextIndex ParagraphImpl::findNextGraphemeBoundary(TextIndex utf8) {
 
 void ParagraphImpl::ensureUTF16Mapping() {
     fillUTF16MappingOnce([&] {
-        fUnicode->extractUtfConversionMapping(
-                this->text(),
-                [&](size_t index) { fUTF8IndexForUTF16Index.emplace_back(index); },
-                [&](size_t index) { fUTF16IndexForUTF8Index.emplace_back(index); });
+        this->fillUTF16Mapping();
     });
 }
 
+void ParagraphImpl::fillUTF16Mapping() {
+    fUnicode->extractUtfConversionMapping(
+            this->text(),
+            [&](size_t index) { fUTF8IndexForUTF16Index.emplace_back(index); },
+            [&](size_t index) { fUTF16IndexForUTF8Index.emplace_back(index); });
+}
+
 void ParagraphImpl::visit(const Visitor& visitor) {
     int lineNumber = 0;
     for (auto& line : fLines) {
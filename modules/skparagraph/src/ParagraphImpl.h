@@ -29,6 +29,7 @@
 #include "modules/skunicode/include/SkUnicode.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -164,7 +165,10 @@ public:
     Block& block(BlockIndex blockIndex);
     SkTArray<ResolvedFontDescriptor> resolvedFonts() const { return fFontSwitches; }
 
-    void markDirty() override { fState = kUnknown; }
+    void markDirty() override {
+        fState = kUnknown;
+        fParagraphCacheKeyHash.reset();
+    }
 
     int32_t unresolvedGlyphs() override;
 
@@ -184,6 +188,7 @@ public:
 
     void updateTextAlign(TextAlign textAlign) override;
     void updateText(size_t from, SkString text) override;
+    void replaceText(size_t from, size_t to, const SkString& text) override;
     void updateFontSize(size_t from, size_t to, SkScalar fontSize) override;
     void updateForegroundPaint(size_t from, size_t to, SkPaint paint) override;
     void updateBackgroundPaint(size_t from, size_t to, SkPaint paint) override;
@@ -217,6 +222,11 @@ private:
     friend class OneLineShaper;
 
     void computeEmptyMetrics();
+    void scanCodeUnitProperties();
+    void fillUTF16Mapping();
+    bool shapeText();
+    bool reshapeAroundEdit(size_t from, size_t to, const SkString& text);
+    void moveStyleRanges(size_t from, size_t to, size_t length);
 
     // Input
     SkTArray<StyleBlock<SkScalar>> fLetterSpaceStyles;
@@ -231,6 +241,7 @@ private:
 
     // Internal structures
     InternalState fState;
+    std::optional<uint32_t> fParagraphCacheKeyHash;  // Reset whenever the text or styles change
     SkTArray<Run, false> fRuns;         // kShaped
     SkTArray<Cluster, true> fClusters;  // kClusterized (cached: text, word spacing, letter spacing, resolved fonts)
     SkTArray<SkUnicode::CodeUnitFlags, true> fCodeUnitProperties;
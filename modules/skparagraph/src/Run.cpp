@@ -58,6 +58,102 @@ Run::Run(ParagraphImpl* owner,
     fPlaceholderIndex = std::numeric_limits<size_t>::max();
 }
 
+Run::Run(const Run& run,
+         GlyphRange glyphRange,
+         const Run& replacement,
+         TextRange oldText,
+         TextRange newText)
+    : fOwner(run.fOwner)
+    , fTextRange(run.fTextRange.start, run.fTextRange.end + newText.end - oldText.end)
+    , fClusterRange(EMPTY_CLUSTERS)
+    , fFont(run.fFont)
+    , fPlaceholderIndex(run.fPlaceholderIndex)
+    , fIndex(run.fIndex)
+    , fAdvance(run.fAdvance)
+    , fOffset(run.fOffset)
+    , fClusterStart(run.fClusterStart)
+    , fUtf8Range(run.fUtf8Range.begin(), run.fUtf8Range.size() + newText.end - oldText.end)
+    , fGlyphData(std::make_shared<GlyphData>())
+    , fGlyphs(fGlyphData->glyphs)
+    , fPositions(fGlyphData->positions)
+    , fOffsets(fGlyphData->offsets)
+    , fClusterIndexes(fGlyphData->clusterIndexes)
+    , fFontMetrics(run.fFontMetrics)
+    , fHeightMultiplier(run.fHeightMultiplier)
+    , fUseHalfLeading(run.fUseHalfLeading)
+    , fBaselineShift(run.fBaselineShift)
+    , fCorrectAscent(run.fCorrectAscent)
+    , fCorrectDescent(run.fCorrectDescent)
+    , fCorrectLeading(run.fCorrectLeading)
+    , fEllipsis(run.fEllipsis)
+    , fBidiLevel(run.fBidiLevel)
+{
+    SkASSERT(run.leftToRight() && replacement.leftToRight());
+    SkASSERT(glyphRange.start <= glyphRange.end && glyphRange.end <= run.size());
+    SkASSERT(oldText.start == newText.start);
+
+    // The replacement glyphs start where the replaced ones did, and push the rest along
+    auto count = replacement.size();
+    auto replacementShift = run.posX(glyphRange.start) - replacement.posX(0);
+    auto tailShift = replacement.posX(count) + replacementShift - run.posX(glyphRange.end);
+    fAdvance.fX += tailShift;
+
+    auto head = SkToInt(glyphRange.start);
+    auto tail = SkToInt(run.size() - glyphRange.end);
+    fGlyphs.push_back_n(head, run.fGlyphs.data());
+    fGlyphs.push_back_n(SkToInt(count), replacement.fGlyphs.data());
+    fGlyphs.push_back_n(tail, run.fGlyphs.data() + glyphRange.end);
+
+    // Positions, offsets and cluster indexes have one more entry, at the end of the run
+    fPositions.push_back_n(head, run.fPositions.data());
+    fOffsets.push_back_n(head, run.fOffsets.data());
+    fClusterIndexes.push_back_n(head, run.fClusterIndexes.data());
+    for (size_t i = 0; i < count; ++i) {
+        fPositions.push_back(replacement.fPositions[i] + SkVector::Make(replacementShift, 0));
+        fOffsets.push_back(replacement.fOffsets[i]);
+        fClusterIndexes.push_back(
+                SkToU32(replacement.globalClusterIndex(i) + newText.start - fClusterStart));
+    }
+    for (size_t i = glyphRange.end; i <= run.size(); ++i) {
+        fPositions.push_back(run.fPositions[i] + SkVector::Make(tailShift, 0));
+        fOffsets.push_back(run.fOffsets[i]);
+        fClusterIndexes.push_back(SkToU32(run.fClusterIndexes[i] + newText.end - oldText.end));
+    }
+}
+
+Run::Run(const Run& run, SkScalar shiftX)
+    : fOwner(run.fOwner)
+    , fTextRange(run.fTextRange)
+    , fClusterRange(run.fClusterRange)
+    , fFont(run.fFont)
+    , fPlaceholderIndex(run.fPlaceholderIndex)
+    , fIndex(run.fIndex)
+    , fAdvance(run.fAdvance)
+    , fOffset(run.fOffset + SkVector::Make(shiftX, 0))
+    , fClusterStart(run.fClusterStart)
+    , fUtf8Range(run.fUtf8Range)
+    , fGlyphData(std::make_shared<GlyphData>(*run.fGlyphData))
+    , fGlyphs(fGlyphData->glyphs)
+    , fPositions(fGlyphData->positions)
+    , fOffsets(fGlyphData->offsets)
+    , fClusterIndexes(fGlyphData->clusterIndexes)
+    , fJustificationShifts(run.fJustificationShifts)
+    , fFontMetrics(run.fFontMetrics)
+    , fHeightMultiplier(run.fHeightMultiplier)
+    , fUseHalfLeading(run.fUseHalfLeading)
+    , fBaselineShift(run.fBaselineShift)
+    , fCorrectAscent(run.fCorrectAscent)
+    , fCorrectDescent(run.fCorrectDescent)
+    , fCorrectLeading(run.fCorrectLeading)
+    , fEllipsis(run.fEllipsis)
+    , fBidiLevel(run.fBidiLevel)
+{
+    // The glyph data may be shared with a cached copy of the run, so it was copied above
+    for (auto& position : fPositions) {
+        position.fX += shiftX;
+    }
+}
+
 void Run::calculateMetrics() {
     fCorrectAscent = fFontMetrics.fAscent - fFontMetrics.fLeading * 0.5;
     fCorrectDescent = fFontMetrics.fDescent + fFontMetrics.fLeading * 0.5;
@@ -62,6 +62,16 @@ public:
         SkScalar baselineShift,
         size_t index,
         SkScalar shiftX);
+    // A copy of run with the glyphs in glyphRange replaced by all the glyphs of replacement,
+    // which was shaped (in the same font) from the text that replaced oldText with newText.
+    // Both runs must be left-to-right.
+    Run(const Run& run,
+        GlyphRange glyphRange,
+        const Run& replacement,
+        TextRange oldText,
+        TextRange newText);
+    // A copy of run, with glyph data of its own, moved shiftX along the line.
+    Run(const Run& run, SkScalar shiftX);
     Run(const Run&) = default;
     Run& operator=(const Run&) = delete;
     Run(Run&&) = default;
@@ -7,6 +7,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkEncodedImageFormat.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkFontStyle.h"
@@ -5342,6 +5343,269 @@ UNIX_ONLY_TEST(SkParagraph_CacheStyles, reporter) {
     test(2, false);
 }
 
+UNIX_ONLY_TEST(SkParagraph_CacheByteLimit, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection1 = sk_make_sp<ResourceFontCollection>();
+    if (!fontCollection1->fontsFound()) return;
+    sk_sp<ResourceFontCollection> fontCollection2 = sk_make_sp<ResourceFontCollection>();
+
+    // Both collections share one cache.
+    auto cache = sk_make_sp<ParagraphCache>();
+    fontCollection1->setParagraphCache(cache);
+    fontCollection2->setParagraphCache(cache);
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+
+    auto layout = [&](sk_sp<FontCollection> fontCollection, const char* text) {
+        TestParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.pushStyle(text_style);
+        builder.addText(text);
+        builder.pop();
+        auto paragraph = builder.Build();
+        paragraph->layout(TestCanvasWidth);
+    };
+
+    layout(fontCollection1, "text1");
+    layout(fontCollection2, "text1");
+    layout(fontCollection2, "text2");
+
+    ParagraphCache::Stats stats = cache->getStats();
+    REPORTER_ASSERT(reporter, stats.fLookups == 3);
+    REPORTER_ASSERT(reporter, stats.fHits == 1);
+    REPORTER_ASSERT(reporter, stats.fMisses == 2);
+    REPORTER_ASSERT(reporter, stats.fEvictions == 0);
+    REPORTER_ASSERT(reporter, stats.fCount == 2);
+    REPORTER_ASSERT(reporter, stats.fBytesUsed > 0);
+
+    // Leave room for just one of the two paragraphs; the least recently used one goes.
+    cache->setByteLimit(stats.fBytesUsed - 1);
+    stats = cache->getStats();
+    REPORTER_ASSERT(reporter, stats.fEvictions == 1);
+    REPORTER_ASSERT(reporter, stats.fCount == 1);
+    layout(fontCollection1, "text2");
+    REPORTER_ASSERT(reporter, cache->getStats().fHits == 2);
+
+    cache->reset();
+    stats = cache->getStats();
+    REPORTER_ASSERT(reporter, stats.fLookups == 0 && stats.fCount == 0 && stats.fBytesUsed == 0);
+}
+
+// Checks that a paragraph edited with replaceText() matches one shaped from scratch.
+static void check_replaced_text(skiatest::Reporter* reporter,
+                                Paragraph* paragraph,
+                                Paragraph* expected) {
+    auto impl = static_cast<ParagraphImpl*>(paragraph);
+    auto expectedImpl = static_cast<ParagraphImpl*>(expected);
+    REPORTER_ASSERT(reporter, std::equal(impl->text().begin(), impl->text().end(),
+                                         expectedImpl->text().begin(),
+                                         expectedImpl->text().end()));
+    REPORTER_ASSERT(reporter, paragraph->lineNumber() == expected->lineNumber());
+    REPORTER_ASSERT(reporter, SkScalarNearlyEqual(paragraph->getHeight(),
+                                                  expected->getHeight()));
+    REPORTER_ASSERT(reporter, SkScalarNearlyEqual(paragraph->getMaxIntrinsicWidth(),
+                                                  expected->getMaxIntrinsicWidth()));
+    REPORTER_ASSERT(reporter, SkScalarNearlyEqual(paragraph->getMinIntrinsicWidth(),
+                                                  expected->getMinIntrinsicWidth()));
+
+    REPORTER_ASSERT(reporter, impl->runs().size() == expectedImpl->runs().size());
+    auto runs = std::min(impl->runs().size(), expectedImpl->runs().size());
+    for (size_t r = 0; r < runs; ++r) {
+        auto& run = impl->runs()[r];
+        auto& expectedRun = expectedImpl->runs()[r];
+        REPORTER_ASSERT(reporter, run.textRange() == expectedRun.textRange());
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(run.offset().fX, expectedRun.offset().fX));
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(run.advance().fX,
+                                                      expectedRun.advance().fX));
+        REPORTER_ASSERT(reporter, run.size() == expectedRun.size());
+        if (run.size() != expectedRun.size()) {
+            continue;
+        }
+        for (size_t g = 0; g <= run.size(); ++g) {
+            REPORTER_ASSERT(reporter, g == run.size() ||
+                                      run.glyphs()[g] == expectedRun.glyphs()[g]);
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(run.posX(g), expectedRun.posX(g)));
+            REPORTER_ASSERT(reporter,
+                            run.globalClusterIndex(g) == expectedRun.globalClusterIndex(g));
+        }
+    }
+
+    REPORTER_ASSERT(reporter, impl->clusters().size() == expectedImpl->clusters().size());
+    auto clusters = std::min(impl->clusters().size(), expectedImpl->clusters().size());
+    for (size_t c = 0; c < clusters; ++c) {
+        auto& cluster = impl->clusters()[c];
+        auto& expectedCluster = expectedImpl->clusters()[c];
+        REPORTER_ASSERT(reporter, cluster.textRange() == expectedCluster.textRange());
+        REPORTER_ASSERT(reporter, cluster.isSoftBreak() == expectedCluster.isSoftBreak());
+        REPORTER_ASSERT(reporter,
+                        cluster.isWhitespaceBreak() == expectedCluster.isWhitespaceBreak());
+    }
+}
+
+UNIX_ONLY_TEST(SkParagraph_ReplaceText, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    if (!fontCollection->fontsFound()) return;
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setFontSize(20);
+    text_style.setColor(SK_ColorBLACK);
+
+    auto build = [&](const std::string& text) {
+        TestParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.pushStyle(text_style);
+        builder.addText(text.c_str(), text.size());
+        builder.pop();
+        auto paragraph = builder.Build();
+        paragraph->layout(TestCanvasWidth / 2);
+        return paragraph;
+    };
+
+    std::string text = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
+                       "tempor incididunt ut labore et dolore magna aliqua.";
+    auto paragraph = build(text);
+    auto impl = static_cast<ParagraphImpl*>(paragraph.get());
+
+    struct {
+        size_t from;
+        size_t to;
+        const char* text;
+    } edits[] = {
+        {   8,   8, "x"        },  // Typing in a word
+        {   8,   9, ""         },  // Deleting it
+        {  12,  17, "color"    },  // Replacing a word
+        {  11,  12, ""         },  // Joining two words
+        {  11,  11, " "        },  // Splitting them again
+        {   0,   0, "A "       },  // Adding a word at the start...
+        { 125, 125, " Ut enim" },  // ...and at the end
+    };
+    for (auto& edit : edits) {
+        text.replace(edit.from, edit.to - edit.from, edit.text);
+        paragraph->replaceText(edit.from, edit.to, SkString(edit.text));
+        // Only the words around the edit were shaped again
+        REPORTER_ASSERT(reporter, impl->state() == kMarked);
+        paragraph->layout(TestCanvasWidth / 2);
+
+        auto expected = build(text);
+        check_replaced_text(reporter, paragraph.get(), expected.get());
+    }
+}
+
+UNIX_ONLY_TEST(SkParagraph_ReplaceTextMultipleRuns, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    if (!fontCollection->fontsFound()) return;
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+
+    // Each style has a font of its own, so each is shaped into runs of its own
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+    SkScalar fontSizes[] = { 20, 30, 20 };
+
+    auto build = [&](const std::string (&texts)[3]) {
+        TestParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        for (int i = 0; i < 3; ++i) {
+            text_style.setFontSize(fontSizes[i]);
+            builder.pushStyle(text_style);
+            builder.addText(texts[i].c_str(), texts[i].size());
+            builder.pop();
+        }
+        auto paragraph = builder.Build();
+        paragraph->layout(TestCanvasWidth);
+        return paragraph;
+    };
+
+    std::string texts[3] = { "Lorem ipsum dolor sit amet, ",
+                             "consectetur adipiscing elit, ",
+                             "sed do eiusmod tempor." };
+    auto paragraph = build(texts);
+    auto impl = static_cast<ParagraphImpl*>(paragraph.get());
+    REPORTER_ASSERT(reporter, impl->runs().size() >= 3);
+
+    struct {
+        int style;
+        size_t from;  // In the style's text
+        size_t to;
+        const char* text;
+    } edits[] = {
+        { 0,  8,  8, "xyz"       },  // Longer, moving every run after it...
+        { 0,  6, 11, "a"         },  // ...and shorter
+        { 1,  0, 11, "consequat" },  // In the middle run
+        { 2,  7, 14, "tempus"    },  // In the last run
+    };
+    for (auto& edit : edits) {
+        size_t offset = 0;
+        for (int i = 0; i < edit.style; ++i) {
+            offset += texts[i].size();
+        }
+        texts[edit.style].replace(edit.from, edit.to - edit.from, edit.text);
+        paragraph->replaceText(offset + edit.from, offset + edit.to, SkString(edit.text));
+        REPORTER_ASSERT(reporter, impl->state() == kMarked);
+        paragraph->layout(TestCanvasWidth);
+
+        auto expected = build(texts);
+        check_replaced_text(reporter, paragraph.get(), expected.get());
+    }
+}
+
+UNIX_ONLY_TEST(SkParagraph_LayoutAll, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    if (!fontCollection->fontsFound()) return;
+    fontCollection->setDefaultFontManager(SkFontMgr::RefDefault());
+    fontCollection->enableFontFallback();
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+
+    auto build = [&](int i) {
+        SkString text;
+        text.printf("Paragraph #%d: Lorem ipsum dolor sit amet, consectetur adipiscing elit, "
+                    "sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. "
+                    "\u05D0\u05D1\u05D2 \U0001F600", i);
+        TestParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.pushStyle(text_style);
+        builder.addText(text.c_str(), text.size());
+        builder.pop();
+        return builder.Build();
+    };
+
+    constexpr int kCount = 64;
+    std::vector<std::unique_ptr<Paragraph>> paragraphs;
+    std::vector<Paragraph*> pointers;
+    std::vector<SkScalar> widths;
+    for (int i = 0; i < kCount; ++i) {
+        paragraphs.push_back(build(i));
+        pointers.push_back(paragraphs.back().get());
+        widths.push_back(100 + i * 10);
+    }
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    Paragraph::LayoutAll(pointers, widths, executor.get());
+
+    // The same as laying them out one by one
+    for (int i = 0; i < kCount; ++i) {
+        auto expected = build(i);
+        expected->layout(widths[i]);
+        REPORTER_ASSERT(reporter, paragraphs[i]->lineNumber() == expected->lineNumber());
+        REPORTER_ASSERT(reporter, paragraphs[i]->getHeight() == expected->getHeight());
+        REPORTER_ASSERT(reporter,
+                        paragraphs[i]->getLongestLine() == expected->getLongestLine());
+        REPORTER_ASSERT(reporter,
+                        paragraphs[i]->unresolvedGlyphs() == expected->unresolvedGlyphs());
+    }
+}
+
 UNIX_ONLY_TEST(SkParagraph_EmptyParagraphWithLineBreak, reporter) {
     sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
     if (!fontCollection->fontsFound()) return;
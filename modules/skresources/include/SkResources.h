@@ -91,11 +91,13 @@ public:
 private:
     explicit MultiFrameImageAsset(std::unique_ptr<SkAnimCodecPlayer>, bool predecode);
 
-    sk_sp<SkImage> generateFrame(float t);
+    sk_sp<SkImage> generateFrame(float t) SK_REQUIRES(fMutex);
 
-    std::unique_ptr<SkAnimCodecPlayer> fPlayer;
-    sk_sp<SkImage>                     fCachedFrame;
-    bool                               fPreDecode;
+    // The asset can be shared by animation clones seeking on different threads.
+    SkMutex                            fMutex;
+    std::unique_ptr<SkAnimCodecPlayer> fPlayer      SK_GUARDED_BY(fMutex);
+    sk_sp<SkImage>                     fCachedFrame SK_GUARDED_BY(fMutex);
+    const bool                         fPreDecode;
 
     using INHERITED = ImageAsset;
 };
@@ -121,6 +121,7 @@ MultiFrameImageAsset::MultiFrameImageAsset(std::unique_ptr<SkAnimCodecPlayer> pl
 }
 
 bool MultiFrameImageAsset::isMultiFrame() {
+    SkAutoMutexExclusive lock(fMutex);
     return fPlayer->duration() > 0;
 }
 
@@ -157,7 +158,7 @@ sk_sp<SkImage> MultiFrameImageAsset::generateFrame(float t) {
 
     if (fPreDecode && frame && frame->isLazyGenerated()) {
         // The multi-frame decoder should never return lazy images.
-        SkASSERT(!this->isMultiFrame());
+        SkASSERT(fPlayer->duration() == 0);
         frame = decode(std::move(frame));
     }
 
@@ -167,7 +168,8 @@ sk_sp<SkImage> MultiFrameImageAsset::generateFrame(float t) {
 sk_sp<SkImage> MultiFrameImageAsset::getFrame(float t) {
     // For static images we can reuse the cached frame
     // (which includes the optional pre-decode step).
-    if (!fCachedFrame || this->isMultiFrame()) {
+    SkAutoMutexExclusive lock(fMutex);
+    if (!fCachedFrame || fPlayer->duration() > 0) {
         fCachedFrame = this->generateFrame(t);
     }
 
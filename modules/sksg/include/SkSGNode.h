@@ -71,6 +71,7 @@ private:
         kDamage_Flag        = 1 << 1, // the node contributes damage during revalidation
         kObserverArray_Flag = 1 << 2, // the node has more than one inval observer
         kInTraversal_Flag   = 1 << 3, // the node is part of a traversal (cycle detection)
+        kRevalidated_Flag   = 1 << 4, // the node was revalidated since it was last cached
     };
 
     template <typename Func>
@@ -84,12 +85,12 @@ private:
     };
     SkRect                  fBounds;
     const uint32_t          fInvalTraits :  2;
-    uint32_t                fFlags       :  4; // Internal flags.
+    uint32_t                fFlags       :  5; // Internal flags.
     uint32_t                fNodeFlags   :  8; // Accessible from select subclasses.
-    // Free bits                         : 18;
+    // Free bits                         : 17;
 
     friend class NodePriv;
-    friend class RenderNode; // node flags access
+    friend class RenderNode; // node flags access, render caches
 
     using INHERITED = SkRefCnt;
 };
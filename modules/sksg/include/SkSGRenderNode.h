@@ -14,6 +14,8 @@
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkShader.h"
 
+#include <memory>
+
 class SkCanvas;
 class SkImageFilter;
 class SkPaint;
@@ -40,8 +42,22 @@ public:
     bool isVisible() const;
     void setVisible(bool);
 
+    // Opt-in caching of the rendered subtree, for mostly static content.  Caches are discarded
+    // when the node or any of its descendants is revalidated.
+    enum class CacheHint : uint8_t {
+        kNone,
+        // Record the subtree into a picture, replayed on subsequent renders.
+        kPicture,
+        // Rasterize the subtree at device resolution, and reuse the pixels as long as the canvas
+        // transform only changes by a translation.
+        kRaster,
+    };
+    CacheHint getCacheHint() const;
+    void setCacheHint(CacheHint);
+
 protected:
     explicit RenderNode(uint32_t inval_traits = 0);
+    ~RenderNode() override;
 
     virtual void onRender(SkCanvas*, const RenderContext*) const = 0;
     virtual const RenderNode* onNodeAt(const SkPoint& p)   const = 0;
@@ -121,6 +137,12 @@ protected:
 private:
     friend class ImageFilterEffect;
 
+    // Renders from (or into) the subtree cache, when enabled and applicable.
+    bool renderCached(SkCanvas*, const RenderContext*) const;
+
+    struct Cache;
+    mutable std::unique_ptr<Cache> fCache;
+
     using INHERITED = Node;
 };
 
@@ -155,6 +155,7 @@ const SkRect& Node::revalidate(InvalidationController* ic, const SkMatrix& ctm)
     }
 
     fFlags &= ~(kInvalidated_Flag | kDamage_Flag);
+    fFlags |= kRevalidated_Flag;
 
     return fBounds;
 }
@@ -8,8 +8,13 @@
 #include "modules/sksg/include/SkSGRenderNode.h"
 
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkSurface.h"
 #include "modules/sksg/src/SkSGNodePriv.h"
 
 namespace sksg {
@@ -17,13 +22,30 @@ namespace sksg {
 namespace {
 
 enum Flags : uint8_t {
-    kInvisible_Flag = 1 << 0,
+    kInvisible_Flag  = 1 << 0,
+    kCacheHint_Shift = 1,
+    kCacheHint_Mask  = 3 << kCacheHint_Shift,
 };
 
+// Larger subtrees are rendered directly: the pixels would cost more than they save.
+constexpr int kMaxRasterCacheDim = 2048;
+
 } // namespace
 
+struct RenderNode::Cache {
+    // CacheHint::kPicture
+    sk_sp<SkPicture> fPicture;
+
+    // CacheHint::kRaster
+    sk_sp<SkImage>   fImage;
+    SkMatrix         fCTM;    // the canvas transform used to rasterize fImage
+    SkIPoint         fOrigin; // the device space location of fImage, under fCTM
+};
+
 RenderNode::RenderNode(uint32_t inval_traits) : INHERITED(inval_traits) {}
 
+RenderNode::~RenderNode() = default;
+
 bool RenderNode::isVisible() const {
     return !(fNodeFlags & kInvisible_Flag);
 }
@@ -38,14 +60,115 @@ void RenderNode::setVisible(bool v) {
                    : (fNodeFlags | kInvisible_Flag);
 }
 
+RenderNode::CacheHint RenderNode::getCacheHint() const {
+    return static_cast<CacheHint>((fNodeFlags & kCacheHint_Mask) >> kCacheHint_Shift);
+}
+
+void RenderNode::setCacheHint(CacheHint hint) {
+    fNodeFlags = (fNodeFlags & ~kCacheHint_Mask)
+               | (static_cast<uint8_t>(hint) << kCacheHint_Shift);
+    fCache.reset();
+}
+
 void RenderNode::render(SkCanvas* canvas, const RenderContext* ctx) const {
     SkASSERT(!this->hasInval());
-    if (this->isVisible() && !this->bounds().isEmpty()) {
+    if (this->isVisible() && !this->bounds().isEmpty() && !this->renderCached(canvas, ctx)) {
         this->onRender(canvas, ctx);
     }
     SkASSERT(!this->hasInval());
 }
 
+// Cached pixels can only be reused when they still land on the device pixel grid.
+static bool OnlyPixelTranslated(const SkMatrix& m0, const SkMatrix& m1) {
+    return m0.getScaleX() == m1.getScaleX()
+        && m0.getSkewX()  == m1.getSkewX()
+        && m0.getSkewY()  == m1.getSkewY()
+        && m0.getScaleY() == m1.getScaleY()
+        && SkScalarIsInt(m1.getTranslateX() - m0.getTranslateX())
+        && SkScalarIsInt(m1.getTranslateY() - m0.getTranslateY());
+}
+
+bool RenderNode::renderCached(SkCanvas* canvas, const RenderContext* ctx) const {
+    const auto hint = this->getCacheHint();
+
+    // Shader overrides replace the shaders of individual draws, so they cannot be applied to
+    // cached content.
+    if (hint == CacheHint::kNone || (ctx && ctx->fShader)) {
+        return false;
+    }
+
+    if (fFlags & kRevalidated_Flag) {
+        // The flag only tracks the cache state, which is not observable.
+        const_cast<RenderNode*>(this)->fFlags &= ~kRevalidated_Flag;
+        fCache.reset();
+    }
+
+    const auto& ctm = canvas->getTotalMatrix();
+
+    if (hint == CacheHint::kPicture) {
+        if (!fCache) {
+            SkPictureRecorder recorder;
+            this->onRender(recorder.beginRecording(this->bounds()), nullptr);
+
+            fCache = std::make_unique<Cache>();
+            fCache->fPicture = recorder.finishRecordingAsPicture();
+        }
+
+        const auto local_ctx = ScopedRenderContext(canvas, ctx).setIsolation(this->bounds(), ctm,
+                                                                             true);
+        canvas->drawPicture(fCache->fPicture);
+        return true;
+    }
+
+    SkASSERT(hint == CacheHint::kRaster);
+    if (ctm.hasPerspective()) {
+        fCache.reset();
+        return false;
+    }
+
+    if (!fCache || !OnlyPixelTranslated(fCache->fCTM, ctm)) {
+        fCache.reset();
+
+        const auto dev_bounds = ctm.mapRect(this->bounds()).roundOut();
+        if (dev_bounds.isEmpty() ||
+            dev_bounds.width()  > kMaxRasterCacheDim ||
+            dev_bounds.height() > kMaxRasterCacheDim) {
+            return false;
+        }
+
+        const auto info = SkImageInfo::MakeN32Premul(dev_bounds.width(), dev_bounds.height(),
+                                                     canvas->imageInfo().refColorSpace());
+        auto surface = canvas->makeSurface(info);
+        if (!surface) {
+            surface = SkSurface::MakeRaster(info);
+        }
+        if (!surface) {
+            return false;
+        }
+
+        auto* raster_canvas = surface->getCanvas();
+        raster_canvas->translate(-dev_bounds.x(), -dev_bounds.y());
+        raster_canvas->concat(ctm);
+        this->onRender(raster_canvas, nullptr);
+
+        fCache = std::make_unique<Cache>();
+        fCache->fImage  = surface->makeImageSnapshot();
+        fCache->fCTM    = ctm;
+        fCache->fOrigin = dev_bounds.topLeft();
+    }
+
+    const auto dx = ctm.getTranslateX() - fCache->fCTM.getTranslateX(),
+               dy = ctm.getTranslateY() - fCache->fCTM.getTranslateY();
+
+    const auto local_ctx = ScopedRenderContext(canvas, ctx).setIsolation(this->bounds(), ctm,
+                                                                         true);
+    SkAutoCanvasRestore acr(canvas, true);
+    canvas->resetMatrix();
+    canvas->drawImage(fCache->fImage, fCache->fOrigin.x() + dx, fCache->fOrigin.y() + dy,
+                      SkSamplingOptions(SkFilterMode::kNearest));
+    return true;
+}
+
 const RenderNode* RenderNode::nodeAt(const SkPoint& p) const {
     return this->bounds().contains(p.x(), p.y()) ? this->onNodeAt(p) : nullptr;
 }
@@ -9,7 +9,10 @@
 
 #if !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkRect.h"
+#include "include/core/SkSurface.h"
 #include "include/private/SkTo.h"
 #include "modules/sksg/include/SkSGDraw.h"
 #include "modules/sksg/include/SkSGGroup.h"
@@ -355,4 +358,93 @@ DEF_TEST(SGInvalidation, reporter) {
     inval_group_remove(reporter);
 }
 
+namespace {
+
+class CountingNode final : public sksg::CustomRenderNode {
+public:
+    explicit CountingNode(sk_sp<sksg::RenderNode> child)
+        : INHERITED({std::move(child)}) {}
+
+    int renderCount() const { return fRenderCount; }
+
+private:
+    SkRect onRevalidate(sksg::InvalidationController* ic, const SkMatrix& ctm) override {
+        return this->children()[0]->revalidate(ic, ctm);
+    }
+
+    void onRender(SkCanvas* canvas, const RenderContext* ctx) const override {
+        fRenderCount++;
+        this->children()[0]->render(canvas, ctx);
+    }
+
+    const RenderNode* onNodeAt(const SkPoint&) const override { return nullptr; }
+
+    mutable int fRenderCount = 0;
+
+    using INHERITED = sksg::CustomRenderNode;
+};
+
+} // namespace
+
+static void cache_test(skiatest::Reporter* reporter, sksg::RenderNode::CacheHint hint) {
+    auto color = sksg::Color::Make(SK_ColorRED);
+    auto node  = sk_make_sp<CountingNode>(
+                     sksg::Draw::Make(sksg::Rect::Make(SkRect::MakeWH(10, 10)), color));
+    auto root  = sksg::Group::Make({node});
+    root->setCacheHint(hint);
+
+    auto surface = SkSurface::MakeRasterN32Premul(100, 100);
+    auto* canvas = surface->getCanvas();
+
+    auto render = [&]() {
+        root->revalidate(nullptr, SkMatrix::I());
+        root->render(canvas);
+    };
+
+    render();
+    render();
+    REPORTER_ASSERT(reporter, node->renderCount() == 1);
+
+    // Raster caches are specific to the canvas scale and pixel alignment.
+    const int raster = hint == sksg::RenderNode::CacheHint::kRaster ? 1 : 0;
+
+    // Translations reuse the cache.
+    canvas->translate(20, 10);
+    render();
+    REPORTER_ASSERT(reporter, node->renderCount() == 1);
+
+    // Fractional ones re-rasterize, and further whole pixel moves reuse that.
+    canvas->translate(0.5f, 0);
+    render();
+    REPORTER_ASSERT(reporter, node->renderCount() == 1 + raster);
+    canvas->translate(1, 0);
+    render();
+    REPORTER_ASSERT(reporter, node->renderCount() == 1 + raster);
+
+    // Content changes invalidate it.
+    color->setColor(SK_ColorGREEN);
+    render();
+    render();
+    REPORTER_ASSERT(reporter, node->renderCount() == 2 + raster);
+
+    SkBitmap bm;
+    bm.allocN32Pixels(100, 100);
+    REPORTER_ASSERT(reporter, surface->readPixels(bm, 0, 0));
+    REPORTER_ASSERT(reporter, bm.getColor(25, 15) == SK_ColorGREEN);
+
+    canvas->scale(2, 2);
+    render();
+    REPORTER_ASSERT(reporter, node->renderCount() == 2 + 2 * raster);
+
+    root->setCacheHint(sksg::RenderNode::CacheHint::kNone);
+    render();
+    render();
+    REPORTER_ASSERT(reporter, node->renderCount() == 4 + 2 * raster);
+}
+
+DEF_TEST(SGRenderCache, reporter) {
+    cache_test(reporter, sksg::RenderNode::CacheHint::kPicture);
+    cache_test(reporter, sksg::RenderNode::CacheHint::kRaster);
+}
+
 #endif // !defined(SK_BUILD_FOR_GOOGLE3)
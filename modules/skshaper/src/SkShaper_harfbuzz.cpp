@@ -322,6 +322,8 @@ HBFont create_typeface_hb_font(const SkTypeface& typeface) {
                                    axis_count);
         }
     }
+    // It's cached and used (as the parent of sub fonts) from several threads
+    hb_font_make_immutable(otFont.get());
 
     return otFont;
 }
@@ -1367,16 +1369,30 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     // An HBFont is fairly inexpensive.
     // An HBFace is actually tied to the data, not the typeface.
     // The size of 100 here is completely arbitrary and used to match libtxt.
+    // The cache is shared by all the threads shaping text, so the lock is not held while
+    // creating an HBFont; threads racing to create the same one all use the first one cached.
     HBFont hbFont;
     {
-        HBLockedFaceCache cache = get_hbFace_cache();
         SkTypefaceID dataId = font.currentFont().getTypeface()->uniqueID();
-        HBFont* typefaceFontCached = cache.find(dataId);
-        if (!typefaceFontCached) {
-            HBFont typefaceFont(create_typeface_hb_font(*font.currentFont().getTypeface()));
-            typefaceFontCached = cache.insert(dataId, std::move(typefaceFont));
+        HBFont typefaceFont;
+        bool cached = false;
+        {
+            HBLockedFaceCache cache = get_hbFace_cache();
+            if (HBFont* typefaceFontCached = cache.find(dataId)) {
+                typefaceFont.reset(hb_font_reference(typefaceFontCached->get()));
+                cached = true;
+            }
+        }
+        if (!cached) {
+            typefaceFont = create_typeface_hb_font(*font.currentFont().getTypeface());
+            HBLockedFaceCache cache = get_hbFace_cache();
+            if (HBFont* typefaceFontCached = cache.find(dataId)) {
+                typefaceFont.reset(hb_font_reference(typefaceFontCached->get()));
+            } else {
+                cache.insert(dataId, HBFont(hb_font_reference(typefaceFont.get())));
+            }
         }
-        hbFont = create_sub_hb_font(font.currentFont(), *typefaceFontCached);
+        hbFont = create_sub_hb_font(font.currentFont(), typefaceFont);
     }
     if (!hbFont) {
         return run;
@@ -223,6 +223,7 @@ SKIA_PUBLIC_HDRS = [
     "include/utils/SkCanvasStateUtils.h",
     "include/utils/SkCustomTypeface.h",
     "include/utils/SkEventTracer.h",
+    "include/utils/SkIncrementalPicturePlayer.h",
     "include/utils/SkNoDrawCanvas.h",
     "include/utils/SkNullCanvas.h",
     "include/utils/SkNWayCanvas.h",
@@ -480,6 +481,8 @@ BASE_SRCS_ALL = [
     "src/core/SkMSAN.h",
     "src/core/SkMalloc.cpp",
     "src/core/SkMallocPixelRef.cpp",
+    "src/core/SkMappedPicture.cpp",
+    "src/core/SkMappedPicture.h",
     "src/core/SkMask.cpp",
     "src/core/SkMask.h",
     "src/core/SkMaskBlurFilter.cpp",
@@ -1433,6 +1436,8 @@ BASE_SRCS_ALL = [
     "src/sksl/SkSLMemoryLayout.h",
     "src/sksl/SkSLMemoryPool.h",
     "src/sksl/SkSLModifiersPool.h",
+    "src/sksl/SkSLModuleImage.cpp",
+    "src/sksl/SkSLModuleImage.h",
     "src/sksl/SkSLModuleLoader.cpp",
     "src/sksl/SkSLModuleLoader.h",
     "src/sksl/SkSLOperator.cpp",
@@ -1649,6 +1654,7 @@ BASE_SRCS_ALL = [
     "src/utils/SkFloatToDecimal.h",
     "src/utils/SkFloatUtils.h",
     "src/utils/SkGaussianColorFilter.cpp",
+    "src/utils/SkIncrementalPicturePlayer.cpp",
     "src/utils/SkJSON.cpp",
     "src/utils/SkJSON.h",
     "src/utils/SkJSONWriter.cpp",
@@ -12,6 +12,7 @@
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
@@ -27,11 +28,14 @@
 #include "src/codec/SkJpegPriv.h"
 #include "src/codec/SkParseEncodedOrigin.h"
 #include "src/codec/SkSwizzler.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <array>
+#include <atomic>
 #include <csetjmp>
 #include <cstring>
 #include <utility>
+#include <vector>
 
 class SkSampler;
 
@@ -456,46 +460,47 @@ bool SkJpegCodec::onDimensionsSupported(const SkISize& size) {
     return true;
 }
 
-int SkJpegCodec::readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count,
-                          const Options& opts) {
+int SkJpegCodec::readRows(JpegDecoderMgr* decoderMgr, uint8_t* swizzleSrcRow,
+                          uint32_t* colorXformSrcRow, const SkImageInfo& dstInfo, void* dst,
+                          size_t rowBytes, int count, const Options& opts) {
     // Set the jump location for libjpeg-turbo errors
-    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr->errorMgr());
     if (setjmp(jmp)) {
         return 0;
     }
 
-    // When fSwizzleSrcRow is non-null, it means that we need to swizzle.  In this case,
-    // we will always decode into fSwizzlerSrcRow before swizzling into the next buffer.
+    // When swizzleSrcRow is non-null, it means that we need to swizzle.  In this case,
+    // we will always decode into swizzleSrcRow before swizzling into the next buffer.
     // We can never swizzle "in place" because the swizzler may perform sampling and/or
     // subsetting.
-    // When fColorXformSrcRow is non-null, it means that we need to color xform and that
+    // When colorXformSrcRow is non-null, it means that we need to color xform and that
     // we cannot color xform "in place" (many times we can, but not when the src and dst
     // are different sizes).
-    // In this case, we will color xform from fColorXformSrcRow into the dst.
+    // In this case, we will color xform from colorXformSrcRow into the dst.
     JSAMPLE* decodeDst = (JSAMPLE*) dst;
     uint32_t* swizzleDst = (uint32_t*) dst;
     size_t decodeDstRowBytes = rowBytes;
     size_t swizzleDstRowBytes = rowBytes;
     int dstWidth = opts.fSubset ? opts.fSubset->width() : dstInfo.width();
-    if (fSwizzleSrcRow && fColorXformSrcRow) {
-        decodeDst = (JSAMPLE*) fSwizzleSrcRow;
-        swizzleDst = fColorXformSrcRow;
+    if (swizzleSrcRow && colorXformSrcRow) {
+        decodeDst = (JSAMPLE*) swizzleSrcRow;
+        swizzleDst = colorXformSrcRow;
         decodeDstRowBytes = 0;
         swizzleDstRowBytes = 0;
         dstWidth = fSwizzler->swizzleWidth();
-    } else if (fColorXformSrcRow) {
-        decodeDst = (JSAMPLE*) fColorXformSrcRow;
-        swizzleDst = fColorXformSrcRow;
+    } else if (colorXformSrcRow) {
+        decodeDst = (JSAMPLE*) colorXformSrcRow;
+        swizzleDst = colorXformSrcRow;
         decodeDstRowBytes = 0;
         swizzleDstRowBytes = 0;
-    } else if (fSwizzleSrcRow) {
-        decodeDst = (JSAMPLE*) fSwizzleSrcRow;
+    } else if (swizzleSrcRow) {
+        decodeDst = (JSAMPLE*) swizzleSrcRow;
         decodeDstRowBytes = 0;
         dstWidth = fSwizzler->swizzleWidth();
     }
 
     for (int y = 0; y < count; y++) {
-        uint32_t lines = jpeg_read_scanlines(fDecoderMgr->dinfo(), &decodeDst, 1);
+        uint32_t lines = jpeg_read_scanlines(decoderMgr->dinfo(), &decodeDst, 1);
         if (0 == lines) {
             return y;
         }
@@ -548,6 +553,15 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
     // Get a pointer to the decompress info since we will use it quite frequently
     jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
 
+    if (needs_swizzler_to_convert_from_cmyk(dinfo->out_color_space,
+                                            this->getEncodedInfo().profile(), this->colorXform())) {
+        this->initializeSwizzler(dstInfo, options, true);
+    }
+
+    if (options.fExecutor && this->decodeInParallel(dstInfo, dst, dstRowBytes, options)) {
+        return kSuccess;
+    }
+
     // Set the jump location for libjpeg errors
     skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
     if (setjmp(jmp)) {
@@ -562,16 +576,12 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
     // If it's not, we want to know because it means our strategy is not optimal.
     SkASSERT(1 == dinfo->rec_outbuf_height);
 
-    if (needs_swizzler_to_convert_from_cmyk(dinfo->out_color_space,
-                                            this->getEncodedInfo().profile(), this->colorXform())) {
-        this->initializeSwizzler(dstInfo, options, true);
-    }
-
     if (!this->allocateStorage(dstInfo)) {
         return kInternalError;
     }
 
-    int rows = this->readRows(dstInfo, dst, dstRowBytes, dstInfo.height(), options);
+    int rows = this->readRows(fDecoderMgr.get(), fSwizzleSrcRow, fColorXformSrcRow, dstInfo, dst,
+                              dstRowBytes, dstInfo.height(), options);
     if (rows < dstInfo.height()) {
         *rowsDecoded = rows;
         return fDecoderMgr->returnFailure("Incomplete image data", kIncompleteInput);
@@ -580,6 +590,246 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
     return kSuccess;
 }
 
+namespace {
+
+// Where the pieces of the single scan of a baseline jpeg live in its encoded data.
+struct RestartLayout {
+    size_t              fHeightOffset = 0;  // Offset of the image height in the SOF segment.
+    size_t              fScanOffset = 0;    // Offset of the first byte of entropy coded data.
+    std::vector<size_t> fMarkerOffsets;     // Offset of the marker that ends each interval.
+
+    // Restart interval i is the entropy coded data in [start(i), fMarkerOffsets[i]).
+    size_t start(size_t i) const { return i ? fMarkerOffsets[i - 1] + 2 : fScanOffset; }
+};
+
+}  // namespace
+
+/*
+ * Finds the restart markers in a baseline jpeg. Returns false if the encoded data is not a
+ * complete baseline (huffman coded, sequential) jpeg with correctly numbered restart markers.
+ */
+static bool find_restart_markers(const uint8_t* data, size_t length, RestartLayout* layout) {
+    if (length < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+        return false;
+    }
+
+    // Walk the marker segments up to the start of the scan.
+    size_t pos = 2;
+    for (bool foundFrame = false; ; ) {
+        if (data[pos] != 0xFF) {
+            return false;
+        }
+        // Markers may be preceded by any number of 0xFF fill bytes.
+        while (pos < length && data[pos] == 0xFF) {
+            pos++;
+        }
+        if (pos + 3 > length) {
+            return false;
+        }
+        const uint8_t marker = data[pos];
+        const size_t segmentLength = (data[pos + 1] << 8) | data[pos + 2];
+        if (segmentLength < 2 || pos + 1 + segmentLength >= length) {
+            return false;
+        }
+
+        if (marker == 0xC0 || marker == 0xC1) {
+            // SOF0 and SOF1: the height follows the length and the sample precision.
+            layout->fHeightOffset = pos + 4;
+            foundFrame = true;
+        } else if ((marker & 0xF0) == 0xC0 && marker != 0xC4 && marker != 0xC8 &&
+                   marker != 0xCC) {
+            // Progressive, lossless, hierarchical or arithmetic coded.
+            return false;
+        } else if (marker == 0xDA) {
+            // SOS
+            if (!foundFrame) {
+                return false;
+            }
+            layout->fScanOffset = pos + 1 + segmentLength;
+            break;
+        }
+        pos += 1 + segmentLength;
+    }
+
+    // Scan the entropy coded data for markers. Data bytes of 0xFF are always followed by a
+    // stuffed 0x00, so any other byte after 0xFF is a marker.
+    pos = layout->fScanOffset;
+    while (pos < length) {
+        const uint8_t* ff = static_cast<const uint8_t*>(memchr(data + pos, 0xFF, length - pos));
+        if (!ff || ff + 1 >= data + length) {
+            return false;
+        }
+        pos = ff - data;
+        const uint8_t marker = ff[1];
+        if (marker == 0xFF) {
+            pos += 1;
+            continue;
+        }
+        if (marker == 0x00) {
+            pos += 2;
+            continue;
+        }
+        layout->fMarkerOffsets.push_back(pos);
+        if (marker < JPEG_RST0 || marker > JPEG_RST0 + 7) {
+            // The end of the scan.
+            return true;
+        }
+        if (marker != JPEG_RST0 + (layout->fMarkerOffsets.size() - 1) % 8) {
+            return false;
+        }
+        pos += 2;
+    }
+    return false;
+}
+
+/*
+ * Makes a standalone jpeg, height rows tall, from restart intervals [first, end).
+ */
+static std::vector<uint8_t> make_band(const uint8_t* data, const RestartLayout& layout,
+                                      size_t first, size_t end, int height) {
+    std::vector<uint8_t> band;
+    band.reserve(layout.fScanOffset + layout.fMarkerOffsets[end - 1] - layout.start(first) + 2);
+    band.insert(band.end(), data, data + layout.fScanOffset);
+    band[layout.fHeightOffset]     = SkToU8(height >> 8);
+    band[layout.fHeightOffset + 1] = SkToU8(height & 0xFF);
+
+    for (size_t i = first; i < end; i++) {
+        if (i > first) {
+            // Renumber the markers, since the decoder expects the first to be RST0.
+            band.push_back(0xFF);
+            band.push_back(SkToU8(JPEG_RST0 + (i - first - 1) % 8));
+        }
+        band.insert(band.end(), data + layout.start(i), data + layout.fMarkerOffsets[i]);
+    }
+    band.push_back(0xFF);
+    band.push_back(JPEG_EOI);
+    return band;
+}
+
+/*
+ * Reads the header of a band and starts decoding it with the same output settings as
+ * settings, discarding the first skipRows rows.
+ */
+static bool start_band(JpegDecoderMgr* decoderMgr, const jpeg_decompress_struct& settings,
+                       int skipRows) {
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return decoderMgr->returnFalse("start_band");
+    }
+
+    decoderMgr->init();
+    jpeg_decompress_struct* dinfo = decoderMgr->dinfo();
+    if (JPEG_HEADER_OK != jpeg_read_header(dinfo, true)) {
+        return false;
+    }
+    dinfo->out_color_space = settings.out_color_space;
+    dinfo->dither_mode = settings.dither_mode;
+    if (!jpeg_start_decompress(dinfo)) {
+        return false;
+    }
+
+    // Allocate from libjpeg's pool, which is freed even if libjpeg longjmps out of here.
+    JSAMPARRAY row = (*dinfo->mem->alloc_sarray)((j_common_ptr) dinfo, JPOOL_IMAGE,
+                                                 get_row_bytes(dinfo), 1);
+    for (int y = 0; y < skipRows; y++) {
+        if (1 != jpeg_read_scanlines(dinfo, row, 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SkJpegCodec::decodeInParallel(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                                   const Options& options) {
+    const jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    SkStream* stream = this->stream();
+    const uint8_t* data = static_cast<const uint8_t*>(stream->getMemoryBase());
+    if (!data || !stream->hasLength() || dstInfo.dimensions() != this->dimensions() ||
+            dinfo->restart_interval == 0 || dinfo->progressive_mode ||
+            dinfo->comps_in_scan != dinfo->num_components) {
+        return false;
+    }
+
+    // Each restart interval must cover whole rows of MCUs, so that bands are rows of pixels.
+    const int height = dinfo->image_height;
+    const bool interleaved = dinfo->comps_in_scan > 1;
+    const int mcuWidth  = interleaved ? dinfo->max_h_samp_factor * DCTSIZE : DCTSIZE;
+    const int mcuHeight = interleaved ? dinfo->max_v_samp_factor * DCTSIZE : DCTSIZE;
+    const size_t mcusPerRow = (dinfo->image_width + mcuWidth - 1) / mcuWidth;
+    const size_t mcuRows = (height + mcuHeight - 1) / mcuHeight;
+    if (dinfo->restart_interval % mcusPerRow != 0) {
+        return false;
+    }
+    const int rowsPerInterval = SkToInt(dinfo->restart_interval / mcusPerRow) * mcuHeight;
+
+    RestartLayout layout;
+    if (!find_restart_markers(data, stream->getLength(), &layout)) {
+        return false;
+    }
+    const int intervals = SkToInt(layout.fMarkerOffsets.size());
+    if ((size_t) intervals != (mcusPerRow * mcuRows + dinfo->restart_interval - 1) /
+                              dinfo->restart_interval) {
+        return false;
+    }
+
+    // Vertically upsampled chroma is smoothed with the rows above and below, so each band
+    // also decodes one interval on either side to match a serial decode at its edges. Keep
+    // bands long enough for that to be cheap, and numerous enough to keep threads busy.
+    constexpr int kMaxBands = 16;
+    constexpr int kMinIntervalsPerBand = 8;
+    const int overlap = (interleaved && dinfo->max_v_samp_factor > 1) ? 1 : 0;
+    const int bands = std::min(kMaxBands, intervals / kMinIntervalsPerBand);
+    if (bands < 2) {
+        return false;
+    }
+    const int intervalsPerBand = (intervals + bands - 1) / bands;
+
+    std::atomic<bool> failed{false};
+    SkTaskGroup taskGroup(*options.fExecutor);
+    taskGroup.batch(bands, [&](int band) {
+        const int first = band * intervalsPerBand;
+        const int end = std::min(intervals, first + intervalsPerBand);
+        if (first >= end || failed) {
+            return;
+        }
+        const int decodeFirst = std::max(0, first - overlap);
+        const int decodeEnd = std::min(intervals, end + overlap);
+        const int top = first * rowsPerInterval;
+        const int bottom = std::min(height, end * rowsPerInterval);
+        const int decodeTop = decodeFirst * rowsPerInterval;
+        const int decodeBottom = std::min(height, decodeEnd * rowsPerInterval);
+
+        std::vector<uint8_t> encoded = make_band(data, layout, decodeFirst, decodeEnd,
+                                                 decodeBottom - decodeTop);
+        SkMemoryStream bandStream(encoded.data(), encoded.size(), false);
+        JpegDecoderMgr decoderMgr(&bandStream);
+        if (!start_band(&decoderMgr, *dinfo, top - decodeTop)) {
+            failed = true;
+            return;
+        }
+
+        // Each band needs its own scratch rows, sized as in allocateStorage().
+        const size_t swizzleBytes = fSwizzler ? get_row_bytes(decoderMgr.dinfo()) : 0;
+        const int dstWidth = fSwizzler ? fSwizzler->swizzleWidth() : dstInfo.width();
+        const size_t xformBytes =
+                this->colorXform() && sizeof(uint32_t) != dstInfo.bytesPerPixel()
+                        ? dstWidth * sizeof(uint32_t) : 0;
+        SkAutoTMalloc<uint8_t> storage(swizzleBytes + xformBytes);
+        uint8_t* swizzleSrcRow = swizzleBytes ? storage.get() : nullptr;
+        uint32_t* colorXformSrcRow =
+                xformBytes ? SkTAddOffset<uint32_t>(storage.get(), swizzleBytes) : nullptr;
+
+        const int count = bottom - top;
+        if (count != this->readRows(&decoderMgr, swizzleSrcRow, colorXformSrcRow, dstInfo,
+                                    SkTAddOffset<void>(dst, top * rowBytes), rowBytes, count,
+                                    options)) {
+            failed = true;
+        }
+    });
+    taskGroup.wait();
+    return !failed;
+}
+
 bool SkJpegCodec::allocateStorage(const SkImageInfo& dstInfo) {
     int dstWidth = dstInfo.width();
 
@@ -738,7 +988,8 @@ SkCodec::Result SkJpegCodec::onStartScanlineDecode(const SkImageInfo& dstInfo,
 }
 
 int SkJpegCodec::onGetScanlines(void* dst, int count, size_t dstRowBytes) {
-    int rows = this->readRows(this->dstInfo(), dst, dstRowBytes, count, this->options());
+    int rows = this->readRows(fDecoderMgr.get(), fSwizzleSrcRow, fColorXformSrcRow,
+                              this->dstInfo(), dst, dstRowBytes, count, this->options());
     if (rows < count) {
         // This allows us to skip calling jpeg_finish_decompress().
         fDecoderMgr->dinfo()->output_scanline = this->dstInfo().height();
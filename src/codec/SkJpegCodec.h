@@ -121,7 +121,23 @@ private:
     void initializeSwizzler(const SkImageInfo& dstInfo, const Options& options,
                             bool needsCMYKToRGB);
     bool SK_WARN_UNUSED_RESULT allocateStorage(const SkImageInfo& dstInfo);
-    int readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count, const Options&);
+
+    /*
+     * Decodes count rows from decoderMgr, through the swizzler and color xform if needed.
+     * swizzleSrcRow and colorXformSrcRow are scratch rows, sized as in allocateStorage().
+     */
+    int readRows(JpegDecoderMgr* decoderMgr, uint8_t* swizzleSrcRow, uint32_t* colorXformSrcRow,
+                 const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count,
+                 const Options&);
+
+    /*
+     * Baseline jpegs whose restart intervals span whole rows of MCUs can be cut into bands
+     * that decode independently. Returns true if the whole image was decoded this way, and
+     * false if the image cannot be split or any band failed, in which case the caller
+     * should fall back to a serial decode.
+     */
+    bool decodeInParallel(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                          const Options&);
 
     /*
      * Scanline decoding.
@@ -11,6 +11,7 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPngChunkReader.h"
 #include "include/core/SkRect.h"
@@ -18,7 +19,9 @@
 #include "include/core/SkStream.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkEncodedInfo.h"
+#include "include/private/SkMutex.h"
 #include "include/private/SkNoncopyable.h"
+#include "include/private/SkSemaphore.h"
 #include "include/private/SkTemplates.h"
 #include "modules/skcms/skcms.h"
 #include "src/codec/SkCodecPriv.h"
@@ -26,9 +29,11 @@
 #include "src/codec/SkPngPriv.h"
 #include "src/codec/SkSwizzler.h"
 #include "src/core/SkOpts.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <csetjmp>
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <utility>
 
@@ -146,6 +151,20 @@ static inline bool is_chunk(const png_byte* chunk, const char* tag) {
 
 static inline bool process_data(png_structp png_ptr, png_infop info_ptr,
         SkStream* stream, void* buffer, size_t bufferSize, size_t length) {
+    // Memory backed streams can hand libpng their bytes directly, rather than copying them
+    // through buffer a few KB at a time. Skip first, so that the stream ends up in the same
+    // place as below if libpng longjmps out.
+    if (const void* base = stream->getMemoryBase(); base && stream->hasPosition() &&
+                                                    stream->hasLength()) {
+        const size_t position = stream->getPosition();
+        const size_t bytes = std::min(length, stream->getLength() - position);
+        stream->skip(bytes);
+        // libpng does not write to its input, despite the non-const pointer.
+        png_process_data(png_ptr, info_ptr,
+                         (png_bytep) const_cast<void*>(base) + position, bytes);
+        return bytes == length;
+    }
+
     while (length > 0) {
         const size_t bytesToProcess = std::min(bufferSize, length);
         const size_t bytesRead = stream->read(buffer, bytesToProcess);
@@ -521,10 +540,42 @@ public:
         GetDecoder(png_ptr)->rowCallback(row, rowNum);
     }
 
+    static void PipelinedRowsCallback(png_structp png_ptr, png_bytep row, png_uint_32 rowNum,
+                                      int /*pass*/) {
+        GetDecoder(png_ptr)->pipelinedRowsCallback(row, rowNum);
+    }
+
 private:
+    // When decoding with an executor, libpng inflates and unfilters rows on the calling thread
+    // while a task on the executor swizzles and color transforms the rows it has finished.
+    // Rows are handed over through a ring of kChunks chunks of kChunkRows rows each.
+    struct Pipeline {
+        static constexpr int kChunkRows = 16;
+        static constexpr int kChunks = 4;
+
+        explicit Pipeline(size_t srcRowBytes)
+            : fSrcRowBytes(srcRowBytes)
+            , fRows(kChunks * kChunkRows * srcRowBytes) {}
+
+        uint8_t* row(int rowNum) {
+            return fRows.get() + (rowNum % (kChunks * kChunkRows)) * fSrcRowBytes;
+        }
+
+        const size_t           fSrcRowBytes;
+        SkAutoTMalloc<uint8_t> fRows;
+        SkSemaphore            fFreeChunks{kChunks};
+        SkSemaphore            fReadyChunks;
+        std::atomic<int>       fRowsProduced{0};
+        std::atomic<bool>      fFinished{false};
+
+        SkMutex                fConsumerMutex;
+        int                    fRowsConsumed SK_GUARDED_BY(fConsumerMutex) = 0;
+    };
+
     int                         fRowsWrittenToOutput;
     void*                       fDst;
     size_t                      fRowBytes;
+    Pipeline*                   fPipeline = nullptr;
 
     // Variables for partial decode
     int                         fFirstRow;  // FIXME: Move to baseclass?
@@ -539,7 +590,6 @@ private:
 
     Result decodeAllRows(void* dst, size_t rowBytes, int* rowsDecoded) override {
         const int height = this->dimensions().height();
-        png_set_progressive_read_fn(this->png_ptr(), this, nullptr, AllRowsCallback, nullptr);
         fDst = dst;
         fRowBytes = rowBytes;
 
@@ -547,7 +597,14 @@ private:
         fFirstRow = 0;
         fLastRow = height - 1;
 
-        const bool success = this->processData();
+        bool success;
+        SkExecutor* executor = this->options().fExecutor;
+        if (executor && height > Pipeline::kChunkRows) {
+            success = this->decodeAllRowsPipelined(*executor);
+        } else {
+            png_set_progressive_read_fn(this->png_ptr(), this, nullptr, AllRowsCallback, nullptr);
+            success = this->processData();
+        }
         if (success && fRowsWrittenToOutput == height) {
             return kSuccess;
         }
@@ -566,6 +623,67 @@ private:
         fDst = SkTAddOffset<void>(fDst, fRowBytes);
     }
 
+    bool decodeAllRowsPipelined(SkExecutor& executor) {
+        Pipeline pipeline(png_get_rowbytes(this->png_ptr(), this->info_ptr()));
+        fPipeline = &pipeline;
+        png_set_progressive_read_fn(this->png_ptr(), this, nullptr, PipelinedRowsCallback,
+                                    nullptr);
+
+        SkTaskGroup consumer(executor);
+        consumer.add([this, &pipeline] {
+            bool finished;
+            do {
+                pipeline.fReadyChunks.wait();
+                finished = pipeline.fFinished.load(std::memory_order_acquire);
+                this->consumeRows();
+            } while (!finished);
+        });
+
+        const bool success = this->processData();
+
+        pipeline.fFinished.store(true, std::memory_order_release);
+        pipeline.fReadyChunks.signal();
+        consumer.wait();
+
+        SkAutoMutexExclusive lock(pipeline.fConsumerMutex);
+        fRowsWrittenToOutput = pipeline.fRowsConsumed;
+        fPipeline = nullptr;
+        return success;
+    }
+
+    void pipelinedRowsCallback(png_bytep row, int rowNum) {
+        Pipeline* pipeline = fPipeline;
+        SkASSERT(rowNum == pipeline->fRowsProduced.load(std::memory_order_relaxed));
+
+        if (rowNum % Pipeline::kChunkRows == 0 && !pipeline->fFreeChunks.try_wait()) {
+            // The consumer has fallen behind, or has not started (e.g. the executor is busy,
+            // or this thread is the executor's only thread). Catch up here instead of
+            // blocking on it.
+            this->consumeRows();
+            pipeline->fFreeChunks.wait();
+        }
+
+        memcpy(pipeline->row(rowNum), row, pipeline->fSrcRowBytes);
+        pipeline->fRowsProduced.store(rowNum + 1, std::memory_order_release);
+        if ((rowNum + 1) % Pipeline::kChunkRows == 0) {
+            pipeline->fReadyChunks.signal();
+        }
+    }
+
+    // Swizzles and color transforms every row libpng has produced so far.
+    void consumeRows() {
+        Pipeline* pipeline = fPipeline;
+        SkAutoMutexExclusive lock(pipeline->fConsumerMutex);
+        const int produced = pipeline->fRowsProduced.load(std::memory_order_acquire);
+        for (int& rowNum = pipeline->fRowsConsumed; rowNum < produced; rowNum++) {
+            this->applyXformRow(SkTAddOffset<void>(fDst, rowNum * fRowBytes),
+                                pipeline->row(rowNum));
+            if ((rowNum + 1) % Pipeline::kChunkRows == 0) {
+                pipeline->fFreeChunks.signal();
+            }
+        }
+    }
+
     void setRange(int firstRow, int lastRow, void* dst, size_t rowBytes) override {
         png_set_progressive_read_fn(this->png_ptr(), this, nullptr, RowCallback, nullptr);
         fFirstRow = firstRow;
@@ -39,10 +39,47 @@ public:
         fBlitter = SkBlitter::Choose(draw.fDst, *matrixProvider, paint, &fAlloc, drawCoverage,
                                      draw.fRC->clipShader(),
                                      SkSurfacePropsCopyOrDefault(draw.fProps));
+        if (draw.fBlitBounds) {
+            fBlitter = fAlloc.make<BoundsBlitter>(fBlitter, *draw.fBlitBounds);
+        }
         return fBlitter;
     }
 
 private:
+    // Keeps a blitter inside SkDraw::fBlitBounds. Unlike a plain SkRectClipBlitter it passes
+    // pixel pairs that fit through whole, since the real blitter's blitAntiH2/V2 may round
+    // differently from its blitAntiH, and a draw cut this way must match one that is not.
+    class BoundsBlitter final : public SkRectClipBlitter {
+    public:
+        BoundsBlitter(SkBlitter* blitter, const SkIRect& bounds)
+                : fRealBlitter(blitter), fBounds(bounds) {
+            this->init(blitter, bounds);
+        }
+
+        void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override {
+            if (fBounds.contains(SkIRect::MakeXYWH(x, y, 2, 1))) {
+                fRealBlitter->blitAntiH2(x, y, a0, a1);
+            } else {
+                this->SkRectClipBlitter::blitAntiH2(x, y, a0, a1);
+            }
+        }
+
+        void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override {
+            if (fBounds.contains(SkIRect::MakeXYWH(x, y, 1, 2))) {
+                fRealBlitter->blitAntiV2(x, y, a0, a1);
+            } else {
+                this->SkRectClipBlitter::blitAntiV2(x, y, a0, a1);
+            }
+        }
+
+        // Callers write straight into the returned pixels, which would skip the bounds.
+        const SkPixmap* justAnOpaqueColor(uint32_t*) override { return nullptr; }
+
+    private:
+        SkBlitter* fRealBlitter;
+        SkIRect    fBounds;
+    };
+
     // Owned by fAlloc, which will handle the delete.
     SkBlitter* fBlitter = nullptr;
 
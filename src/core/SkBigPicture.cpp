@@ -38,6 +38,17 @@ void SkBigPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
                  callback);
 }
 
+void SkBigPicture::playbackWithBBH(SkCanvas* canvas, const SkBBoxHierarchy* bbh) const {
+    SkASSERT(canvas);
+    SkRecordDraw(*fRecord,
+                 canvas,
+                 this->drawablePicts(),
+                 nullptr,
+                 this->drawableCount(),
+                 bbh,
+                 nullptr/*callback*/);
+}
+
 void SkBigPicture::partialPlayback(SkCanvas* canvas,
                                    int start,
                                    int stop,
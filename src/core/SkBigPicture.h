@@ -56,6 +56,8 @@ public:
                          int start,
                          int stop,
                          const SkM44& initialCTM) const;
+// Used by SkIncrementalPicturePlayer, which may supply a BBH built from record() when we have none.
+    void playbackWithBBH(SkCanvas*, const SkBBoxHierarchy*) const;
 // Used by GrRecordReplaceDraw
     const SkBBoxHierarchy* bbh() const { return fBBH.get(); }
     const SkRecord*     record() const { return fRecord.get(); }
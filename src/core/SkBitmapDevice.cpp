@@ -18,12 +18,14 @@
 #include "include/core/SkSurface.h"
 #include "include/core/SkVertices.h"
 #include "src/core/SkDraw.h"
+#include "src/core/SkDrawProcs.h"
 #include "src/core/SkImageFilterCache.h"
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkSpecialImage.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkTLazy.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/image/SkImage_Base.h"
 #include "src/text/GlyphRun.h"
 
@@ -175,16 +177,95 @@ private:
     }
 };
 
+// Splits a single SkDraw into horizontal bands that are rasterized concurrently on an executor.
+// The bands share the dst, matrix and clip of the original draw, and only their blitters are cut
+// to their rows (SkDraw::fBlitBounds). Cutting the clip instead would clip path edges to each
+// band and move where they start stepping. So each band builds the same edges and produces exactly
+// the pixels the whole draw would have produced in its rows, and the result is byte-identical to
+// drawing on one thread. The price is that every band steps all of the edges; only the blitting
+// is shared out.
+class SkThreadedDrawTiler {
+    enum {
+        kBandHeight = 256,
+        kMinArea    = 256 * 256,  // below this, fanning out costs more than it saves
+    };
+
+    SkExecutor*  fExecutor;
+    const SkDraw& fDraw;
+    SkIRect      fBounds;
+    int          fBands = 0;
+
+public:
+    // The bounds is in local coordinates, as with SkDrawTiler. A null executor is never active.
+    SkThreadedDrawTiler(SkExecutor* executor, const SkDraw& draw, const SkRect* bounds)
+            : fExecutor(executor), fDraw(draw) {
+        if (!fExecutor) {
+            return;
+        }
+        fBounds = draw.fRC->getBounds();
+        if (bounds && !fBounds.intersect(
+                    draw.fMatrixProvider->localToDevice().mapRect(*bounds).roundOut())) {
+            return;
+        }
+        if (sk_64_mul(fBounds.width(), fBounds.height()) < kMinArea) {
+            return;
+        }
+        fBands = (fBounds.height() + kBandHeight - 1) / kBandHeight;
+    }
+
+    bool active() const { return fBands > 1; }
+
+    template <typename Fn>
+    void run(const Fn& fn) const {
+        SkASSERT(this->active());
+
+        SkTaskGroup group(*fExecutor);
+        group.batch(fBands, [&](int i) {
+            const int top = fBounds.fTop + i * kBandHeight;
+            // Bands span the whole clip width, so only the seams between rows are new cuts.
+            const SkIRect& clip = fDraw.fRC->getBounds();
+            const SkIRect band = SkIRect::MakeLTRB(clip.fLeft, top, clip.fRight,
+                                                   std::min(top + kBandHeight, fBounds.fBottom));
+            SkDraw draw(fDraw);
+            draw.fBlitBounds = &band;
+            fn(&draw);
+        });
+        group.wait();
+    }
+};
+
 // Passing a bounds allows the tiler to only visit the dst-tiles that might intersect the
 // drawing. If null is passed, the tiler has to visit everywhere. The bounds is expected to be
 // in local coordinates, as the tiler itself will transform that into device coordinates.
 //
-#define LOOP_TILER(code, boundsPtr)                         \
+#define LOOP_TILER_SERIAL(code, boundsPtr)                  \
     SkDrawTiler priv_tiler(this, boundsPtr);                \
     while (const SkDraw* priv_draw = priv_tiler.next()) {   \
         priv_draw->code;                                    \
     }
 
+// Like LOOP_TILER_SERIAL, but if the device has an executor each tile may be drawn in concurrent
+// bands. The code must only touch the SkDraw it is handed (e.g. no re-entering the canvas).
+#define LOOP_TILER(code, boundsPtr)                                                            \
+    SkDrawTiler priv_tiler(this, boundsPtr);                                                   \
+    while (const SkDraw* priv_draw = priv_tiler.next()) {                                      \
+        SkThreadedDrawTiler priv_threaded(                                                     \
+                fExecutor, *priv_draw,                                                         \
+                fExecutor ? static_cast<const SkRect*>(boundsPtr) : nullptr);                  \
+        if (priv_threaded.active()) {                                                          \
+            priv_threaded.run([&](const SkDraw* priv_band) { priv_band->code; });             \
+        } else {                                                                               \
+            priv_draw->code;                                                                   \
+        }                                                                                      \
+    }
+
+// Hairlines stay on one thread: every band would step the whole line to blit a few of its pixels.
+// Points do too, since some of their procs write straight to the dst, past any blit bounds.
+static bool draws_hairlines(const SkPaint& paint, const SkMatrix& ctm) {
+    SkScalar coverage;
+    return SkDrawTreatAsHairline(paint, ctm, &coverage);
+}
+
 // Helper to create an SkDraw from a device
 class SkBitmapDevice::BDDraw : public SkDraw {
 public:
@@ -292,7 +373,11 @@ SkBaseDevice* SkBitmapDevice::onCreateDevice(const CreateInfo& cinfo, const SkPa
         info = info.makeColorType(kN32_SkColorType);
     }
 
-    return SkBitmapDevice::Create(info, surfaceProps, cinfo.fAllocator);
+    SkBitmapDevice* device = SkBitmapDevice::Create(info, surfaceProps, cinfo.fAllocator);
+    if (device) {
+        device->setExecutor(fExecutor);
+    }
+    return device;
 }
 
 bool SkBitmapDevice::onAccessPixels(SkPixmap* pmap) {
@@ -332,16 +417,26 @@ bool SkBitmapDevice::onReadPixels(const SkPixmap& pm, int x, int y) {
 ///////////////////////////////////////////////////////////////////////////////
 
 void SkBitmapDevice::drawPaint(const SkPaint& paint) {
-    BDDraw(this).drawPaint(paint);
+    BDDraw draw(this);
+    SkThreadedDrawTiler threaded(fExecutor, draw, nullptr);
+    if (threaded.active()) {
+        threaded.run([&](const SkDraw* band) { band->drawPaint(paint); });
+    } else {
+        draw.drawPaint(paint);
+    }
 }
 
 void SkBitmapDevice::drawPoints(SkCanvas::PointMode mode, size_t count,
                                 const SkPoint pts[], const SkPaint& paint) {
-    LOOP_TILER( drawPoints(mode, count, pts, paint, nullptr), nullptr)
+    LOOP_TILER_SERIAL( drawPoints(mode, count, pts, paint, nullptr), nullptr)
 }
 
 void SkBitmapDevice::drawRect(const SkRect& r, const SkPaint& paint) {
-    LOOP_TILER( drawRect(r, paint), Bounder(r, paint))
+    if (draws_hairlines(paint, this->localToDevice())) {
+        LOOP_TILER_SERIAL( drawRect(r, paint), Bounder(r, paint))
+    } else {
+        LOOP_TILER( drawRect(r, paint), Bounder(r, paint))
+    }
 }
 
 void SkBitmapDevice::drawOval(const SkRect& oval, const SkPaint& paint) {
@@ -356,23 +451,35 @@ void SkBitmapDevice::drawRRect(const SkRRect& rrect, const SkPaint& paint) {
     // required to override drawRRect.
     this->drawPath(SkPath::RRect(rrect), paint, true);
 #else
-    LOOP_TILER( drawRRect(rrect, paint), Bounder(rrect.getBounds(), paint))
+    if (draws_hairlines(paint, this->localToDevice())) {
+        LOOP_TILER_SERIAL( drawRRect(rrect, paint), Bounder(rrect.getBounds(), paint))
+    } else {
+        LOOP_TILER( drawRRect(rrect, paint), Bounder(rrect.getBounds(), paint))
+    }
 #endif
 }
 
 void SkBitmapDevice::drawPath(const SkPath& path,
                               const SkPaint& paint,
                               bool pathIsMutable) {
+    SkExecutor* executor = draws_hairlines(paint, this->localToDevice()) ? nullptr : fExecutor;
     const SkRect* bounds = nullptr;
-    if (SkDrawTiler::NeedsTiling(this) && !path.isInverseFillType()) {
+    if ((SkDrawTiler::NeedsTiling(this) || executor) && !path.isInverseFillType()) {
         bounds = &path.getBounds();
     }
-    SkDrawTiler tiler(this, bounds ? Bounder(*bounds, paint).bounds() : nullptr);
+    const Bounder bounder(bounds ? *bounds : SkRect::MakeEmpty(), paint);
+    SkDrawTiler tiler(this, bounds ? bounder.bounds() : nullptr);
     if (tiler.needsTiling()) {
         pathIsMutable = false;
     }
     while (const SkDraw* draw = tiler.next()) {
-        draw->drawPath(path, paint, nullptr, pathIsMutable);
+        SkThreadedDrawTiler threaded(executor, *draw, bounds ? bounder.bounds() : nullptr);
+        if (threaded.active()) {
+            // The bands share the path, so none of them may modify it.
+            threaded.run([&](const SkDraw* band) { band->drawPath(path, paint, nullptr, false); });
+        } else {
+            draw->drawPath(path, paint, nullptr, pathIsMutable);
+        }
     }
 }
 
@@ -381,7 +488,7 @@ void SkBitmapDevice::drawBitmap(const SkBitmap& bitmap, const SkMatrix& matrix,
                                 const SkPaint& paint) {
     const SkRect* bounds = dstOrNull;
     SkRect storage;
-    if (!bounds && SkDrawTiler::NeedsTiling(this)) {
+    if (!bounds && (SkDrawTiler::NeedsTiling(this) || fExecutor)) {
         matrix.mapRect(&storage, SkRect::MakeIWH(bitmap.width(), bitmap.height()));
         Bounder b(storage, paint);
         if (b.hasBounds()) {
@@ -522,7 +629,9 @@ void SkBitmapDevice::onDrawGlyphRunList(SkCanvas* canvas,
                                         const SkPaint& initialPaint,
                                         const SkPaint& drawingPaint) {
     SkASSERT(!glyphRunList.hasRSXForm());
-    LOOP_TILER( drawGlyphRunList(canvas, &fGlyphPainter, glyphRunList, drawingPaint), nullptr )
+    // Glyphs may be drawn as paths through the canvas, so this can't be split across threads.
+    LOOP_TILER_SERIAL( drawGlyphRunList(canvas, &fGlyphPainter, glyphRunList, drawingPaint),
+                       nullptr )
 }
 
 void SkBitmapDevice::drawVertices(const SkVertices* vertices,
@@ -607,7 +716,7 @@ sk_sp<SkSpecialImage> SkBitmapDevice::snapSpecial(const SkIRect& bounds, bool fo
 ///////////////////////////////////////////////////////////////////////////////
 
 sk_sp<SkSurface> SkBitmapDevice::makeSurface(const SkImageInfo& info, const SkSurfaceProps& props) {
-    return SkSurface::MakeRaster(info, &props);
+    return SkSurface::MakeRasterThreaded(info, fExecutor, &props);
 }
 
 SkImageFilterCache* SkBitmapDevice::getImageFilterCache() {
@@ -20,6 +20,7 @@
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkRasterClipStack.h"
 
+class SkExecutor;
 class SkImageFilterCache;
 class SkMatrix;
 class SkPaint;
@@ -154,8 +155,13 @@ private:
 
     SkImageFilterCache* getImageFilterCache() override;
 
+    // When set, large draws are split into bands and rasterized concurrently on this executor.
+    // Layer devices created by onCreateDevice() inherit it. Does not take ownership.
+    void setExecutor(SkExecutor* executor) { fExecutor = executor; }
+
     SkBitmap    fBitmap;
     void*       fRasterHandle = nullptr;
+    SkExecutor* fExecutor = nullptr;
     SkRasterClipStack  fRCStack;
     SkGlyphRunListPainterCPU fGlyphPainter;
 
@@ -108,3 +108,78 @@ SkPoint SkCubicMap::computeFromT(float t) const {
     (((a * t + b) * t + c) * t).store(&result);
     return result;
 }
+
+// Wide enough to keep several independent solver iterations in flight.
+static constexpr int kLanes = 16;
+using FN = skvx::Vec<kLanes, float>;
+
+// A vectorized version of SkOpts::cubic_solver() (x = -D).
+static FN cubic_solverN(const FN& A, const FN& B, const FN& C, const FN& x) {
+    FN t = x;
+    for (int iters = 0; iters < 8; ++iters) {
+        const FN f = ((A*t + B)*t + C)*t - x;
+        const auto converged = (f <= 0.00005f) & (f >= -0.00005f);
+        if (all(converged)) {
+            break;
+        }
+        const FN fp  = (3*A*t + 2*B)*t + C;
+        const FN fpp = 6*A*t + 2*B;
+
+        const FN numer = 2 * fp * f;
+        const FN denom = 2*fp*fp - f*fpp;
+
+        // Lanes stop updating once they converge, like the scalar loop.
+        t = if_then_else(converged, t, t - numer / denom);
+    }
+    return t;
+}
+
+void SkCubicMap::ComputeYFromX(const SkCubicMap* const maps[], const float xs[], float ys[],
+                               int count) {
+    // Solver-type cubics are gathered (SoA) into groups of kLanes; everything else takes the
+    // scalar fast paths.
+    float A[kLanes], B[kLanes], C[kLanes], a[kLanes], b[kLanes], c[kLanes], x[kLanes];
+    int   index[kLanes];
+    int   n = 0;
+
+    auto flush = [&]() {
+        // Pad with a trivial (already converged) cubic.
+        for (int k = n; k < kLanes; ++k) {
+            A[k] = B[k] = a[k] = b[k] = 0;
+            C[k] = c[k] = 1;
+            x[k] = 0.5f;
+        }
+        const FN t = cubic_solverN(FN::Load(A), FN::Load(B), FN::Load(C), FN::Load(x));
+        float y[kLanes];
+        (((FN::Load(a)*t + FN::Load(b))*t + FN::Load(c))*t).store(y);
+        for (int k = 0; k < n; ++k) {
+            ys[index[k]] = y[k];
+        }
+        n = 0;
+    };
+
+    for (int i = 0; i < count; ++i) {
+        const SkCubicMap& map = *maps[i];
+        const float xi = SkTPin(xs[i], 0.0f, 1.0f);
+        if (map.fType != kSolver_Type || nearly_zero(xi) || nearly_zero(1 - xi)) {
+            ys[i] = map.computeYFromX(xi);
+            continue;
+        }
+
+        A[n] = map.fCoeff[0].fX;
+        B[n] = map.fCoeff[1].fX;
+        C[n] = map.fCoeff[2].fX;
+        a[n] = map.fCoeff[0].fY;
+        b[n] = map.fCoeff[1].fY;
+        c[n] = map.fCoeff[2].fY;
+        x[n] = xi;
+        index[n] = i;
+        if (++n == kLanes) {
+            flush();
+        }
+    }
+
+    if (n > 0) {
+        flush();
+    }
+}
@@ -1106,8 +1106,10 @@ void SkDraw::drawBitmap(const SkBitmap& bitmap, const SkMatrix& prematrix,
             SkBlitter* blitter = SkBlitter::ChooseSprite(fDst, *paint, pmap, ix, iy, &allocator,
                                                          fRC->clipShader());
             if (blitter) {
-                SkScan::FillIRect(SkIRect::MakeXYWH(ix, iy, pmap.width(), pmap.height()),
-                                  *fRC, blitter);
+                SkIRect spriteRect = SkIRect::MakeXYWH(ix, iy, pmap.width(), pmap.height());
+                if (!fBlitBounds || spriteRect.intersect(*fBlitBounds)) {
+                    SkScan::FillIRect(spriteRect, *fRC, blitter);
+                }
                 return;
             }
             // if !blitter, then we fall-through to the slower case
@@ -167,6 +167,9 @@ public:
     const SkMatrixProvider* fMatrixProvider{nullptr};  // required
     const SkRasterClip*     fRC{nullptr};              // required
     const SkSurfaceProps*   fProps{nullptr};           // optional
+    // optional: if set, blitters chosen for this draw only write inside it (see
+    // SkAutoBlitterChoose), while edges are still built against all of fRC.
+    const SkIRect*          fBlitBounds{nullptr};
 
 #ifdef SK_DEBUG
     void validate() const;
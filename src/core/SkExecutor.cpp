@@ -10,6 +10,7 @@
 #include "include/private/SkSemaphore.h"
 #include "include/private/SkSpinlock.h"
 #include "include/private/SkTArray.h"
+#include <atomic>
 #include <deque>
 #include <thread>
 
@@ -139,6 +140,134 @@ private:
     bool                  fAllowBorrowing;
 };
 
+// An SkWorkStealingThreadPool gives each of its threads its own deque of work, so that
+// fine-grained work added by tasks already running on the pool rarely touches a shared lock.
+// A single semaphore still counts the total work available, for sleeping and waking threads.
+class SkWorkStealingThreadPool final : public SkExecutor {
+public:
+    explicit SkWorkStealingThreadPool(int threads, bool allowBorrowing)
+            : fQueues(new Queue[threads])
+            , fQueueCount(threads)
+            , fAllowBorrowing(allowBorrowing) {
+        for (int i = 0; i < threads; i++) {
+            fThreads.emplace_back(&Loop, this, i);
+        }
+    }
+
+    ~SkWorkStealingThreadPool() override {
+        // Signal each thread that it's time to shut down.
+        for (int i = 0; i < fThreads.count(); i++) {
+            this->add(nullptr);
+        }
+        // Wait for each thread to shut down.
+        for (int i = 0; i < fThreads.count(); i++) {
+            fThreads[i].join();
+        }
+    }
+
+    void add(std::function<void(void)> work) override {
+        // Work added from one of our own threads stays on that thread's queue, where it's likely
+        // to run soon and with warm caches. Work from elsewhere is dealt out round-robin.
+        int index = (tPool == this)
+                  ? tQueueIndex
+                  : (int)(fNextQueue.fetch_add(1, std::memory_order_relaxed) % fQueueCount);
+        {
+            SkAutoSpinlock lock(fQueues[index].fLock);
+            fQueues[index].fWork.emplace_back(std::move(work));
+        }
+        fWorkAvailable.signal(1);
+    }
+
+    void borrow() override {
+        // If there is work waiting and we're allowed to borrow work, do it.
+        if (fAllowBorrowing && fWorkAvailable.try_wait()) {
+            SkAssertResult(this->do_work(-1));
+        }
+    }
+
+private:
+    struct Queue {
+        SkSpinlock                            fLock;
+        std::deque<std::function<void(void)>> fWork;
+    };
+
+    // Pop the newest work from our own queue, or failing that, steal the oldest work from
+    // another queue, starting from a random one so thieves spread out.
+    bool try_pop(int self, std::function<void(void)>* work) {
+        if (self >= 0) {
+            SkAutoSpinlock lock(fQueues[self].fLock);
+            if (!fQueues[self].fWork.empty()) {
+                *work = std::move(fQueues[self].fWork.back());
+                fQueues[self].fWork.pop_back();
+                return true;
+            }
+        }
+
+        // xorshift32; it only needs to be cheap and differ between threads.
+        uint32_t seed = tSeed ? tSeed : (uint32_t)(uintptr_t)&tSeed | 1;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        tSeed = seed;
+
+        const int start = (int)(seed % fQueueCount);
+        for (int i = 0; i < fQueueCount; i++) {
+            const int victim = (start + i) % fQueueCount;
+            if (victim == self) {
+                continue;
+            }
+            SkAutoSpinlock lock(fQueues[victim].fLock);
+            if (!fQueues[victim].fWork.empty()) {
+                *work = std::move(fQueues[victim].fWork.front());
+                fQueues[victim].fWork.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // This method should be called only when fWorkAvailable indicates there's work to do.
+    bool do_work(int self) {
+        // Each successful wait() on fWorkAvailable reserves one piece of work that has already
+        // been queued, so it must be in some queue. We may miss it on a pass if another thread
+        // takes the work we were heading for, but then the work that thread reserved is still
+        // out there for us.
+        std::function<void(void)> work;
+        while (!this->try_pop(self, &work)) {}
+
+        if (!work) {
+            return false;  // This is Loop()'s signal to shut down.
+        }
+
+        work();
+        return true;
+    }
+
+    static void Loop(SkWorkStealingThreadPool* pool, int index) {
+        tPool = pool;
+        tQueueIndex = index;
+        do {
+            pool->fWorkAvailable.wait();
+        } while (pool->do_work(index));
+        tPool = nullptr;
+    }
+
+    static thread_local SkWorkStealingThreadPool* tPool;
+    static thread_local int                       tQueueIndex;
+    static thread_local uint32_t                  tSeed;
+
+    std::unique_ptr<Queue[]> fQueues;
+    const int                fQueueCount;
+    SkTArray<std::thread>    fThreads;
+    std::atomic<uint32_t>    fNextQueue{0};
+    SkSemaphore              fWorkAvailable;
+    bool                     fAllowBorrowing;
+};
+
+thread_local SkWorkStealingThreadPool* SkWorkStealingThreadPool::tPool = nullptr;
+thread_local int SkWorkStealingThreadPool::tQueueIndex = -1;
+thread_local uint32_t SkWorkStealingThreadPool::tSeed = 0;
+
 std::unique_ptr<SkExecutor> SkExecutor::MakeFIFOThreadPool(int threads, bool allowBorrowing) {
     using WorkList = std::deque<std::function<void(void)>>;
     return std::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores(),
@@ -149,3 +278,8 @@ std::unique_ptr<SkExecutor> SkExecutor::MakeLIFOThreadPool(int threads, bool all
     return std::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores(),
                                                     allowBorrowing);
 }
+std::unique_ptr<SkExecutor> SkExecutor::MakeWorkStealingThreadPool(int threads,
+                                                                   bool allowBorrowing) {
+    return std::make_unique<SkWorkStealingThreadPool>(threads > 0 ? threads : num_cores(),
+                                                      allowBorrowing);
+}
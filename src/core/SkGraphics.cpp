@@ -27,6 +27,7 @@
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkTSearch.h"
 #include "src/core/SkTypefaceCache.h"
+#include "src/core/SkVMBlitter.h"
 
 #include <stdlib.h>
 
@@ -159,3 +160,15 @@ extern bool gSkVMAllowJIT;
 void SkGraphics::AllowJIT() {
     gSkVMAllowJIT = true;
 }
+
+void SkGraphics::SetRasterProgramCacheEnabled(bool enabled) {
+    SkVMBlitter::SetPersistentProgramsEnabled(enabled);
+}
+
+sk_sp<SkData> SkGraphics::SaveRasterPrograms() {
+    return SkVMBlitter::SavePersistentPrograms();
+}
+
+bool SkGraphics::LoadRasterPrograms(const SkData& data) {
+    return SkVMBlitter::LoadPersistentPrograms(data);
+}
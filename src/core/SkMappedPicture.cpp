@@ -0,0 +1,66 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkMappedPicture.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkTextBlob.h"
+#include "include/core/SkVertices.h"
+#include "src/core/SkPicturePlayback.h"
+#include "src/core/SkReadBuffer.h"
+
+#if SK_SUPPORT_GPU
+#include "include/private/chromium/Slug.h"
+#endif
+
+sk_sp<SkPicture> SkMappedPicture::Make(const SkPictInfo& info,
+                                       std::unique_ptr<SkPictureData> data) {
+    if (!data || !data->opData()) {
+        return nullptr;
+    }
+    return sk_sp<SkPicture>(new SkMappedPicture(info.fCullRect, std::move(data)));
+}
+
+SkMappedPicture::SkMappedPicture(const SkRect& cull, std::unique_ptr<SkPictureData> data)
+    : fCullRect(cull)
+    , fData(std::move(data)) {}
+
+void SkMappedPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
+    SkASSERT(canvas);
+    SkPicturePlayback playback(fData.get());
+    playback.draw(canvas, callback, nullptr);
+}
+
+SkRect SkMappedPicture::cullRect() const { return fCullRect; }
+
+int SkMappedPicture::approximateOpCount(bool /*nested*/) const {
+    // Sub-pictures count as a single op; counting theirs would mean walking all their ops too.
+    fOpCountOnce([this] {
+        SkReadBuffer reader(fData->opData()->bytes(), fData->opData()->size());
+        int count = 0;
+        while (!reader.eof() && reader.isValid()) {
+            // The same header SkPicturePlayback::draw() reads. Sizes include the first word, and
+            // SkPictureRecord::addDraw() adds one (not four) for the second word, if there is one.
+            uint32_t size = reader.readUInt() & 0xffffff;
+            if (size == 0xffffff) {
+                size = reader.readUInt() - 1;
+            }
+            if (!reader.validate(size >= sizeof(uint32_t))) {
+                break;
+            }
+            reader.skip(size - sizeof(uint32_t));
+            count++;
+        }
+        fOpCount = count;
+    });
+    return fOpCount;
+}
+
+size_t SkMappedPicture::approximateBytesUsed() const {
+    // Like SkBigPicture, count the ops whether or not they're shared with the caller's SkData.
+    return sizeof(*this) + fData->opData()->size();
+}
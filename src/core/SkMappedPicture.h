@@ -0,0 +1,42 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMappedPicture_DEFINED
+#define SkMappedPicture_DEFINED
+
+#include "include/core/SkPicture.h"
+#include "include/private/SkOnce.h"
+#include "src/core/SkPictureData.h"
+
+#include <memory>
+
+// An SkPicture that plays back directly from deserialized SkPictureData, rather than from an
+// SkRecord re-recorded from it. Its op data (and encoded images) usually refer to the SkData
+// passed to SkPicture::MakeFromMappedData(), which is often a file mapping.
+class SkMappedPicture final : public SkPicture {
+public:
+    // Returns null if data is null or has no ops.
+    static sk_sp<SkPicture> Make(const SkPictInfo&, std::unique_ptr<SkPictureData> data);
+
+// SkPicture overrides
+    void playback(SkCanvas*, AbortCallback*) const override;
+    SkRect cullRect() const override;
+    int approximateOpCount(bool nested) const override;
+    size_t approximateBytesUsed() const override;
+
+private:
+    SkMappedPicture(const SkRect& cull, std::unique_ptr<SkPictureData>);
+
+    const SkRect                               fCullRect;
+    const std::unique_ptr<const SkPictureData> fData;
+
+    // Counting ops touches all of the op data, so we only do it if asked.
+    mutable SkOnce fOpCountOnce;
+    mutable int    fOpCount = 0;
+};
+
+#endif//SkMappedPicture_DEFINED
@@ -12,6 +12,7 @@
 #include "include/core/SkSerialProcs.h"
 #include "include/private/SkTo.h"
 #include "src/core/SkCanvasPriv.h"
+#include "src/core/SkMappedPicture.h"
 #include "src/core/SkMathPriv.h"
 #include "src/core/SkPictureData.h"
 #include "src/core/SkPicturePlayback.h"
@@ -166,8 +167,18 @@ sk_sp<SkPicture> SkPicture::MakeFromData(const SkData* data, const SkDeserialPro
     return MakeFromStream(&stream, procs, nullptr);
 }
 
+sk_sp<SkPicture> SkPicture::MakeFromMappedData(sk_sp<SkData> data,
+                                               const SkDeserialProcs* procs) {
+    if (!data) {
+        return nullptr;
+    }
+    SkMemoryStream stream(data);
+    return MakeFromStream(&stream, procs, nullptr, data.get());
+}
+
 sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialProcs* procsPtr,
-                                           SkTypefacePlayback* typefaces) {
+                                           SkTypefacePlayback* typefaces,
+                                           const SkData* mapping) {
     SkPictInfo info;
     if (!StreamIsSKP(stream, &info)) {
         return nullptr;
@@ -183,7 +194,11 @@ sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialPro
     switch (trailingStreamByteAfterPictInfo) {
         case kPictureData_TrailingStreamByteAfterPictInfo: {
             std::unique_ptr<SkPictureData> data(
-                    SkPictureData::CreateFromStream(stream, info, procs, typefaces));
+                    SkPictureData::CreateFromStream(stream, info, procs, typefaces, mapping));
+            if (mapping) {
+                // Play back from the SkPictureData itself rather than re-recording it.
+                return SkMappedPicture::Make(info, std::move(data));
+            }
             return Forwardport(info, data.get(), nullptr);
         }
         case kCustom_TrailingStreamByteAfterPictInfo: {
@@ -96,6 +96,18 @@ static void write_tag_size(SkWStream* stream, uint32_t tag, size_t size) {
     stream->write32(SkToU32(size));
 }
 
+// Pads the stream so that the payload of the next tag starts at a 4-byte aligned offset, which
+// lets SkPicture::MakeFromMappedData() read it in place. Tags and sizes are 4 bytes each, so
+// only the padding itself needs to make up the difference.
+static void align_next_payload(SkWStream* stream) {
+    static constexpr char kZeros[3] = {0, 0, 0};
+    size_t pad = SkAlign4(stream->bytesWritten()) - stream->bytesWritten();
+    if (pad > 0) {
+        write_tag_size(stream, SK_PICT_PADDING_TAG, pad);
+        stream->write(kZeros, pad);
+    }
+}
+
 void SkPictureData::WriteFactories(SkWStream* stream, const SkFactorySet& rec) {
     int count = rec.count();
 
@@ -220,6 +232,7 @@ static SkSerialProcs skip_typeface_proc(const SkSerialProcs& procs) {
 void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
                               SkRefCntSet* topLevelTypeFaceSet, bool textBlobsOnly) const {
     // This can happen at pretty much any time, so might as well do it first.
+    align_next_payload(stream);
     write_tag_size(stream, SK_PICT_READER_TAG, fOpData->size());
     stream->write(fOpData->bytes(), fOpData->size());
 
@@ -258,6 +271,7 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     WriteTypefaces(stream, *typefaceSet, procs);
 
     // Write the buffer.
+    align_next_payload(stream);
     write_tag_size(stream, SK_PICT_BUFFER_SIZE_TAG, buffer.bytesWritten());
     buffer.writeToStream(stream);
 
@@ -297,16 +311,42 @@ void SkPictureData::flatten(SkWriteBuffer& buffer) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// If stream is reading directly from mapping, returns its next size bytes as a subset of mapping
+// and skips past them. Returns null if they can't be shared, e.g. if they're not 4-byte aligned.
+static sk_sp<SkData> share_from_mapping(SkStream* stream, const SkData* mapping, size_t size) {
+    if (!mapping || !stream->hasPosition() || stream->getMemoryBase() != mapping->data()) {
+        return nullptr;
+    }
+    size_t offset = stream->getPosition();
+    if (offset > mapping->size() || size > mapping->size() - offset ||
+        !SkIsAlign4((uintptr_t)mapping->bytes() + offset)) {
+        return nullptr;
+    }
+    if (stream->skip(size) != size) {
+        return nullptr;
+    }
+    return SkData::MakeSubset(mapping, offset, size);
+}
+
 bool SkPictureData::parseStreamTag(SkStream* stream,
                                    uint32_t tag,
                                    uint32_t size,
                                    const SkDeserialProcs& procs,
-                                   SkTypefacePlayback* topLevelTFPlayback) {
+                                   SkTypefacePlayback* topLevelTFPlayback,
+                                   const SkData* mapping) {
     switch (tag) {
         case SK_PICT_READER_TAG:
             SkASSERT(nullptr == fOpData);
-            fOpData = SkData::MakeFromStream(stream, size);
+            fOpData = share_from_mapping(stream, mapping, size);
             if (!fOpData) {
+                fOpData = SkData::MakeFromStream(stream, size);
+            }
+            if (!fOpData) {
+                return false;
+            }
+            break;
+        case SK_PICT_PADDING_TAG:
+            if (stream->skip(size) != size) {
                 return false;
             }
             break;
@@ -346,7 +386,7 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             fPictures.reserve_back(SkToInt(size));
 
             for (uint32_t i = 0; i < size; i++) {
-                auto pic = SkPicture::MakeFromStream(stream, &procs, topLevelTFPlayback);
+                auto pic = SkPicture::MakeFromStream(stream, &procs, topLevelTFPlayback, mapping);
                 if (!pic) {
                     return false;
                 }
@@ -354,12 +394,17 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             }
         } break;
         case SK_PICT_BUFFER_SIZE_TAG: {
-            SkAutoMalloc storage(size);
-            if (stream->read(storage.get(), size) != size) {
-                return false;
+            SkReadBuffer buffer;
+            SkAutoMalloc storage;
+            if (sk_sp<SkData> shared = share_from_mapping(stream, mapping, size)) {
+                buffer.setMemory(std::move(shared));
+            } else {
+                storage.reset(size);
+                if (stream->read(storage.get(), size) != size) {
+                    return false;
+                }
+                buffer.setMemory(storage.get(), size);
             }
-
-            SkReadBuffer buffer(storage.get(), size);
             buffer.setVersion(fInfo.getVersion());
 
             if (!fFactoryPlayback) {
@@ -493,13 +538,14 @@ void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t
 SkPictureData* SkPictureData::CreateFromStream(SkStream* stream,
                                                const SkPictInfo& info,
                                                const SkDeserialProcs& procs,
-                                               SkTypefacePlayback* topLevelTFPlayback) {
+                                               SkTypefacePlayback* topLevelTFPlayback,
+                                               const SkData* mapping) {
     std::unique_ptr<SkPictureData> data(new SkPictureData(info));
     if (!topLevelTFPlayback) {
         topLevelTFPlayback = &data->fTFPlayback;
     }
 
-    if (!data->parseStream(stream, procs, topLevelTFPlayback)) {
+    if (!data->parseStream(stream, procs, topLevelTFPlayback, mapping)) {
         return nullptr;
     }
     return data.release();
@@ -518,7 +564,8 @@ SkPictureData* SkPictureData::CreateFromBuffer(SkReadBuffer& buffer,
 
 bool SkPictureData::parseStream(SkStream* stream,
                                 const SkDeserialProcs& procs,
-                                SkTypefacePlayback* topLevelTFPlayback) {
+                                SkTypefacePlayback* topLevelTFPlayback,
+                                const SkData* mapping) {
     for (;;) {
         uint32_t tag;
         if (!stream->readU32(&tag)) { return false; }
@@ -528,7 +575,7 @@ bool SkPictureData::parseStream(SkStream* stream,
 
         uint32_t size;
         if (!stream->readU32(&size)) { return false; }
-        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback)) {
+        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback, mapping)) {
             return false; // we're invalid
         }
     }
@@ -39,11 +39,24 @@ namespace {
 void SkReadBuffer::setMemory(const void* data, size_t size) {
     this->validate(IsPtrAlign4(data) && (SkAlign4(size) == size));
     if (!fError) {
+        // The new memory isn't backed by any SkData we hold.
+        fData.reset();
         fBase = fCurr = (const char*)data;
         fStop = fBase + size;
     }
 }
 
+void SkReadBuffer::setMemory(sk_sp<SkData> data) {
+    if (data) {
+        this->setMemory(data->data(), data->size());
+        if (!fError) {
+            fData = std::move(data);
+        }
+    } else {
+        this->setMemory(nullptr, 0);
+    }
+}
+
 void SkReadBuffer::setInvalid() {
     if (!fError) {
         // When an error is found, send the read cursor to the end of the stream
@@ -305,6 +318,15 @@ sk_sp<SkData> SkReadBuffer::readByteArrayAsData() {
         return nullptr;
     }
 
+    if (fData) {
+        // Share our backing data instead of copying; skipByteArray() advances past the count.
+        size_t offset = fCurr + sizeof(uint32_t) - fBase;
+        if (!this->skipByteArray(nullptr) || !this->isValid()) {
+            return nullptr;
+        }
+        return SkData::MakeSubset(fData.get(), offset, numBytes);
+    }
+
     SkAutoMalloc buffer(numBytes);
     if (!this->readByteArray(buffer.get(), numBytes)) {
         return nullptr;
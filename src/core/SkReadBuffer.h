@@ -8,6 +8,7 @@
 #ifndef SkReadBuffer_DEFINED
 #define SkReadBuffer_DEFINED
 
+#include "include/core/SkData.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkPath.h"
@@ -42,6 +43,13 @@ public:
 
     void setMemory(const void*, size_t);
 
+    /**
+     *  Reads from data, which this buffer keeps alive. readByteArrayAsData() then returns
+     *  subsets of data rather than copies, so e.g. encoded images can refer to an SkData
+     *  mapped from a file without ever being copied onto the heap.
+     */
+    void setMemory(sk_sp<SkData> data);
+
     /**
      *  Returns true IFF the version is older than the specified version.
      */
@@ -220,6 +228,7 @@ private:
     const char* fCurr = nullptr;  // current position within buffer
     const char* fStop = nullptr;  // end of buffer
     const char* fBase = nullptr;  // beginning of buffer
+    sk_sp<SkData> fData;          // owns fBase, if set by setMemory(sk_sp<SkData>)
 
     // Only used if we do not have an fFactoryArray.
     SkTHashMap<uint32_t, SkFlattenable::Factory> fFlattenableDict;
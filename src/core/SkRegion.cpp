@@ -10,11 +10,13 @@
 #include "include/private/SkMacros.h"
 #include "include/private/SkTemplates.h"
 #include "include/private/SkTo.h"
+#include "include/private/SkVx.h"
 #include "src/core/SkRegionPriv.h"
 #include "src/core/SkSafeMath.h"
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 /* Region Layout
  *
@@ -647,16 +649,91 @@ void SkRegion::translate(int dx, int dy, SkRegion* dst) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static bool is_valid_region_rect(const SkIRect& r) {
+    // The same rects setRect() accepts.
+    return !r.isEmpty() &&
+           SkRegion_kRunTypeSentinel != r.right() &&
+           SkRegion_kRunTypeSentinel != r.bottom();
+}
+
 bool SkRegion::setRects(const SkIRect rects[], int count) {
-    if (0 == count) {
-        this->setEmpty();
-    } else {
-        this->setRect(rects[0]);
-        for (int i = 1; i < count; i++) {
-            this->op(rects[i], kUnion_Op);
+    std::vector<SkIRect> sorted;
+    sorted.reserve(count);
+    for (int i = 0; i < count; i++) {
+        if (is_valid_region_rect(rects[i])) {
+            sorted.push_back(rects[i]);
         }
     }
-    return !this->isEmpty();
+    if (sorted.size() <= 1) {
+        return sorted.empty() ? this->setEmpty() : this->setRect(sorted[0]);
+    }
+
+    // Rather than union-ing one rect at a time, which is quadratic in the number of rects, sweep
+    // down through the rects, building each scanline from the rects that span it.
+    std::sort(sorted.begin(), sorted.end(), [](const SkIRect& a, const SkIRect& b) {
+        return a.fTop < b.fTop;
+    });
+    std::vector<int32_t> edges;  // Every top and bottom, in order.
+    edges.reserve(2 * sorted.size());
+    for (const SkIRect& r : sorted) {
+        edges.push_back(r.fTop);
+        edges.push_back(r.fBottom);
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    RunArray array;
+    int n = 0;
+    array.resizeToAtLeast(2);
+    array[n++] = edges[0];  // top
+
+    std::vector<SkIRect> active;  // Rects overlapping the current scanline, sorted by left.
+    std::vector<int32_t> spans;   // The current scanline's intervals, coalesced.
+    int prevSpan = -1;            // Where the previous scanline's intervals start in array.
+    size_t nextRect = 0;
+    for (size_t e = 0; e + 1 < edges.size(); e++) {
+        const int32_t top = edges[e],
+                      bot = edges[e + 1];
+
+        active.erase(std::remove_if(active.begin(), active.end(), [=](const SkIRect& r) {
+            return r.fBottom <= top;
+        }), active.end());
+        const size_t oldActive = active.size();
+        while (nextRect < sorted.size() && sorted[nextRect].fTop == top) {
+            active.push_back(sorted[nextRect++]);
+        }
+        auto byLeft = [](const SkIRect& a, const SkIRect& b) { return a.fLeft < b.fLeft; };
+        std::sort(active.begin() + oldActive, active.end(), byLeft);
+        std::inplace_merge(active.begin(), active.begin() + oldActive, active.end(), byLeft);
+
+        spans.clear();
+        for (const SkIRect& r : active) {
+            if (!spans.empty() && r.fLeft <= spans.back()) {
+                spans.back() = std::max(spans.back(), r.fRight);
+            } else {
+                spans.push_back(r.fLeft);
+                spans.push_back(r.fRight);
+            }
+        }
+
+        // Extend the previous scanline down if this one matches it.
+        const int spanCount = SkToInt(spans.size());
+        if (prevSpan >= 0 && array[prevSpan - 1] == spanCount / 2 &&
+            std::equal(spans.begin(), spans.end(), &array[prevSpan])) {
+            array[prevSpan - 2] = bot;
+            continue;
+        }
+        // bottom, interval count, intervals, x-sentinel, and room for the final y-sentinel.
+        array.resizeToAtLeast(n + spanCount + 4);
+        array[n++] = bot;
+        array[n++] = spanCount / 2;
+        prevSpan = n;
+        std::copy(spans.begin(), spans.end(), &array[n]);
+        n += spanCount;
+        array[n++] = SkRegion_kRunTypeSentinel;
+    }
+    array[n++] = SkRegion_kRunTypeSentinel;
+    return this->setRuns(&array[0], n);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -766,21 +843,120 @@ struct spanRec {
     }
 };
 
-static int distance_to_sentinel(const SkRegionPriv::RunType* runs) {
-    const SkRegionPriv::RunType* ptr = runs;
-    while (*ptr != SkRegion_kRunTypeSentinel) { ptr += 2; }
-    return ptr - runs;
+// Returns the number of intervals whose left (Edge == 0) or right (Edge == 1) edge is less than x.
+// Intervals are sorted and disjoint, so that's also the index of the first one whose edge isn't.
+template <int Edge>
+static int count_edges_below(const SkRegionPriv::RunType intervals[], int count, int x) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        skvx::Vec<4, SkRegionPriv::RunType> lefts, rites;
+        skvx::strided_load2(intervals + 2*i, lefts, rites);
+        if (!skvx::all((Edge == 0 ? lefts : rites) < x)) {
+            break;
+        }
+    }
+    while (i < count && intervals[2*i + Edge] < x) {
+        i++;
+    }
+    return i;
+}
+
+static SkRegionPriv::RunType* copy_intervals(SkRegionPriv::RunType* dst,
+                                             const SkRegionPriv::RunType intervals[],
+                                             int count) {
+    memcpy(dst, intervals, 2 * count * sizeof(SkRegionPriv::RunType));
+    return dst + 2 * count;
+}
+
+// Handles the spans that dominate when regions are built up or carved away one rect at a time:
+// one span is empty or a single interval. Rather than stepping through both spans edge by edge,
+// we find the intervals the single interval touches with vector compares and copy the rest
+// wholesale. Returns null (having written nothing) if the general merge is needed instead.
+static SkRegionPriv::RunType* operate_on_simple_span(const SkRegionPriv::RunType a_runs[],
+                                                     int a_count,
+                                                     const SkRegionPriv::RunType b_runs[],
+                                                     int b_count,
+                                                     SkRegionPriv::RunType* dst,
+                                                     int min, int max) {
+    // Parts of A outside B have fInside == 1, and parts of B outside A have fInside == 2.
+    const bool keepA = min <= 1 && 1 <= max,
+               keepB = min <= 2 && 2 <= max;
+    if (b_count == 0) {
+        return keepA ? copy_intervals(dst, a_runs, a_count) : dst;
+    }
+    if (a_count == 0) {
+        return keepB ? copy_intervals(dst, b_runs, b_count) : dst;
+    }
+
+    const bool isUnion = min == 1 && max == 3,
+               isSect  = min == 3,
+               isDiff  = min == 1 && max == 1;
+    if (a_count == 1 && b_count > 1 && (isUnion || isSect)) {
+        // These are symmetric, so make B the single interval.
+        using std::swap;
+        swap(a_runs, b_runs);
+        swap(a_count, b_count);
+    }
+    if (b_count != 1 || !(isUnion || isSect || isDiff)) {
+        return nullptr;
+    }
+
+    const int left = b_runs[0],
+              rite = b_runs[1];
+    if (isUnion) {
+        // A's intervals [i0,i1) overlap or abut B, and merge with it into one interval.
+        const int i0 = count_edges_below<1>(a_runs, a_count, left),
+                  i1 = count_edges_below<0>(a_runs, a_count, rite + 1);
+        dst = copy_intervals(dst, a_runs, i0);
+        *dst++ = i0 < i1 ? std::min(left, a_runs[2*i0    ]) : left;
+        *dst++ = i0 < i1 ? std::max(rite, a_runs[2*i1 - 1]) : rite;
+        return copy_intervals(dst, a_runs + 2*i1, a_count - i1);
+    }
+
+    // A's intervals [i0,i1) overlap B; the first and last of them may straddle its edges.
+    const int i0 = count_edges_below<1>(a_runs, a_count, left + 1),
+              i1 = count_edges_below<0>(a_runs, a_count, rite);
+    if (isSect) {
+        if (i0 < i1) {
+            SkRegionPriv::RunType* first = dst;
+            dst = copy_intervals(dst, a_runs + 2*i0, i1 - i0);
+            first[0] = std::max(first[0], left);
+            dst[-1]  = std::min(dst[-1],  rite);
+        }
+        return dst;
+    }
+    dst = copy_intervals(dst, a_runs, i0);
+    if (i0 < i1) {
+        if (a_runs[2*i0] < left) {
+            *dst++ = a_runs[2*i0];
+            *dst++ = left;
+        }
+        if (a_runs[2*i1 - 1] > rite) {
+            *dst++ = rite;
+            *dst++ = a_runs[2*i1 - 1];
+        }
+    }
+    return copy_intervals(dst, a_runs + 2*i1, a_count - i1);
 }
 
 static int operate_on_span(const SkRegionPriv::RunType a_runs[],
                            const SkRegionPriv::RunType b_runs[],
                            RunArray* array, int dstOffset,
                            int min, int max) {
+    // Both spans are preceded by their interval counts.
+    const int a_count = a_runs[-1],
+              b_count = b_runs[-1];
+
     // This is a worst-case for this span plus two for TWO terminating sentinels.
-    array->resizeToAtLeast(
-            dstOffset + distance_to_sentinel(a_runs) + distance_to_sentinel(b_runs) + 2);
+    array->resizeToAtLeast(dstOffset + 2 * (a_count + b_count) + 2);
     SkRegionPriv::RunType* dst = &(*array)[dstOffset]; // get pointer AFTER resizing.
 
+    if (SkRegionPriv::RunType* end = operate_on_simple_span(a_runs, a_count, b_runs, b_count,
+                                                            dst, min, max)) {
+        *end++ = SkRegion_kRunTypeSentinel;
+        return end - &(*array)[0];
+    }
+
     spanRec rec;
     bool    firstInterval = true;
 
@@ -898,7 +1074,7 @@ static int operate(const SkRegionPriv::RunType a_runs[],
                    bool quickExit) {
     const SkRegionPriv::RunType gEmptyScanline[] = {
         0,  // fake bottom value
-        0,  // zero intervals
+        0,  // zero intervals: operate_on_span() reads this as gSentinel[-1]
         SkRegion_kRunTypeSentinel,
         // just need a 2nd value, since spanRec.init() reads 2 values, even
         // though if the first value is the sentinel, it ignores the 2nd value.
@@ -917,7 +1093,10 @@ static int operate(const SkRegionPriv::RunType a_runs[],
     a_runs += 1;    // skip the intervalCount;
     b_runs += 1;    // skip the intervalCount;
 
-    // Now a_runs and b_runs to their intervals (or sentinel)
+    // Now a_runs and b_runs point to their intervals (or sentinel). operate_on_span() reads the
+    // interval count just before each span it is given, so this relies on every stored region
+    // writing its interval counts (computeRunBounds() asserts they are right, and BuildRectRuns()
+    // writes 1), and on gSentinel[-1] being 0.
 
     assert_sentinel(a_top, false);
     assert_sentinel(a_bot, false);
@@ -981,7 +1160,7 @@ static int operate(const SkRegionPriv::RunType a_runs[],
             a_runs = skip_intervals(a_runs);
             a_top = a_bot;
             a_bot = *a_runs++;
-            a_runs += 1;    // skip uninitialized intervalCount
+            a_runs += 1;    // skip intervalCount, which is read back as a_runs[-1]
             if (a_bot == SkRegion_kRunTypeSentinel) {
                 a_top = a_bot;
             }
@@ -990,7 +1169,7 @@ static int operate(const SkRegionPriv::RunType a_runs[],
             b_runs = skip_intervals(b_runs);
             b_top = b_bot;
             b_bot = *b_runs++;
-            b_runs += 1;    // skip uninitialized intervalCount
+            b_runs += 1;    // skip intervalCount, which is read back as b_runs[-1]
             if (b_bot == SkRegion_kRunTypeSentinel) {
                 b_top = b_bot;
             }
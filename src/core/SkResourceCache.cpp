@@ -17,7 +17,9 @@
 #include "src/core/SkOpts.h"
 #include "src/core/SkRecordReplay.h"
 
+#include <atomic>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 DECLARE_SKMESSAGEBUS_MESSAGE(SkResourceCache::PurgeSharedIDMessage, uint32_t, true)
@@ -229,9 +231,17 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
         byteLimit = fTotalByteLimit;
     }
 
+    if (forcePurge) {
+        byteLimit = 0;
+        countLimit = 0;
+    }
+    this->purgeToLimits(byteLimit, countLimit);
+}
+
+void SkResourceCache::purgeToLimits(size_t byteLimit, int countLimit) {
     Rec* rec = fTail;
     while (rec) {
-        if (!forcePurge && fTotalBytesUsed < byteLimit && fCount < countLimit) {
+        if (fTotalBytesUsed < byteLimit && fCount < countLimit) {
             break;
         }
 
@@ -315,17 +325,21 @@ size_t SkResourceCache::setTotalByteLimit(size_t newLimit) {
     return prevLimit;
 }
 
-SkCachedData* SkResourceCache::newCachedData(size_t bytes) {
-    this->checkMessages();
-
-    if (fDiscardableFactory) {
-        SkDiscardableMemory* dm = fDiscardableFactory(bytes);
+static SkCachedData* new_cached_data(SkResourceCache::DiscardableFactory factory,
+                                     size_t bytes) {
+    if (factory) {
+        SkDiscardableMemory* dm = factory(bytes);
         return dm ? new SkCachedData(bytes, dm) : nullptr;
     } else {
         return new SkCachedData(sk_malloc_throw(bytes), bytes);
     }
 }
 
+SkCachedData* SkResourceCache::newCachedData(size_t bytes) {
+    this->checkMessages();
+    return new_cached_data(fDiscardableFactory, bytes);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void SkResourceCache::release(Rec* rec) {
@@ -477,95 +491,269 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static SkResourceCache* gResourceCache = nullptr;
-static SkMutex& resource_cache_mutex() {
-    static SkMutex& mutex = *(new SkMutex("SkResourceCache"));
-    return mutex;
+/**
+ *  The global cache is kShardCount independent caches, each behind its own mutex, picked by the
+ *  high bits of the key's hash (the shards' hash tables use the low bits). The shards have no
+ *  budget of their own: their sizes are summed into atomics here, and whichever thread finds the
+ *  sum over budget purges from the tail of each shard in turn.
+ */
+class SkResourceCache::Sharded {
+public:
+    explicit Sharded(DiscardableFactory factory) : fDiscardableFactory(factory) {}
+    explicit Sharded(size_t byteLimit) : fTotalByteLimit(byteLimit) {}
+
+    bool find(const Key& key, FindVisitor visitor, void* context) {
+        bool found = false;
+        this->withShard(&this->shardFor(key), [&](SkResourceCache* cache) {
+            found = cache->find(key, visitor, context);
+        });
+        return found;
+    }
+
+    void add(Rec* rec, void* payload) {
+        this->withShard(&this->shardFor(rec->getKey()), [&](SkResourceCache* cache) {
+            cache->add(rec, payload);
+        });
+        // since the new rec may push us over-budget, we perform a purge check now
+        this->purgeAsNeeded();
+    }
+
+    void visitAll(Visitor visitor, void* context) {
+        for (Shard& shard : fShards) {
+            SkAutoMutexExclusive am(shard.fMutex);
+            shard.fCache.visitAll(visitor, context);
+        }
+    }
+
+    size_t getTotalBytesUsed() const { return fTotalBytesUsed.load(std::memory_order_relaxed); }
+    size_t getTotalByteLimit() const { return fTotalByteLimit.load(std::memory_order_relaxed); }
+
+    size_t setTotalByteLimit(size_t newLimit) {
+        size_t prevLimit = fTotalByteLimit.exchange(newLimit, std::memory_order_relaxed);
+        if (newLimit < prevLimit) {
+            this->purgeAsNeeded();
+        }
+        return prevLimit;
+    }
+
+    size_t setSingleAllocationByteLimit(size_t newLimit) {
+        return fSingleAllocationByteLimit.exchange(newLimit, std::memory_order_relaxed);
+    }
+
+    size_t getSingleAllocationByteLimit() const {
+        return fSingleAllocationByteLimit.load(std::memory_order_relaxed);
+    }
+
+    size_t getEffectiveSingleAllocationByteLimit() const {
+        // fSingleAllocationByteLimit == 0 means the caller is asking for our default
+        size_t limit = this->getSingleAllocationByteLimit();
+
+        // if we're not discardable (i.e. we are fixed-budget) then cap the single-limit
+        // to our budget.
+        if (nullptr == fDiscardableFactory) {
+            if (0 == limit) {
+                limit = this->getTotalByteLimit();
+            } else {
+                limit = std::min(limit, this->getTotalByteLimit());
+            }
+        }
+        return limit;
+    }
+
+    DiscardableFactory discardableFactory() const { return fDiscardableFactory; }
+
+    SkCachedData* newCachedData(size_t bytes) {
+        return new_cached_data(fDiscardableFactory, bytes);
+    }
+
+    void purgeAll() { this->purgeAsNeeded(true); }
+
+    void checkMessages() {
+        for (Shard& shard : fShards) {
+            this->withShard(&shard, [](SkResourceCache* cache) { cache->checkMessages(); });
+        }
+    }
+
+    void dump() {
+        for (Shard& shard : fShards) {
+            SkAutoMutexExclusive am(shard.fMutex);
+            shard.fCache.validate();
+        }
+        SkDebugf("SkResourceCache: count=%d bytes=%zu %s\n",
+                 fCount.load(std::memory_order_relaxed), this->getTotalBytesUsed(),
+                 fDiscardableFactory ? "discardable" : "malloc");
+    }
+
+private:
+    static constexpr int kShardBits = 4;
+    static constexpr int kShardCount = 1 << kShardBits;
+
+    struct Shard {
+        SkMutex fMutex{"SkResourceCache.Shard.fMutex"};
+        // Unbudgeted, so it never purges on its own; see purgeAsNeeded().
+        SkResourceCache fCache{SIZE_MAX};
+    };
+
+    Shard& shardFor(const Key& key) { return fShards[key.hash() >> (32 - kShardBits)]; }
+
+    // Calls fn with the shard's cache while holding its mutex, then folds whatever the shard
+    // gained or lost (adds, purges, stale recs, purged shared IDs) into the totals.
+    template <typename Fn> void withShard(Shard* shard, Fn&& fn) {
+        SkAutoMutexExclusive am(shard->fMutex);
+        SkResourceCache* cache = &shard->fCache;
+        const size_t bytesBefore = cache->fTotalBytesUsed;
+        const int countBefore = cache->fCount;
+
+        fn(cache);
+
+        // Unsigned wrap-around turns a shrinking shard into a subtraction.
+        fTotalBytesUsed.fetch_add(cache->fTotalBytesUsed - bytesBefore, std::memory_order_relaxed);
+        fCount.fetch_add(cache->fCount - countBefore, std::memory_order_relaxed);
+    }
+
+    void purgeAsNeeded(bool forcePurge = false);
+
+    const DiscardableFactory fDiscardableFactory = nullptr;
+
+    std::atomic<size_t> fTotalBytesUsed{0};
+    std::atomic<int>    fCount{0};
+    std::atomic<size_t> fTotalByteLimit{0};
+    std::atomic<size_t> fSingleAllocationByteLimit{0};
+
+    // Only one over-budget purge runs at a time; fNextPurgeShard belongs to whoever runs it.
+    std::atomic<bool>   fPurging{false};
+    int                 fNextPurgeShard = 0;
+
+    Shard fShards[kShardCount];
+};
+
+void SkResourceCache::Sharded::purgeAsNeeded(bool forcePurge) {
+    if (forcePurge) {
+        for (Shard& shard : fShards) {
+            this->withShard(&shard, [](SkResourceCache* cache) { cache->purgeAll(); });
+        }
+        return;
+    }
+
+    size_t byteLimit;
+    int    countLimit;
+
+    if (fDiscardableFactory) {
+        countLimit = SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT;
+        byteLimit = UINT32_MAX;  // no limit based on bytes
+    } else {
+        countLimit = SK_MaxS32; // no limit based on count
+        byteLimit = this->getTotalByteLimit();
+    }
+
+    auto underBudget = [&](size_t bytesUsed, int count) {
+        return bytesUsed < byteLimit && count < countLimit;
+    };
+    if (underBudget(this->getTotalBytesUsed(), fCount.load(std::memory_order_relaxed))) {
+        return;
+    }
+
+    // If another thread is already bringing the cache back under budget, let it.
+    if (fPurging.exchange(true, std::memory_order_acquire)) {
+        return;
+    }
+
+    // Take recs from the tail of each shard in turn, so the purge is spread over the shards
+    // rather than emptying whichever is visited first. Each visit frees its share of what is
+    // still over budget, and at least one rec. Stop once a whole round frees nothing (i.e.
+    // every rec left is in use).
+    int shardIndex = fNextPurgeShard;
+    int idleShards = 0;
+    while (idleShards < kShardCount) {
+        const size_t bytesUsed = this->getTotalBytesUsed();
+        const int count = fCount.load(std::memory_order_relaxed);
+        if (underBudget(bytesUsed, count)) {
+            break;
+        }
+        const size_t bytesShare =
+                (bytesUsed >= byteLimit ? bytesUsed - byteLimit + 1 : 0) / kShardCount;
+        const int countShare = std::max((count >= countLimit ? count - countLimit + 1 : 0) /
+                                                kShardCount, 1);
+
+        bool freedAny = false;
+        this->withShard(&fShards[shardIndex], [&](SkResourceCache* cache) {
+            const int countBefore = cache->fCount;
+            cache->purgeToLimits(cache->fTotalBytesUsed + 1 -
+                                         std::min(bytesShare, cache->fTotalBytesUsed),
+                                 countBefore + 1 - countShare);
+            freedAny = cache->fCount < countBefore;
+        });
+        shardIndex = (shardIndex + 1) % kShardCount;
+        idleShards = freedAny ? 0 : idleShards + 1;
+    }
+    fNextPurgeShard = shardIndex;
+    fPurging.store(false, std::memory_order_release);
 }
 
-/** Must hold resource_cache_mutex() when calling. */
-static SkResourceCache* get_cache() {
-    // resource_cache_mutex() is always held when this is called, so we don't need to be fancy in here.
-    resource_cache_mutex().assertHeld();
-    if (nullptr == gResourceCache) {
+SkResourceCache::Sharded& SkResourceCache::Global() {
+    static Sharded* gResourceCache =
 #ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
+            new Sharded(SkDiscardableMemory::Create);
 #else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+            new Sharded(SK_DEFAULT_IMAGE_CACHE_LIMIT);
 #endif
-    }
-    return gResourceCache;
+    return *gResourceCache;
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getTotalBytesUsed();
+    return Global().getTotalBytesUsed();
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getTotalByteLimit();
+    return Global().getTotalByteLimit();
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->setTotalByteLimit(newLimit);
+    return Global().setTotalByteLimit(newLimit);
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->discardableFactory();
+    return Global().discardableFactory();
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->newCachedData(bytes);
+    return Global().newCachedData(bytes);
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->dump();
+    Global().dump();
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->setSingleAllocationByteLimit(size);
+    return Global().setSingleAllocationByteLimit(size);
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getSingleAllocationByteLimit();
+    return Global().getSingleAllocationByteLimit();
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getEffectiveSingleAllocationByteLimit();
+    return Global().getEffectiveSingleAllocationByteLimit();
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->purgeAll();
+    Global().purgeAll();
 }
 
 void SkResourceCache::CheckMessages() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->checkMessages();
+    Global().checkMessages();
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    bool rv = get_cache()->find(key, visitor, context);
-    return rv;
+    return Global().find(key, visitor, context);
 }
 
 void SkResourceCache::Add(Rec* rec, void* payload) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->add(rec, payload);
+    Global().add(rec, payload);
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->visitAll(visitor, context);
+    Global().visitAll(visitor, context);
 }
 
 void SkResourceCache::PostPurgeSharedID(uint64_t sharedID) {
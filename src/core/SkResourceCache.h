@@ -25,6 +25,10 @@ class SkTraceMemoryDump;
  *
  *  As a convenience, a global instance is also defined, which can be safely
  *  access across threads via the static methods (e.g. FindAndLock, etc.).
+ *  The global instance is split into shards chosen by the key's hash, each with
+ *  its own lock and LRU list, so threads looking up different keys rarely contend.
+ *  Its budget is enforced across all the shards, but only approximately: purging
+ *  takes the least recently used entries of each shard in turn, not globally.
  */
 class SkResourceCache {
 public:
@@ -258,6 +262,9 @@ public:
     void dump() const;
 
 private:
+    class Sharded;
+    static Sharded& Global();
+
     Rec*    fHead;
     Rec*    fTail;
 
@@ -275,6 +282,8 @@ private:
 
     void checkMessages();
     void purgeAsNeeded(bool forcePurge = false);
+    // Removes purgeable recs from the tail until bytes used and count are under these limits.
+    void purgeToLimits(size_t byteLimit, int countLimit);
 
     // linklist management
     void moveToHead(Rec*);
@@ -10,6 +10,7 @@
 #include "include/core/SkCapabilities.h"
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkData.h"
+#include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
 #include "include/private/SkMutex.h"
 #include "include/sksl/DSLCore.h"
@@ -53,6 +54,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 
 #if defined(SK_BUILD_FOR_DEBUGGER)
     #define SK_LENIENT_SKSL_DESERIALIZATION 1
@@ -184,7 +186,7 @@ bool SkRuntimeEffectPriv::CanDraw(const SkCapabilities* caps, const SkSL::Progra
 
 bool SkRuntimeEffectPriv::CanDraw(const SkCapabilities* caps, const SkRuntimeEffect* effect) {
     SkASSERT(effect);
-    return CanDraw(caps, effect->fBaseProgram.get());
+    return CanDraw(caps, &effect->program());
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -327,9 +329,230 @@ SkSL::ProgramSettings SkRuntimeEffect::MakeSettings(const Options& options) {
 // in the IR generator would provide better errors messages (with locations).
 #define RETURN_FAILURE(...) return Result{nullptr, SkStringPrintf(__VA_ARGS__)}
 
+static std::atomic<SkRuntimeEffect::PersistentCache*> gPersistentCache{nullptr};
+
+void SkRuntimeEffect::SetPersistentCache(PersistentCache* cache) {
+    gPersistentCache.store(cache, std::memory_order_relaxed);
+}
+
+// Persistent cache entries hold the interface of the effect (see InterfaceData()), after a checksum
+// of it. That is all an effect needs until it is drawn, when its program is compiled.
+// (Bump the version when the format, or the interface the compiler finds for some SkSL, changes.)
+static constexpr char     kPersistentCacheTag[]   = "SkRuntimeEffect";
+static constexpr uint32_t kPersistentCacheVersion = 3;
+
+static sk_sp<SkData> make_cache_data(const SkData& interface) {
+    SkDynamicMemoryWStream stream;
+    stream.write(kPersistentCacheTag, sizeof(kPersistentCacheTag));
+    stream.write32(kPersistentCacheVersion);
+    stream.write32(SkOpts::hash_fn(interface.data(), interface.size(), 0));
+    stream.write(interface.data(), interface.size());
+    return stream.detachAsData();
+}
+
+// Returns the interface stored in a cache entry, or null if the entry is not usable.
+static sk_sp<SkData> read_cache_data(const SkData& data) {
+    constexpr size_t kHeaderSize = sizeof(kPersistentCacheTag) + 2 * sizeof(uint32_t);
+    const auto* bytes = data.bytes();
+    uint32_t version, checksum;
+    if (data.size() < kHeaderSize ||
+        memcmp(bytes, kPersistentCacheTag, sizeof(kPersistentCacheTag))) {
+        return nullptr;
+    }
+    memcpy(&version, bytes + sizeof(kPersistentCacheTag), sizeof(version));
+    memcpy(&checksum, bytes + sizeof(kPersistentCacheTag) + sizeof(version), sizeof(checksum));
+    const size_t interfaceSize = data.size() - kHeaderSize;
+    if (version != kPersistentCacheVersion ||
+        checksum != SkOpts::hash_fn(bytes + kHeaderSize, interfaceSize, 0)) {
+        return nullptr;
+    }
+    return SkData::MakeWithCopy(bytes + kHeaderSize, interfaceSize);
+}
+
+sk_sp<SkData> SkRuntimeEffectPriv::InterfaceData(const SkRuntimeEffect& effect) {
+    SkDynamicMemoryWStream stream;
+    auto writeName = [&](std::string_view name) {
+        stream.writePackedUInt(name.size());
+        stream.write(name.data(), name.size());
+    };
+    stream.write32(effect.fFlags);
+    stream.writePackedUInt(effect.fUniforms.size());
+    for (const SkRuntimeEffect::Uniform& uniform : effect.fUniforms) {
+        writeName(uniform.name);
+        stream.write32(SkToU32(uniform.offset));
+        stream.write32(static_cast<uint32_t>(uniform.type));
+        stream.write32(uniform.count);
+        stream.write32(uniform.flags);
+    }
+    stream.writePackedUInt(effect.fChildren.size());
+    for (const SkRuntimeEffect::Child& child : effect.fChildren) {
+        writeName(child.name);
+        stream.write32(static_cast<uint32_t>(child.type));
+        stream.write32(child.index);
+    }
+    stream.writePackedUInt(effect.fSampleUsages.size());
+    for (const SkSL::SampleUsage& usage : effect.fSampleUsages) {
+        stream.write8(static_cast<uint8_t>(usage.kind()));
+        stream.writeBool(usage.hasPerspective());
+    }
+    return stream.detachAsData();
+}
+
+struct SkRuntimeEffect::CachedProgram {
+    std::string        fSource;
+    sk_sp<SkData>      fInterface;  // the names of the effect's uniforms and children point into this
+    SkSL::ProgramKind  fKind;
+    Options            fOptions;
+};
+
+// Rebuilds an effect from the interface in a persistent cache entry, without compiling anything.
+sk_sp<SkRuntimeEffect> SkRuntimeEffect::MakeFromCacheEntry(const SkData& data,
+                                                           SkString sksl,
+                                                           const Options& options,
+                                                           SkSL::ProgramKind kind) {
+    sk_sp<SkData> interface = read_cache_data(data);
+    if (!interface) {
+        return nullptr;
+    }
+
+    // This reads what SkRuntimeEffectPriv::InterfaceData() writes.
+    SkMemoryStream stream(interface);
+    auto readName = [&](std::string_view* name) {
+        size_t size;
+        if (!stream.readPackedUInt(&size) || size > stream.getLength() - stream.getPosition()) {
+            return false;
+        }
+        *name = std::string_view(static_cast<const char*>(stream.getAtPos()), size);
+        return stream.skip(size) == size;
+    };
+
+    uint32_t flags;
+    size_t count;
+    if (!stream.readU32(&flags) || !stream.readPackedUInt(&count)) {
+        return nullptr;
+    }
+    std::vector<Uniform> uniforms;
+    size_t uniformEnd = 0;
+    for (size_t i = 0; i < count; ++i) {
+        Uniform uniform;
+        uint32_t offset, type, arrayCount;
+        if (!readName(&uniform.name) || !stream.readU32(&offset) || !stream.readU32(&type) ||
+            !stream.readU32(&arrayCount) || !stream.readU32(&uniform.flags) ||
+            type > static_cast<uint32_t>(Uniform::Type::kInt4) || offset < uniformEnd ||
+            arrayCount < 1 || arrayCount > SK_MaxS32) {
+            return nullptr;
+        }
+        uniform.offset = offset;
+        uniform.type   = static_cast<Uniform::Type>(type);
+        uniform.count  = SkToInt(arrayCount);
+        uniformEnd = uniform.offset + uniform.sizeInBytes();
+        uniforms.push_back(uniform);
+    }
+
+    if (!stream.readPackedUInt(&count)) {
+        return nullptr;
+    }
+    std::vector<Child> children;
+    for (size_t i = 0; i < count; ++i) {
+        Child child;
+        uint32_t type, index;
+        if (!readName(&child.name) || !stream.readU32(&type) || !stream.readU32(&index) ||
+            type > static_cast<uint32_t>(ChildType::kBlender) || index != i) {
+            return nullptr;
+        }
+        child.type  = static_cast<ChildType>(type);
+        child.index = SkToInt(index);
+        children.push_back(child);
+    }
+
+    std::vector<SkSL::SampleUsage> sampleUsages;
+    if (!stream.readPackedUInt(&count) || count != children.size()) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t usageKind;
+        bool hasPerspective;
+        if (!stream.readU8(&usageKind) || !stream.readBool(&hasPerspective) ||
+            usageKind > static_cast<uint8_t>(SkSL::SampleUsage::Kind::kExplicit)) {
+            return nullptr;
+        }
+        sampleUsages.emplace_back(static_cast<SkSL::SampleUsage::Kind>(usageKind), hasPerspective);
+    }
+    if (!stream.isAtEnd()) {
+        return nullptr;
+    }
+
+    auto cached = std::make_unique<CachedProgram>();
+    cached->fSource.assign(sksl.c_str(), sksl.size());
+    cached->fInterface = std::move(interface);
+    cached->fKind      = kind;
+    cached->fOptions   = options;
+    return sk_sp<SkRuntimeEffect>(new SkRuntimeEffect(std::move(cached),
+                                                      options,
+                                                      std::move(uniforms),
+                                                      std::move(children),
+                                                      std::move(sampleUsages),
+                                                      flags));
+}
+
+void SkRuntimeEffect::compileCachedProgram() const {
+    SkASSERT(fCached && !fBaseProgram);
+    SkSL::Compiler compiler(SkSL::ShaderCapsFactory::Standalone());
+    std::unique_ptr<SkSL::Program> program = compiler.convertProgram(
+            fCached->fKind, fCached->fSource, MakeSettings(fCached->fOptions));
+    sk_sp<SkRuntimeEffect> compiled =
+            program ? MakeInternal(std::move(program), fCached->fOptions, fCached->fKind).effect
+                    : nullptr;
+    // The entry passed its checksum, and was stored for this source. So the compiler must have
+    // changed what it finds in the source without a bump of kPersistentCacheVersion.
+    if (!compiled ||
+        !SkRuntimeEffectPriv::InterfaceData(*compiled)->equals(fCached->fInterface.get())) {
+        SK_ABORT("runtime effect does not match its persistent cache entry");
+    }
+
+    fBaseProgram = std::move(compiled->fBaseProgram);
+    fMain = compiled->fMain;
+    fFilterColorProgram = std::move(compiled->fFilterColorProgram);
+}
+
+const SkSL::Program& SkRuntimeEffect::program() const {
+    if (fCached) {
+        fCompileOnce([this] { this->compileCachedProgram(); });
+    }
+    return *fBaseProgram;
+}
+
+const SkSL::FunctionDefinition& SkRuntimeEffect::main() const {
+    this->program();
+    return *fMain;
+}
+
 SkRuntimeEffect::Result SkRuntimeEffect::MakeFromSource(SkString sksl,
                                                         const Options& options,
                                                         SkSL::ProgramKind kind) {
+    // Unoptimized effects are only made for testing and debugging; they are not worth caching.
+    PersistentCache* persistentCache = options.forceUnoptimized
+            ? nullptr
+            : gPersistentCache.load(std::memory_order_relaxed);
+    sk_sp<SkData> cacheKey;
+    if (persistentCache) {
+        SkDynamicMemoryWStream key;
+        key.write(kPersistentCacheTag, sizeof(kPersistentCacheTag));
+        key.write32(kPersistentCacheVersion);
+        key.write32(static_cast<uint32_t>(kind));
+        key.write32(static_cast<uint32_t>(options.maxVersionAllowed));
+        key.writeBool(options.usePrivateRTShaderModule);
+        key.write(sksl.c_str(), sksl.size());
+        cacheKey = key.detachAsData();
+
+        if (sk_sp<SkData> data = persistentCache->load(*cacheKey)) {
+            if (sk_sp<SkRuntimeEffect> effect = MakeFromCacheEntry(*data, sksl, options, kind)) {
+                return Result{std::move(effect), SkString()};
+            }
+            // Stale, foreign or corrupt data: compile from source, and replace it.
+        }
+    }
+
     SkSL::Compiler compiler(SkSL::ShaderCapsFactory::Standalone());
     SkSL::ProgramSettings settings = MakeSettings(options);
     std::unique_ptr<SkSL::Program> program =
@@ -339,7 +562,14 @@ SkRuntimeEffect::Result SkRuntimeEffect::MakeFromSource(SkString sksl,
         RETURN_FAILURE("%s", compiler.errorText().c_str());
     }
 
-    return MakeInternal(std::move(program), options, kind);
+    Result result = MakeInternal(std::move(program), options, kind);
+
+    if (persistentCache && result.effect) {
+        persistentCache->store(*cacheKey,
+                               *make_cache_data(*SkRuntimeEffectPriv::InterfaceData(*result.effect)));
+    }
+
+    return result;
 }
 
 SkRuntimeEffect::Result SkRuntimeEffect::MakeInternal(std::unique_ptr<SkSL::Program> program,
@@ -474,7 +704,7 @@ sk_sp<SkRuntimeEffect> SkRuntimeEffect::makeUnoptimizedClone() {
     options.usePrivateRTShaderModule = true;
 
     // We do know the original ProgramKind, so we don't need to re-derive it.
-    SkSL::ProgramKind kind = fBaseProgram->fConfig->fKind;
+    SkSL::ProgramKind kind = this->program().fConfig->fKind;
 
     // Attempt to recompile the program's source with optimizations off. This ensures that the
     // Debugger shows results on every line, even for things that could be optimized away (static
@@ -482,7 +712,7 @@ sk_sp<SkRuntimeEffect> SkRuntimeEffect::makeUnoptimizedClone() {
     SkSL::Compiler compiler(SkSL::ShaderCapsFactory::Standalone());
     SkSL::ProgramSettings settings = MakeSettings(options);
     std::unique_ptr<SkSL::Program> program =
-            compiler.convertProgram(kind, *fBaseProgram->fSource, settings);
+            compiler.convertProgram(kind, this->source(), settings);
 
     if (!program) {
         // Turning off compiler optimizations can theoretically expose a program error that
@@ -589,6 +819,26 @@ size_t SkRuntimeEffect::Uniform::sizeInBytes() const {
     return uniform_element_size(this->type) * this->count;
 }
 
+uint32_t SkRuntimeEffect::ComputeHash(const std::string& source, const Options& options) {
+    // Everything from SkRuntimeEffect::Options which could influence the compiled result needs to
+    // be accounted for in the hash. If you've added a new field to Options and caused the static-
+    // assert below to trigger, please incorporate your field into the hash and update KnownOptions
+    // to match the layout of Options.
+    struct KnownOptions {
+        bool forceUnoptimized, usePrivateRTShaderModule;
+        SkSL::Version maxVersionAllowed;
+    };
+    static_assert(sizeof(Options) == sizeof(KnownOptions));
+    uint32_t hash = SkOpts::hash_fn(source.c_str(), source.size(), 0);
+    hash = SkOpts::hash_fn(&options.forceUnoptimized,
+                           sizeof(options.forceUnoptimized), hash);
+    hash = SkOpts::hash_fn(&options.usePrivateRTShaderModule,
+                           sizeof(options.usePrivateRTShaderModule), hash);
+    hash = SkOpts::hash_fn(&options.maxVersionAllowed,
+                           sizeof(options.maxVersionAllowed), hash);
+    return hash;
+}
+
 SkRuntimeEffect::SkRuntimeEffect(std::unique_ptr<SkSL::Program> baseProgram,
                                  const Options& options,
                                  const SkSL::FunctionDefinition& main,
@@ -596,9 +846,9 @@ SkRuntimeEffect::SkRuntimeEffect(std::unique_ptr<SkSL::Program> baseProgram,
                                  std::vector<Child>&& children,
                                  std::vector<SkSL::SampleUsage>&& sampleUsages,
                                  uint32_t flags)
-        : fHash(SkOpts::hash_fn(baseProgram->fSource->c_str(), baseProgram->fSource->size(), 0))
+        : fHash(ComputeHash(*baseProgram->fSource, options))
         , fBaseProgram(std::move(baseProgram))
-        , fMain(main)
+        , fMain(&main)
         , fUniforms(std::move(uniforms))
         , fChildren(std::move(children))
         , fSampleUsages(std::move(sampleUsages))
@@ -606,29 +856,30 @@ SkRuntimeEffect::SkRuntimeEffect(std::unique_ptr<SkSL::Program> baseProgram,
     SkASSERT(fBaseProgram);
     SkASSERT(fChildren.size() == fSampleUsages.size());
 
-    // Everything from SkRuntimeEffect::Options which could influence the compiled result needs to
-    // be accounted for in `fHash`. If you've added a new field to Options and caused the static-
-    // assert below to trigger, please incorporate your field into `fHash` and update KnownOptions
-    // to match the layout of Options.
-    struct KnownOptions {
-        bool forceUnoptimized, usePrivateRTShaderModule;
-        SkSL::Version maxVersionAllowed;
-    };
-    static_assert(sizeof(Options) == sizeof(KnownOptions));
-    fHash = SkOpts::hash_fn(&options.forceUnoptimized,
-                      sizeof(options.forceUnoptimized), fHash);
-    fHash = SkOpts::hash_fn(&options.usePrivateRTShaderModule,
-                      sizeof(options.usePrivateRTShaderModule), fHash);
-    fHash = SkOpts::hash_fn(&options.maxVersionAllowed,
-                      sizeof(options.maxVersionAllowed), fHash);
-
     fFilterColorProgram = SkFilterColorProgram::Make(this);
 }
 
+SkRuntimeEffect::SkRuntimeEffect(std::unique_ptr<CachedProgram> cached,
+                                 const Options& options,
+                                 std::vector<Uniform>&& uniforms,
+                                 std::vector<Child>&& children,
+                                 std::vector<SkSL::SampleUsage>&& sampleUsages,
+                                 uint32_t flags)
+        : fHash(ComputeHash(cached->fSource, options))
+        , fCached(std::move(cached))
+        , fMain(nullptr)
+        , fUniforms(std::move(uniforms))
+        , fChildren(std::move(children))
+        , fSampleUsages(std::move(sampleUsages))
+        , fFlags(flags) {
+    SkASSERT(fChildren.size() == fSampleUsages.size());
+}
+
 SkRuntimeEffect::~SkRuntimeEffect() = default;
 
 const std::string& SkRuntimeEffect::source() const {
-    return *fBaseProgram->fSource;
+    // Cached effects might not have compiled their program yet; they keep their own copy.
+    return fCached ? fCached->fSource : *fBaseProgram->fSource;
 }
 
 size_t SkRuntimeEffect::uniformSize() const {
@@ -795,7 +1046,7 @@ std::unique_ptr<SkFilterColorProgram> SkFilterColorProgram::Make(const SkRuntime
     // Emit the skvm instructions for the SkSL
     skvm::Coord zeroCoord = {p.splat(0.0f), p.splat(0.0f)};
     skvm::Color result = SkSL::ProgramToSkVM(*effect->fBaseProgram,
-                                             effect->fMain,
+                                             *effect->fMain,
                                              &p,
                                              /*debugTrace=*/nullptr,
                                              SkSpan(uniform),
@@ -860,6 +1111,7 @@ SkPMColor4f SkFilterColorProgram::eval(
 }
 
 const SkFilterColorProgram* SkRuntimeEffect::getFilterColorProgram() const {
+    this->program();  // Effects made from a persistent cache entry make this with their program.
     return fFilterColorProgram.get();
 }
 
@@ -1089,7 +1341,7 @@ public:
         // There should be no way for the color filter to use device coords, but we need to supply
         // something. (Uninitialized values can trigger asserts in skvm::Builder).
         skvm::Coord zeroCoord = { p->splat(0.0f), p->splat(0.0f) };
-        return SkSL::ProgramToSkVM(*fEffect->fBaseProgram, fEffect->fMain, p,/*debugTrace=*/nullptr,
+        return SkSL::ProgramToSkVM(fEffect->program(), fEffect->main(), p,/*debugTrace=*/nullptr,
                                    SkSpan(uniform), /*device=*/zeroCoord, /*local=*/zeroCoord,
                                    c, c, &callbacks);
     }
@@ -1270,7 +1522,7 @@ public:
         std::vector<skvm::Val> uniform = make_skvm_uniforms(p, uniforms, fEffect->uniformSize(),
                                                             *inputs);
 
-        return SkSL::ProgramToSkVM(*fEffect->fBaseProgram, fEffect->fMain, p, fDebugTrace.get(),
+        return SkSL::ProgramToSkVM(fEffect->program(), fEffect->main(), p, fDebugTrace.get(),
                                    SkSpan(uniform), device, local, paint, paint, &callbacks);
     }
 
@@ -1371,7 +1623,7 @@ public:
 
         // Emit the blend function as an SkVM program.
         skvm::Coord zeroCoord = {p->splat(0.0f), p->splat(0.0f)};
-        return SkSL::ProgramToSkVM(*fEffect->fBaseProgram, fEffect->fMain, p,/*debugTrace=*/nullptr,
+        return SkSL::ProgramToSkVM(fEffect->program(), fEffect->main(), p,/*debugTrace=*/nullptr,
                                    SkSpan(uniform), /*device=*/zeroCoord, /*local=*/zeroCoord,
                                    src, dst, &callbacks);
     }
@@ -38,7 +38,7 @@ public:
     }
 
     static const SkSL::Program& Program(const SkRuntimeEffect& effect) {
-        return *effect.fBaseProgram;
+        return effect.program();
     }
 
     static SkRuntimeEffect::Options ES3Options() {
@@ -64,6 +64,10 @@ public:
                                                  sk_sp<const SkData> originalData,
                                                  const SkColorSpace* dstCS);
 
+    // Serializes the flags, uniforms, children and sampling of an effect. This is what persistent
+    // cache entries store, and all an effect made from one has until its program is compiled.
+    static sk_sp<SkData> InterfaceData(const SkRuntimeEffect&);
+
     static bool CanDraw(const SkCapabilities*, const SkSL::Program*);
     static bool CanDraw(const SkCapabilities*, const SkRuntimeEffect*);
 };
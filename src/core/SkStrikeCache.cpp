@@ -35,14 +35,18 @@ SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
 }
 
 auto SkStrikeCache::findOrCreateStrike(const SkStrikeSpec& strikeSpec) -> sk_sp<SkStrike> {
-    SkAutoMutexExclusive ac(fLock);
-    sk_sp<SkStrike> strike = this->internalFindStrikeOrNull(strikeSpec.descriptor());
+    Shard* shard = &this->shardFor(strikeSpec.descriptor());
+    sk_sp<SkStrike> strike;
+    {
+        SkAutoMutexExclusive ac(shard->fLock);
+        strike = this->internalFindStrikeOrNull(shard, strikeSpec.descriptor());
 
-    // https://linear.app/replay/issue/RUN-845
-    SkRecordReplayAssert("SkStrikeCache::findOrCreateStrike #1 %u %d", strikeSpec.descriptor().getChecksum(), !!strike);
+        // https://linear.app/replay/issue/RUN-845
+        SkRecordReplayAssert("SkStrikeCache::findOrCreateStrike #1 %u %d", strikeSpec.descriptor().getChecksum(), !!strike);
 
-    if (strike == nullptr) {
-        strike = this->internalCreateStrike(strikeSpec);
+        if (strike == nullptr) {
+            strike = this->internalCreateStrike(shard, strikeSpec);
+        }
     }
     this->internalPurge();
     return strike;
@@ -122,34 +126,40 @@ void SkStrikeCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
 }
 
 sk_sp<SkStrike> SkStrikeCache::findStrike(const SkDescriptor& desc) {
-    SkAutoMutexExclusive ac(fLock);
-    sk_sp<SkStrike> result = this->internalFindStrikeOrNull(desc);
+    Shard* shard = &this->shardFor(desc);
+    sk_sp<SkStrike> result;
+    {
+        SkAutoMutexExclusive ac(shard->fLock);
+        result = this->internalFindStrikeOrNull(shard, desc);
+    }
     this->internalPurge();
     return result;
 }
 
-auto SkStrikeCache::internalFindStrikeOrNull(const SkDescriptor& desc) -> sk_sp<SkStrike> {
+auto SkStrikeCache::internalFindStrikeOrNull(Shard* shard, const SkDescriptor& desc)
+        -> sk_sp<SkStrike> {
+    SkStrike*& head = shard->fHead;
 
     // Check head because it is likely the strike we are looking for.
-    if (fHead != nullptr && fHead->getDescriptor() == desc) { return sk_ref_sp(fHead); }
+    if (head != nullptr && head->getDescriptor() == desc) { return sk_ref_sp(head); }
 
     // Do the heavy search looking for the strike.
-    sk_sp<SkStrike>* strikeHandle = fStrikeLookup.find(desc);
+    sk_sp<SkStrike>* strikeHandle = shard->fStrikeLookup.find(desc);
     if (strikeHandle == nullptr) { return nullptr; }
     SkStrike* strikePtr = strikeHandle->get();
     SkASSERT(strikePtr != nullptr);
-    if (fHead != strikePtr) {
+    if (head != strikePtr) {
         // Make most recently used
         strikePtr->fPrev->fNext = strikePtr->fNext;
         if (strikePtr->fNext != nullptr) {
             strikePtr->fNext->fPrev = strikePtr->fPrev;
         } else {
-            fTail = strikePtr->fPrev;
+            shard->fTail = strikePtr->fPrev;
         }
-        fHead->fPrev = strikePtr;
-        strikePtr->fNext = fHead;
+        head->fPrev = strikePtr;
+        strikePtr->fNext = head;
         strikePtr->fPrev = nullptr;
-        fHead = strikePtr;
+        head = strikePtr;
     }
     return sk_ref_sp(strikePtr);
 }
@@ -158,53 +168,47 @@ sk_sp<SkStrike> SkStrikeCache::createStrike(
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) {
-    SkAutoMutexExclusive ac(fLock);
-    return this->internalCreateStrike(strikeSpec, maybeMetrics, std::move(pinner));
+    Shard* shard = &this->shardFor(strikeSpec.descriptor());
+    SkAutoMutexExclusive ac(shard->fLock);
+    return this->internalCreateStrike(shard, strikeSpec, maybeMetrics, std::move(pinner));
 }
 
 auto SkStrikeCache::internalCreateStrike(
+        Shard* shard,
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) -> sk_sp<SkStrike> {
     std::unique_ptr<SkScalerContext> scaler = strikeSpec.createScalerContext();
     auto strike =
         sk_make_sp<SkStrike>(this, strikeSpec, std::move(scaler), maybeMetrics, std::move(pinner));
-    this->internalAttachToHead(strike);
+    this->internalAttachToHead(shard, strike);
     return strike;
 }
 
 void SkStrikeCache::purgeAll() {
-    SkAutoMutexExclusive ac(fLock);
-    this->internalPurge(fTotalMemoryUsed);
+    this->internalPurge(fTotalMemoryUsed.load(std::memory_order_relaxed));
 }
 
 size_t SkStrikeCache::getTotalMemoryUsed() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fTotalMemoryUsed;
+    return fTotalMemoryUsed.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::getCacheCountUsed() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fCacheCount;
+    return fCacheCount.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::getCacheCountLimit() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fCacheCountLimit;
+    return fCacheCountLimit.load(std::memory_order_relaxed);
 }
 
 size_t SkStrikeCache::setCacheSizeLimit(size_t newLimit) {
-    SkAutoMutexExclusive ac(fLock);
-
-    size_t prevLimit = fCacheSizeLimit;
-    fCacheSizeLimit = newLimit;
+    size_t prevLimit = fCacheSizeLimit.exchange(newLimit, std::memory_order_relaxed);
     this->internalPurge();
     return prevLimit;
 }
 
 size_t  SkStrikeCache::getCacheSizeLimit() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fCacheSizeLimit;
+    return fCacheSizeLimit.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::setCacheCountLimit(int newCount) {
@@ -212,66 +216,121 @@ int SkStrikeCache::setCacheCountLimit(int newCount) {
         newCount = 0;
     }
 
-    SkAutoMutexExclusive ac(fLock);
-
-    int prevCount = fCacheCountLimit;
-    fCacheCountLimit = newCount;
+    int prevCount = fCacheCountLimit.exchange(newCount, std::memory_order_relaxed);
     this->internalPurge();
     return prevCount;
 }
 
 void SkStrikeCache::forEachStrike(std::function<void(const SkStrike&)> visitor) const {
-    SkAutoMutexExclusive ac(fLock);
+    for (const Shard& shard : fShards) {
+        SkAutoMutexExclusive ac(shard.fLock);
 
-    this->validate();
+        this->validate(shard);
 
-    for (SkStrike* strike = fHead; strike != nullptr; strike = strike->fNext) {
-        visitor(*strike);
+        for (SkStrike* strike = shard.fHead; strike != nullptr; strike = strike->fNext) {
+            visitor(*strike);
+        }
     }
 }
 
 size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
-    size_t bytesNeeded = 0;
-    if (fTotalMemoryUsed > fCacheSizeLimit) {
-        bytesNeeded = fTotalMemoryUsed - fCacheSizeLimit;
-    }
-    bytesNeeded = std::max(bytesNeeded, minBytesNeeded);
-    if (bytesNeeded) {
-        // no small purges!
-        bytesNeeded = std::max(bytesNeeded, fTotalMemoryUsed >> 2);
-    }
+    size_t bytesFreed = 0;
+    for (;;) {
+        // Pairs with the fence after fPurging is cleared below: either this thread sees that the
+        // flag was cleared, or the purging thread sees the strikes this thread added.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const size_t totalMemoryUsed = fTotalMemoryUsed.load(std::memory_order_relaxed);
+        const int32_t cacheCount = fCacheCount.load(std::memory_order_relaxed);
+
+        size_t bytesNeeded = 0;
+        if (totalMemoryUsed > fCacheSizeLimit.load(std::memory_order_relaxed)) {
+            bytesNeeded = totalMemoryUsed - fCacheSizeLimit.load(std::memory_order_relaxed);
+        }
+        bytesNeeded = std::max(bytesNeeded, minBytesNeeded);
+        if (bytesNeeded) {
+            // no small purges!
+            bytesNeeded = std::max(bytesNeeded, totalMemoryUsed >> 2);
+        }
 
-    int countNeeded = 0;
-    if (fCacheCount > fCacheCountLimit) {
-        countNeeded = fCacheCount - fCacheCountLimit;
-        // no small purges!
-        countNeeded = std::max(countNeeded, fCacheCount >> 2);
-    }
+        int countNeeded = 0;
+        if (cacheCount > fCacheCountLimit.load(std::memory_order_relaxed)) {
+            countNeeded = cacheCount - fCacheCountLimit.load(std::memory_order_relaxed);
+            // no small purges!
+            countNeeded = std::max(countNeeded, cacheCount >> 2);
+        }
+
+        // early exit
+        if (!countNeeded && !bytesNeeded) {
+            return bytesFreed;
+        }
+
+        // An explicit purge (minBytesNeeded > 0) always runs. Otherwise, if another thread is
+        // already bringing the cache back under budget, let it. Only the purge which set fPurging
+        // may clear it.
+        const bool ownsPurge = !fPurging.exchange(true, std::memory_order_acquire);
+        if (!ownsPurge && minBytesNeeded == 0) {
+            return bytesFreed;
+        }
 
-    // early exit
-    if (!countNeeded && !bytesNeeded) {
-        return 0;
+        const size_t roundFreed = this->internalPurgeShards(bytesNeeded, countNeeded);
+        bytesFreed += roundFreed;
+        if (!ownsPurge) {
+            return bytesFreed;
+        }
+        fPurging.store(false, std::memory_order_release);
+
+        // Threads which went over budget while this purge ran left their purges to it, so check
+        // the budget again. Give up if everything left is pinned.
+        if (roundFreed == 0) {
+            return bytesFreed;
+        }
+        minBytesNeeded = 0;
     }
+}
 
+size_t SkStrikeCache::internalPurgeShards(size_t bytesNeeded, int countNeeded) {
     size_t  bytesFreed = 0;
     int     countFreed = 0;
 
-    // Start at the tail and proceed backwards deleting; the list is in LRU
-    // order, with unimportant entries at the tail.
-    SkStrike* strike = fTail;
-    while (strike != nullptr && (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
-        SkStrike* prev = strike->fPrev;
-
-        // Only delete if the strike is not pinned.
-        if (strike->fPinner == nullptr || strike->fPinner->canDelete()) {
-            bytesFreed += strike->fMemoryUsed;
-            countFreed += 1;
-            this->internalRemoveStrike(strike);
+    // Take strikes from the tail of each shard in turn; each list is in LRU order, with
+    // unimportant entries at the tail. Every visit frees a slice of what is still needed, so the
+    // purge is spread across the shards. Stop once a whole round frees nothing (all pinned).
+    int shardIndex = fNextPurgeShard.load(std::memory_order_relaxed);
+    int idleShards = 0;
+    while (idleShards < kShardCount && (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
+        Shard* shard = &fShards[shardIndex];
+        shardIndex = (shardIndex + 1) % kShardCount;
+
+        const size_t bytesTarget =
+                bytesFreed + (bytesNeeded > bytesFreed ? (bytesNeeded - bytesFreed) : 0) /
+                                     kShardCount;
+        const int countTarget =
+                countFreed + std::max(countNeeded - countFreed, 0) / kShardCount;
+
+        SkAutoMutexExclusive ac(shard->fLock);
+        bool freedAny = false;
+        SkStrike* strike = shard->fTail;
+        while (strike != nullptr) {
+            SkStrike* prev = strike->fPrev;
+
+            // Only delete if the strike is not pinned.
+            if (strike->fPinner == nullptr || strike->fPinner->canDelete()) {
+                bytesFreed += strike->fMemoryUsed;
+                countFreed += 1;
+                freedAny = true;
+                this->internalRemoveStrike(shard, strike);
+            }
+            strike = prev;
+
+            if (freedAny && bytesFreed >= bytesTarget && countFreed >= countTarget) {
+                break;
+            }
         }
-        strike = prev;
-    }
+        idleShards = freedAny ? 0 : idleShards + 1;
 
-    this->validate();
+        this->validate(*shard);
+    }
+    fNextPurgeShard.store(shardIndex, std::memory_order_relaxed);
 
 #ifdef SPEW_PURGE_STATUS
     if (countFreed) {
@@ -283,68 +342,72 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
     return bytesFreed;
 }
 
-void SkStrikeCache::internalAttachToHead(sk_sp<SkStrike> strike) {
-    SkASSERT(fStrikeLookup.find(strike->getDescriptor()) == nullptr);
+void SkStrikeCache::internalAttachToHead(Shard* shard, sk_sp<SkStrike> strike) {
+    SkASSERT(shard->fStrikeLookup.find(strike->getDescriptor()) == nullptr);
     SkStrike* strikePtr = strike.get();
-    fStrikeLookup.set(std::move(strike));
+    shard->fStrikeLookup.set(std::move(strike));
     SkASSERT(nullptr == strikePtr->fPrev && nullptr == strikePtr->fNext);
 
-    fCacheCount += 1;
-    fTotalMemoryUsed += strikePtr->fMemoryUsed;
+    shard->fCount += 1;
+    shard->fMemoryUsed += strikePtr->fMemoryUsed;
+    fCacheCount.fetch_add(1, std::memory_order_relaxed);
+    fTotalMemoryUsed.fetch_add(strikePtr->fMemoryUsed, std::memory_order_relaxed);
 
-    if (fHead != nullptr) {
-        fHead->fPrev = strikePtr;
-        strikePtr->fNext = fHead;
+    if (shard->fHead != nullptr) {
+        shard->fHead->fPrev = strikePtr;
+        strikePtr->fNext = shard->fHead;
     }
 
-    if (fTail == nullptr) {
-        fTail = strikePtr;
+    if (shard->fTail == nullptr) {
+        shard->fTail = strikePtr;
     }
 
-    fHead = strikePtr; // Transfer ownership of strike to the cache list.
+    shard->fHead = strikePtr; // Transfer ownership of strike to the cache list.
 }
 
-void SkStrikeCache::internalRemoveStrike(SkStrike* strike) {
-    SkASSERT(fCacheCount > 0);
-    fCacheCount -= 1;
-    fTotalMemoryUsed -= strike->fMemoryUsed;
+void SkStrikeCache::internalRemoveStrike(Shard* shard, SkStrike* strike) {
+    SkASSERT(shard->fCount > 0);
+    shard->fCount -= 1;
+    shard->fMemoryUsed -= strike->fMemoryUsed;
+    fCacheCount.fetch_sub(1, std::memory_order_relaxed);
+    fTotalMemoryUsed.fetch_sub(strike->fMemoryUsed, std::memory_order_relaxed);
 
     if (strike->fPrev) {
         strike->fPrev->fNext = strike->fNext;
     } else {
-        fHead = strike->fNext;
+        shard->fHead = strike->fNext;
     }
     if (strike->fNext) {
         strike->fNext->fPrev = strike->fPrev;
     } else {
-        fTail = strike->fPrev;
+        shard->fTail = strike->fPrev;
     }
 
     strike->fPrev = strike->fNext = nullptr;
     strike->fRemoved = true;
-    fStrikeLookup.remove(strike->getDescriptor());
+    shard->fStrikeLookup.remove(strike->getDescriptor());
 }
 
-void SkStrikeCache::validate() const {
+void SkStrikeCache::validate(const Shard& shard) const {
 #ifdef SK_DEBUG
     size_t computedBytes = 0;
     int computedCount = 0;
 
-    const SkStrike* strike = fHead;
+    const SkStrike* strike = shard.fHead;
     while (strike != nullptr) {
         computedBytes += strike->fMemoryUsed;
         computedCount += 1;
-        SkASSERT(fStrikeLookup.findOrNull(strike->getDescriptor()) != nullptr);
+        SkASSERT(shard.fStrikeLookup.findOrNull(strike->getDescriptor()) != nullptr);
         strike = strike->fNext;
     }
 
-    if (fCacheCount != computedCount) {
-        SkDebugf("fCacheCount: %d, computedCount: %d", fCacheCount, computedCount);
-        SK_ABORT("fCacheCount != computedCount");
+    if (shard.fCount != computedCount) {
+        SkDebugf("fCount: %d, computedCount: %d", shard.fCount, computedCount);
+        SK_ABORT("fCount != computedCount");
     }
-    if (fTotalMemoryUsed != computedBytes) {
-        SkDebugf("fTotalMemoryUsed: %zu, computedBytes: %zu", fTotalMemoryUsed, computedBytes);
-        SK_ABORT("fTotalMemoryUsed == computedBytes");
+    if (shard.fMemoryUsed != computedBytes) {
+        SkDebugf("fMemoryUsed: %zu, computedBytes: %zu", shard.fMemoryUsed, computedBytes);
+        SK_ABORT("fMemoryUsed == computedBytes");
     }
 #endif
 }
@@ -358,10 +421,12 @@ void SkStrikeCache::validate() const {
 
 void SkStrike::updateDelta(size_t increase) {
     if (increase != 0) {
-        SkAutoMutexExclusive lock{fStrikeCache->fLock};
+        SkStrikeCache::Shard* shard = &fStrikeCache->shardFor(this->getDescriptor());
+        SkAutoMutexExclusive lock{shard->fLock};
         fMemoryUsed += increase;
         if (!fRemoved) {
-            fStrikeCache->fTotalMemoryUsed += increase;
+            shard->fMemoryUsed += increase;
+            fStrikeCache->fTotalMemoryUsed.fetch_add(increase, std::memory_order_relaxed);
         }
     }
 }
@@ -8,6 +8,7 @@
 #ifndef SkStrikeCache_DEFINED
 #define SkStrikeCache_DEFINED
 
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -209,21 +210,21 @@ public:
 
 class SkStrikeCache final : public sktext::StrikeForGPUCacheInterface {
 public:
-    SkStrikeCache() : fLock("SkStrikeCache.fLock") {}
+    SkStrikeCache() = default;
 
     static SkStrikeCache* GlobalStrikeCache();
 
-    sk_sp<SkStrike> findStrike(const SkDescriptor& desc) SK_EXCLUDES(fLock);
+    sk_sp<SkStrike> findStrike(const SkDescriptor& desc);
 
     sk_sp<SkStrike> createStrike(
             const SkStrikeSpec& strikeSpec,
             SkFontMetrics* maybeMetrics = nullptr,
-            std::unique_ptr<SkStrikePinner> = nullptr) SK_EXCLUDES(fLock);
+            std::unique_ptr<SkStrikePinner> = nullptr);
 
-    sk_sp<SkStrike> findOrCreateStrike(const SkStrikeSpec& strikeSpec) SK_EXCLUDES(fLock);
+    sk_sp<SkStrike> findOrCreateStrike(const SkStrikeSpec& strikeSpec);
 
     sktext::ScopedStrikeForGPU findOrCreateScopedStrike(
-            const SkStrikeSpec& strikeSpec) override SK_EXCLUDES(fLock);
+            const SkStrikeSpec& strikeSpec) override;
 
     static void PurgeAll();
     static void Dump();
@@ -232,55 +233,85 @@ public:
     // SkTraceMemoryDump interface.
     static void DumpMemoryStatistics(SkTraceMemoryDump* dump);
 
-    void purgeAll() SK_EXCLUDES(fLock); // does not change budget
+    void purgeAll(); // does not change budget
 
-    int getCacheCountLimit() const SK_EXCLUDES(fLock);
-    int setCacheCountLimit(int limit) SK_EXCLUDES(fLock);
-    int getCacheCountUsed() const SK_EXCLUDES(fLock);
+    int getCacheCountLimit() const;
+    int setCacheCountLimit(int limit);
+    int getCacheCountUsed() const;
 
-    size_t getCacheSizeLimit() const SK_EXCLUDES(fLock);
-    size_t setCacheSizeLimit(size_t limit) SK_EXCLUDES(fLock);
-    size_t getTotalMemoryUsed() const SK_EXCLUDES(fLock);
+    size_t getCacheSizeLimit() const;
+    size_t setCacheSizeLimit(size_t limit);
+    size_t getTotalMemoryUsed() const;
 
 private:
     friend class SkStrike;  // for SkStrike::updateDelta
-    sk_sp<SkStrike> internalFindStrikeOrNull(const SkDescriptor& desc) SK_REQUIRES(fLock);
+
+    // Strikes are spread over shards by descriptor checksum. Each shard has its own lock, LRU
+    // list and lookup table, so threads working with different strikes rarely contend. The
+    // budgets are global and enforced approximately: the LRU order is only kept per shard, and
+    // a purge takes strikes from the tail of every shard in turn.
+    static constexpr int kShardBits = 4;
+    static constexpr int kShardCount = 1 << kShardBits;
+
+    struct Shard {
+        Shard() : fLock("SkStrikeCache.Shard.fLock") {}
+
+        mutable SkMutex fLock;
+        SkStrike* fHead SK_GUARDED_BY(fLock) {nullptr};
+        SkStrike* fTail SK_GUARDED_BY(fLock) {nullptr};
+        struct StrikeTraits {
+            static const SkDescriptor& GetKey(const sk_sp<SkStrike>& strike) {
+                return strike->getDescriptor();
+            }
+            static uint32_t Hash(const SkDescriptor& descriptor) {
+                return descriptor.getChecksum();
+            }
+        };
+        SkTHashTable<sk_sp<SkStrike>, SkDescriptor, StrikeTraits> fStrikeLookup
+                SK_GUARDED_BY(fLock);
+
+        size_t  fMemoryUsed SK_GUARDED_BY(fLock) {0};
+        int32_t fCount SK_GUARDED_BY(fLock) {0};
+    };
+
+    Shard& shardFor(const SkDescriptor& desc) {
+        // The lookup tables hash on the low bits of the checksum, so pick shards by the high ones.
+        return fShards[desc.getChecksum() >> (32 - kShardBits)];
+    }
+
+    sk_sp<SkStrike> internalFindStrikeOrNull(Shard* shard, const SkDescriptor& desc)
+            SK_REQUIRES(shard->fLock);
     sk_sp<SkStrike> internalCreateStrike(
+            Shard* shard,
             const SkStrikeSpec& strikeSpec,
             SkFontMetrics* maybeMetrics = nullptr,
-            std::unique_ptr<SkStrikePinner> = nullptr) SK_REQUIRES(fLock);
+            std::unique_ptr<SkStrikePinner> = nullptr) SK_REQUIRES(shard->fLock);
 
-    // The following methods can only be called when mutex is already held.
-    void internalRemoveStrike(SkStrike* strike) SK_REQUIRES(fLock);
-    void internalAttachToHead(sk_sp<SkStrike> strike) SK_REQUIRES(fLock);
+    // The following methods can only be called when the shard's mutex is already held.
+    void internalRemoveStrike(Shard* shard, SkStrike* strike) SK_REQUIRES(shard->fLock);
+    void internalAttachToHead(Shard* shard, sk_sp<SkStrike> strike) SK_REQUIRES(shard->fLock);
 
     // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
-    // and attempt to purge caches to match.
+    // and attempt to purge caches to match. Only one over-budget purge runs at a time; other
+    // threads that find the cache over budget carry on and leave the work to it.
     // Returns number of bytes freed.
-    size_t internalPurge(size_t minBytesNeeded = 0) SK_REQUIRES(fLock);
+    size_t internalPurge(size_t minBytesNeeded = 0);
+    // Frees unpinned strikes, least recently used first, until the given amounts are freed.
+    size_t internalPurgeShards(size_t bytesNeeded, int countNeeded);
 
-    // A simple accounting of what each glyph cache reports and the strike cache total.
-    void validate() const SK_REQUIRES(fLock);
+    // A simple accounting of what each glyph cache reports and the shard total.
+    void validate(const Shard& shard) const SK_REQUIRES(shard.fLock);
 
-    void forEachStrike(std::function<void(const SkStrike&)> visitor) const SK_EXCLUDES(fLock);
+    void forEachStrike(std::function<void(const SkStrike&)> visitor) const;
 
-    mutable SkMutex fLock;
-    SkStrike* fHead SK_GUARDED_BY(fLock) {nullptr};
-    SkStrike* fTail SK_GUARDED_BY(fLock) {nullptr};
-    struct StrikeTraits {
-        static const SkDescriptor& GetKey(const sk_sp<SkStrike>& strike) {
-            return strike->getDescriptor();
-        }
-        static uint32_t Hash(const SkDescriptor& descriptor) {
-            return descriptor.getChecksum();
-        }
-    };
-    SkTHashTable<sk_sp<SkStrike>, SkDescriptor, StrikeTraits> fStrikeLookup SK_GUARDED_BY(fLock);
+    Shard fShards[kShardCount];
 
-    size_t  fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
-    size_t  fTotalMemoryUsed SK_GUARDED_BY(fLock) {0};
-    int32_t fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
-    int32_t fCacheCount SK_GUARDED_BY(fLock) {0};
+    std::atomic<size_t>  fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
+    std::atomic<size_t>  fTotalMemoryUsed{0};
+    std::atomic<int32_t> fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
+    std::atomic<int32_t> fCacheCount{0};
+    std::atomic<bool>    fPurging{false};
+    std::atomic<int>     fNextPurgeShard{0};
 };
 
 #endif  // SkStrikeCache_DEFINED
@@ -19,14 +19,29 @@ void SkTaskGroup::add(std::function<void(void)> fn) {
 }
 
 void SkTaskGroup::batch(int N, std::function<void(int)> fn) {
-    // TODO: I really thought we had some sort of more clever chunking logic.
-    fPending.fetch_add(+N, std::memory_order_relaxed);
-    for (int i = 0; i < N; i++) {
-        fExecutor.add([=] {
-            fn(i);
-            fPending.fetch_add(-1, std::memory_order_release);
-        });
+    if (N <= 0) {
+        return;
     }
+    fPending.fetch_add(+N, std::memory_order_relaxed);
+    // Rather than adding N tasks up front, add one task for the whole range and let it split
+    // itself in half recursively. The splitting happens on whichever threads pick the work up,
+    // so with a work-stealing executor most of the tasks never touch a shared queue.
+    this->addRange(std::make_shared<const std::function<void(int)>>(std::move(fn)), 0, N);
+}
+
+void SkTaskGroup::addRange(std::shared_ptr<const std::function<void(int)>> fn,
+                           int start, int end) {
+    fExecutor.add([this, fn{std::move(fn)}, start, end]() mutable {
+        // Hand off the lower half and keep the upper half, so that an executor which runs work
+        // as soon as it's added still calls fn for 0..N-1 in order.
+        while (end - start > 1) {
+            int mid = start + (end - start) / 2;
+            this->addRange(fn, start, mid);
+            start = mid;
+        }
+        (*fn)(start);
+        fPending.fetch_add(-1, std::memory_order_release);
+    });
 }
 
 bool SkTaskGroup::done() const {
@@ -13,6 +13,7 @@
 #include "include/private/SkNoncopyable.h"
 #include <atomic>
 #include <functional>
+#include <memory>
 
 class SkTaskGroup : SkNoncopyable {
 public:
@@ -41,6 +42,9 @@ public:
     };
 
 private:
+    // Adds a task that runs fn over [start, end), splitting off halves of the range as new tasks.
+    void addRange(std::shared_ptr<const std::function<void(int)>> fn, int start, int end);
+
     std::atomic<int32_t> fPending;
     SkExecutor&          fExecutor;
 };
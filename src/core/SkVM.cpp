@@ -15,8 +15,10 @@
 #include "src/core/SkCpu.h"
 #include "src/core/SkEnumerate.h"
 #include "src/core/SkOpts.h"
+#include "src/core/SkReadBuffer.h"
 #include "src/core/SkStreamPriv.h"
 #include "src/core/SkVM.h"
+#include "src/core/SkWriteBuffer.h"
 #include "src/utils/SkVMVisualizer.h"
 #include <algorithm>
 #include <atomic>
@@ -567,6 +569,135 @@ namespace skvm {
                 fTraceHooks, debug_name, allow_jit};
     }
 
+    // Bump this when the meaning of a flattened program changes in a way the op list and
+    // OptimizedInstruction layout below don't capture.
+    static constexpr uint32_t kFlattenedProgramVersion = 1;
+
+    // Identifies the Skia build a flattened program came from, as far as its meaning goes.
+    static uint32_t flattened_program_build_id() {
+        static const uint32_t id = [] {
+            static constexpr char kOps[] =
+            #define M(op) #op " "
+                SKVM_OPS(M)
+            #undef M
+            ;
+            uint32_t h = SkOpts::hash(kOps, sizeof(kOps), kFlattenedProgramVersion);
+            return h ^ (uint32_t)sizeof(OptimizedInstruction);
+        }();
+        return id;
+    }
+
+    // The CPU features that can change how a program was optimized (see detect_features()),
+    // or the hashes clients like SkVMBlitter key programs by (see SkOpts::hash).
+    static uint32_t flattened_program_cpu_id() {
+        static const uint32_t id = [] {
+        #if defined(SK_CPU_X86)
+            const uint32_t masks[] = { SkCpu::SSE41, SkCpu::SSE42, SkCpu::AVX, SkCpu::HSW,
+                                       SkCpu::SKX };
+        #elif defined(SK_CPU_ARM64) || defined(SK_CPU_ARM32)
+            const uint32_t masks[] = { SkCpu::NEON, SkCpu::NEON_FMA, SkCpu::CRC32 };
+        #else
+            const uint32_t masks[] = { 0 };
+        #endif
+            uint32_t bits = 0;
+            for (size_t i = 0; i < SK_ARRAY_COUNT(masks); i++) {
+                if (masks[i] && SkCpu::Supports(masks[i])) {
+                    bits |= 1u << i;
+                }
+            }
+            return bits;
+        }();
+        return id;
+    }
+
+    Program Builder::doneAndFlatten(sk_sp<SkData>* flattened,
+                                    const char* debug_name,
+                                    bool allow_jit) const {
+        SkASSERT(flattened);
+        char buf[64] = "skvm-jit-";
+        if (!debug_name) {
+            *SkStrAppendU32(buf+9, this->hash()) = '\0';
+            debug_name = buf;
+        }
+
+        auto optimized = this->optimize();
+        *flattened = nullptr;
+        if (fTraceHooks.empty()) {
+            SkBinaryWriteBuffer buffer;
+            buffer.writeUInt(flattened_program_build_id());
+            buffer.writeUInt(flattened_program_cpu_id());
+            buffer.writeIntArray(fStrides.data(), SkToU32(fStrides.size()));
+            buffer.writeUInt(SkToU32(optimized.size()));
+            for (const OptimizedInstruction& inst : optimized) {
+                const int32_t fields[] = {
+                    (int)inst.op, inst.x, inst.y, inst.z, inst.w,
+                    inst.immA, inst.immB, inst.immC, inst.death, inst.can_hoist,
+                };
+                buffer.writePad32(fields, sizeof(fields));
+            }
+            *flattened = buffer.snapshotAsData();
+        }
+        return {optimized, nullptr, fStrides, fTraceHooks, debug_name, allow_jit};
+    }
+
+    Program Program::MakeFromFlattened(const SkData& data,
+                                       const char* debug_name,
+                                       bool allow_jit) {
+        SkReadBuffer buffer(data.data(), data.size());
+        if (buffer.readUInt() != flattened_program_build_id() ||
+            buffer.readUInt() != flattened_program_cpu_id()) {
+            return {};
+        }
+
+        std::vector<int> strides(buffer.getArrayCount());
+        if (!buffer.readIntArray(strides.data(), strides.size())) {
+            return {};
+        }
+        for (int stride : strides) {
+            if (!buffer.validate(stride >= 0)) {
+                return {};
+            }
+        }
+
+        const int nargs = (int)strides.size();
+        const uint32_t count = buffer.readUInt();
+        if (!buffer.validateCanReadN<int32_t>((size_t)count * 10)) {
+            return {};
+        }
+        std::vector<OptimizedInstruction> instructions(count);
+        for (uint32_t i = 0; i < count; i++) {
+            int32_t fields[10];
+            buffer.readPad32(fields, sizeof(fields));
+
+            // The interpreter and JIT trust their input, so make sure every instruction only
+            // refers to earlier values and to arguments that exist.
+            const Val id = (Val)i;
+            auto arg_ok = [&](Val v) { return v == NA || (0 <= v && v < id); };
+            OptimizedInstruction& inst = instructions[i];
+            inst = {(Op)fields[0], fields[1], fields[2], fields[3], fields[4],
+                    fields[5], fields[6], fields[7], fields[8], fields[9] != 0};
+            if (!buffer.validate(0 <= fields[0] && fields[0] <= (int)Op::duplicate &&
+                                 !is_trace(inst.op) &&
+                                 arg_ok(inst.x) && arg_ok(inst.y) &&
+                                 arg_ok(inst.z) && arg_ok(inst.w) &&
+                                 id <= inst.death && inst.death <= (Val)count)) {
+                return {};
+            }
+            if (touches_varying_memory(inst.op) || inst.op == Op::uniform32 ||
+                inst.op == Op::array32 || (Op::gather8 <= inst.op && inst.op <= Op::gather32)) {
+                if (!buffer.validate(0 <= inst.immA && inst.immA < nargs)) {
+                    return {};
+                }
+            }
+        }
+        if (!buffer.isValid()) {
+            return {};
+        }
+
+        return {instructions, nullptr, strides, /*traceHooks=*/{},
+                debug_name ? debug_name : "skvm-jit-flattened", allow_jit};
+    }
+
     uint64_t Builder::hash() const {
         uint32_t lo = SkOpts::hash(fProgram.data(), fProgram.size() * sizeof(Instruction), 0),
                  hi = SkOpts::hash(fProgram.data(), fProgram.size() * sizeof(Instruction), 1);
@@ -11,6 +11,7 @@
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkRefCnt.h"
 #include "include/core/SkSpan.h"
 #include "include/private/SkMacros.h"
 #include "include/private/SkTArray.h"
@@ -18,6 +19,7 @@
 #include "src/core/SkVM_fwd.h"
 #include <vector>      // std::vector
 
+class SkData;
 class SkWStream;
 
 #if defined(SKVM_JIT_WHEN_POSSIBLE) && !defined(SK_BUILD_FOR_IOS)
@@ -621,6 +623,14 @@ namespace skvm {
         Program done(const char* debug_name = nullptr,
                      bool allow_jit=true) const;
 
+        // Like done(), but also flattens the optimized program into *flattened, so that an
+        // equivalent Program can be made later by Program::MakeFromFlattened() without building
+        // or optimizing it again, even in another process. Programs with trace hooks can't be
+        // flattened, and leave *flattened null.
+        Program doneAndFlatten(sk_sp<SkData>* flattened,
+                               const char* debug_name = nullptr,
+                               bool allow_jit=true) const;
+
         // Mostly for debugging, tests, etc.
         std::vector<Instruction> program() const { return fProgram; }
         std::vector<OptimizedInstruction> optimize(viz::Visualizer* visualizer = nullptr) const;
@@ -1056,6 +1066,13 @@ namespace skvm {
         Program(const Program&) = delete;
         Program& operator=(const Program&) = delete;
 
+        // Makes a Program from data written by Builder::doneAndFlatten(), in this process or in
+        // an earlier one running the same Skia build on a CPU with the same features.
+        // Returns an empty Program if the data can't be used.
+        static Program MakeFromFlattened(const SkData&,
+                                         const char* debug_name = nullptr,
+                                         bool allow_jit=true);
+
         void eval(int n, void* args[]) const;
 
         template <typename... T>
@@ -6,7 +6,9 @@
  */
 
 #include "include/private/SkImageInfoPriv.h"
+#include "include/core/SkData.h"
 #include "include/private/SkMacros.h"
+#include "include/private/SkMutex.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkBlendModePriv.h"
 #include "src/core/SkBlenderBase.h"
@@ -18,9 +20,11 @@
 #include "src/core/SkMatrixProvider.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkPaintPriv.h"
+#include "src/core/SkReadBuffer.h"
 #include "src/core/SkRecordReplay.h"
 #include "src/core/SkVM.h"
 #include "src/core/SkVMBlitter.h"
+#include "src/core/SkWriteBuffer.h"
 #include "src/shaders/SkColorFilterShader.h"
 
 #include <cinttypes>
@@ -582,6 +586,76 @@ SkString SkVMBlitter::DebugName(const Key& key) {
 
 void SkVMBlitter::ReleaseProgramCache() {}
 
+struct SkVMBlitter::PersistentPrograms {
+    SkMutex                                    fMutex;
+    std::atomic<bool>                          fEnabled{false};
+    SkTHashMap<Key, sk_sp<SkData>, SkGoodHash> fPrograms SK_GUARDED_BY(fMutex);
+};
+
+SkVMBlitter::PersistentPrograms& SkVMBlitter::GetPersistentPrograms() {
+    static auto* programs = new PersistentPrograms;
+    return *programs;
+}
+
+static constexpr uint32_t kPersistentProgramsMagic = SkSetFourByteTag('s', 'k', 'v', 'b');
+
+void SkVMBlitter::SetPersistentProgramsEnabled(bool enabled) {
+    PersistentPrograms& persistent = GetPersistentPrograms();
+    SkAutoMutexExclusive lock(persistent.fMutex);
+    persistent.fEnabled = enabled;
+    if (!enabled) {
+        persistent.fPrograms.reset();
+    }
+}
+
+sk_sp<SkData> SkVMBlitter::SavePersistentPrograms() {
+    PersistentPrograms& persistent = GetPersistentPrograms();
+    SkAutoMutexExclusive lock(persistent.fMutex);
+    if (persistent.fPrograms.count() == 0) {
+        return nullptr;
+    }
+
+    SkBinaryWriteBuffer buffer;
+    buffer.writeUInt(kPersistentProgramsMagic);
+    buffer.writeUInt(persistent.fPrograms.count());
+    persistent.fPrograms.foreach([&](const Key& key, sk_sp<SkData>* program) {
+        buffer.writePad32(&key, sizeof(Key));
+        buffer.writeDataAsByteArray(program->get());
+    });
+    return buffer.snapshotAsData();
+}
+
+bool SkVMBlitter::LoadPersistentPrograms(const SkData& data) {
+    SkReadBuffer buffer(data.data(), data.size());
+    if (!buffer.validate(buffer.readUInt() == kPersistentProgramsMagic)) {
+        return false;
+    }
+    const uint32_t count = buffer.readUInt();
+    if (!buffer.validateCanReadN<Key>(count)) {
+        return false;
+    }
+
+    std::vector<std::pair<Key, sk_sp<SkData>>> programs;
+    programs.reserve(count);
+    for (uint32_t i = 0; i < count && buffer.isValid(); i++) {
+        Key key;
+        buffer.readPad32(&key, sizeof(Key));
+        programs.push_back({key, buffer.readByteArrayAsData()});
+    }
+    if (!buffer.isValid()) {
+        return false;
+    }
+
+    // Each program is only validated (against this build and CPU, too) when it's first used.
+    PersistentPrograms& persistent = GetPersistentPrograms();
+    SkAutoMutexExclusive lock(persistent.fMutex);
+    persistent.fEnabled = true;
+    for (auto& [key, program] : programs) {
+        persistent.fPrograms.set(key, std::move(program));
+    }
+    return true;
+}
+
 skvm::Program* SkVMBlitter::buildProgram(Coverage coverage) {
     // eg, blitter re-use...
     if (fProgramPtrs[coverage]) {
@@ -603,9 +677,32 @@ skvm::Program* SkVMBlitter::buildProgram(Coverage coverage) {
         }
     }
 
-    // Okay, let's build it...
+    // Okay, we'll have to make it. Perhaps a previous process already built it?
     fStoreToCache = true;
 
+    PersistentPrograms& persistent = GetPersistentPrograms();
+    const bool usePersistent = persistent.fEnabled.load(std::memory_order_relaxed);
+    if (usePersistent) {
+        sk_sp<SkData> flattened;
+        {
+            SkAutoMutexExclusive lock(persistent.fMutex);
+            if (sk_sp<SkData>* found = persistent.fPrograms.find(key)) {
+                flattened = *found;
+            }
+        }
+        if (flattened) {
+            skvm::Program program =
+                    skvm::Program::MakeFromFlattened(*flattened, DebugName(key).c_str());
+            if (!program.empty()) {
+                fProgramPtrs[coverage] = fPrograms[coverage].set(std::move(program));
+                return fProgramPtrs[coverage];
+            }
+            // Flattened by another build or CPU, or corrupt. We'll replace it below.
+        }
+    }
+
+    // Okay, let's build it...
+
     // We don't really _need_ to rebuild fUniforms here.
     // It's just more natural to have effects unconditionally emit them,
     // and more natural to rebuild fUniforms than to emit them into a temporary buffer.
@@ -617,7 +714,17 @@ skvm::Program* SkVMBlitter::buildProgram(Coverage coverage) {
     SkASSERTF(fUniforms.buf.size() == prev,
               "%zu, prev was %zu", fUniforms.buf.size(), prev);
 
-    skvm::Program program = builder.done(DebugName(key).c_str());
+    skvm::Program program;
+    if (usePersistent) {
+        sk_sp<SkData> flattened;
+        program = builder.doneAndFlatten(&flattened, DebugName(key).c_str());
+        if (flattened) {
+            SkAutoMutexExclusive lock(persistent.fMutex);
+            persistent.fPrograms.set(key, std::move(flattened));
+        }
+    } else {
+        program = builder.done(DebugName(key).c_str());
+    }
     if ((false)) {
         static std::atomic<int> missed{0},
                                 total{0};
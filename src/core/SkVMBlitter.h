@@ -39,6 +39,11 @@ public:
 
     ~SkVMBlitter() override;
 
+    // Backs SkGraphics::{SetRasterProgramCacheEnabled,SaveRasterPrograms,LoadRasterPrograms}().
+    static void SetPersistentProgramsEnabled(bool);
+    static sk_sp<SkData> SavePersistentPrograms();
+    static bool LoadPersistentPrograms(const SkData&);
+
 private:
     enum Coverage { Full, UniformF, MaskA8, MaskLCD16, Mask3D, kCount };
     struct Key {
@@ -85,6 +90,11 @@ private:
     static SkString DebugName(const Key& key);
     static void ReleaseProgramCache();
 
+    // Flattened programs that outlive the thread-local program caches, and may be saved and
+    // loaded across processes.
+    struct PersistentPrograms;
+    static PersistentPrograms& GetPersistentPrograms();
+
     skvm::Program* buildProgram(Coverage coverage);
     void updateUniforms(int right, int y);
     const void* isSprite(int x, int y) const;
@@ -241,6 +241,14 @@ bool GrDrawingManager::executeRenderTasks(GrOpFlushState* flushState) {
 
     bool anyRenderTasksExecuted = false;
 
+#if GR_GPU_STATS && GR_TEST_UTILS
+    auto& batchingStats = fContext->priv().opBatchingStats();
+    if (batchingStats.fEnabled) {
+        // OpsTasks add the number of ops they execute to this flush's count.
+        batchingStats.fOpsExecutedPerFlush.push_back(0);
+    }
+#endif
+
     for (const auto& renderTask : fDAG) {
         if (!renderTask || !renderTask->isInstantiated()) {
              continue;
@@ -24,6 +24,9 @@
 #include "src/gpu/ganesh/ops/AtlasTextOp.h"
 #include "src/text/gpu/TextBlob.h"
 #include "src/text/gpu/TextBlobRedrawCoordinator.h"
+#include "src/utils/SkJSONWriter.h"
+
+#include <algorithm>
 
 
 using TextBlobRedrawCoordinator = sktext::gpu::TextBlobRedrawCoordinator;
@@ -239,5 +242,130 @@ void GrRecordingContext::DMSAAStats::merge(const DMSAAStats& stats) {
     }
 }
 
+const char* GrOpBatchingStats::FailureName(Failure failure) {
+    switch (failure) {
+        case Failure::kDifferentOpType:        return "different_op_type";
+        case Failure::kDifferentClip:          return "different_clip";
+        case Failure::kDifferentDstRead:       return "different_dst_read";
+        case Failure::kOverlappingDstRead:     return "overlapping_dst_read";
+        case Failure::kDifferentProcessors:    return "different_processors";
+        case Failure::kDifferentAAType:        return "different_aa_type";
+        case Failure::kDifferentStencil:       return "different_stencil";
+        case Failure::kDifferentPipelineFlags: return "different_pipeline_flags";
+        case Failure::kOpDeclined:             return "op_declined";
+    }
+    SkUNREACHABLE;
+}
+
+void GrOpBatchingStats::dumpKeyValuePairs(SkTArray<SkString>* keys,
+                                                            SkTArray<double>* values) const {
+    int opsExecuted = 0;
+    int maxOpsPerFlush = 0;
+    for (int count : fOpsExecutedPerFlush) {
+        opsExecuted += count;
+        maxOpsPerFlush = std::max(maxOpsPerFlush, count);
+    }
+    keys->push_back(SkString("op_batching_flushes"));
+    values->push_back(fOpsExecutedPerFlush.count());
+
+    keys->push_back(SkString("op_batching_ops_executed"));
+    values->push_back(opsExecuted);
+
+    keys->push_back(SkString("op_batching_max_ops_per_flush"));
+    values->push_back(maxOpsPerFlush);
+
+    keys->push_back(SkString("op_batching_op_chains_executed"));
+    values->push_back(fNumOpChainsExecuted);
+
+    for (const auto& [name, op] : fOpTypes) {
+        auto append = [&](const char* stat, int value) {
+            keys->push_back(SkStringPrintf("op_batching_%s_%s", name.c_str(), stat));
+            values->push_back(value);
+        };
+        append("recorded", op.fRecorded);
+        append("candidates", op.fCandidates);
+        append("merged", op.fMerged);
+        append("chained", op.fChained);
+        for (int i = 0; i < kFailureCount; ++i) {
+            append(FailureName(static_cast<Failure>(i)), op.fFailures[i]);
+        }
+        append("stopped_at_overlap", op.fStoppedAtOverlap);
+        append("stopped_at_max_distance", op.fStoppedAtMaxDistance);
+        append("executed", op.fExecuted);
+    }
+}
+
+void GrOpBatchingStats::dumpJSON(SkJSONWriter* writer) const {
+    writer->beginObject();
+
+    writer->beginArray("ops_executed_per_flush");
+    for (int count : fOpsExecutedPerFlush) {
+        writer->appendS32(count);
+    }
+    writer->endArray();
+    writer->appendS32("op_chains_executed", fNumOpChainsExecuted);
+
+    writer->beginObject("ops");
+    for (const auto& [name, op] : fOpTypes) {
+        writer->beginObject(name.c_str());
+        writer->appendS32("recorded", op.fRecorded);
+        writer->appendS32("candidates", op.fCandidates);
+        writer->appendS32("merged", op.fMerged);
+        writer->appendS32("chained", op.fChained);
+        writer->beginObject("failures");
+        for (int i = 0; i < kFailureCount; ++i) {
+            writer->appendS32(FailureName(static_cast<Failure>(i)), op.fFailures[i]);
+        }
+        writer->endObject();
+        writer->appendS32("stopped_at_overlap", op.fStoppedAtOverlap);
+        writer->appendS32("stopped_at_max_distance", op.fStoppedAtMaxDistance);
+        writer->appendS32("executed", op.fExecuted);
+        writer->endObject();
+    }
+    writer->endObject();
+
+    writer->endObject();
+}
+
+void GrOpBatchingStats::dump() const {
+    int opsExecuted = 0;
+    for (int count : fOpsExecutedPerFlush) {
+        opsExecuted += count;
+    }
+    SkDebugf("Op Batching Flushes: %d\n", fOpsExecutedPerFlush.count());
+    SkDebugf("Op Batching Ops Executed: %d (in %d chains)\n", opsExecuted, fNumOpChainsExecuted);
+    for (const auto& [name, op] : fOpTypes) {
+        SkDebugf("    %s: %d recorded, %d merged, %d chained, %d executed\n",
+                 name.c_str(), op.fRecorded, op.fMerged, op.fChained, op.fExecuted);
+        SkDebugf("        %d candidates:", op.fCandidates);
+        for (int i = 0; i < kFailureCount; ++i) {
+            if (op.fFailures[i]) {
+                SkDebugf(" %s %d,", FailureName(static_cast<Failure>(i)), op.fFailures[i]);
+            }
+        }
+        SkDebugf(" stopped at overlap %d, stopped at max distance %d\n",
+                 op.fStoppedAtOverlap, op.fStoppedAtMaxDistance);
+    }
+}
+
+void GrOpBatchingStats::merge(const GrOpBatchingStats& stats) {
+    fNumOpChainsExecuted += stats.fNumOpChainsExecuted;
+    fOpsExecutedPerFlush.push_back_n(stats.fOpsExecutedPerFlush.count(),
+                                     stats.fOpsExecutedPerFlush.begin());
+    for (const auto& [name, op] : stats.fOpTypes) {
+        OpTypeStats& total = fOpTypes[name];
+        total.fRecorded += op.fRecorded;
+        total.fCandidates += op.fCandidates;
+        total.fMerged += op.fMerged;
+        total.fChained += op.fChained;
+        for (int i = 0; i < kFailureCount; ++i) {
+            total.fFailures[i] += op.fFailures[i];
+        }
+        total.fStoppedAtOverlap += op.fStoppedAtOverlap;
+        total.fStoppedAtMaxDistance += op.fStoppedAtMaxDistance;
+        total.fExecuted += op.fExecuted;
+    }
+}
+
 #endif // GR_GPU_STATS
 #endif // GR_TEST_UTILS
@@ -108,6 +108,9 @@ public:
 #if GR_GPU_STATS && GR_TEST_UTILS
     using DMSAAStats = GrRecordingContext::DMSAAStats;
     DMSAAStats& dmsaaStats() { return this->context()->fDMSAAStats; }
+
+    using OpBatchingStats = GrRecordingContext::OpBatchingStats;
+    OpBatchingStats& opBatchingStats() { return this->context()->fOpBatchingStats; }
 #endif
 
     sktext::gpu::SDFTControl getSDFTControl(bool useSDFTForSmallText) const;
@@ -408,7 +408,7 @@ GrOp::CombineResult AtlasTextOp::onCombineIfPossible(GrOp* t, SkArenaAlloc*, con
     }
 
     if (fProcessors != that->fProcessors) {
-        return CombineResult::kCannotCombine;
+        return this->cannotCombine(CombineFailure::kProcessors);
     }
 
     if (fUsesLocalCoords) {
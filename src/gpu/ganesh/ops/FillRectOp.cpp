@@ -329,7 +329,7 @@ private:
         bool upgradeToCoverageAAOnMerge = false;
         if (fHelper.aaType() != that->fHelper.aaType()) {
             if (!CanUpgradeAAOnMerge(fHelper.aaType(), that->fHelper.aaType())) {
-                return CombineResult::kCannotCombine;
+                return this->cannotCombine(CombineFailure::kAAType);
             }
             upgradeToCoverageAAOnMerge = true;
         }
@@ -341,8 +341,10 @@ private:
 
         // Unlike most users of the draw op helper, this op can merge none-aa and coverage-aa draw
         // ops together, so pass true as the last argument.
-        if (!fHelper.isCompatible(that->fHelper, caps, this->bounds(), that->bounds(), true)) {
-            return CombineResult::kCannotCombine;
+        CombineFailure failure;
+        if (!fHelper.isCompatible(that->fHelper, caps, this->bounds(), that->bounds(), true,
+                                  &failure)) {
+            return this->cannotCombine(failure);
         }
 
         // If the paints were compatible, the trivial/solid-color state should be the same
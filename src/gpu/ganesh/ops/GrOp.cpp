@@ -21,6 +21,9 @@ GrOp::CombineResult GrOp::combineIfPossible(GrOp* that, SkArenaAlloc* alloc, con
     if (this->classID() != that->classID()) {
         return CombineResult::kCannotCombine;
     }
+#if GR_GPU_STATS && GR_TEST_UTILS
+    fCombineFailure = CombineFailure::kOpState;
+#endif
     auto result = this->onCombineIfPossible(that, alloc, caps);
     if (result == CombineResult::kMerged) {
         this->joinBounds(*that);
@@ -116,9 +116,25 @@ public:
         kCannotCombine
     };
 
+    /**
+     * Why the last combineIfPossible() call returned kCannotCombine. Subclasses report this through
+     * cannotCombine(); it is only recorded in builds that gather op batching stats.
+     */
+    enum class CombineFailure : uint8_t {
+        kOpState,        // Op specific state (geometry, textures, counts...) prevented it.
+        kProcessors,     // The processor sets differ.
+        kAAType,         // The AA types differ and could not be reconciled.
+        kStencil,        // The user stencil settings differ.
+        kPipelineFlags,  // The pipeline flags differ.
+    };
+
     // The arenas are the same as what was available when the op was created.
     CombineResult combineIfPossible(GrOp* that, SkArenaAlloc* alloc, const GrCaps& caps);
 
+#if GR_GPU_STATS && GR_TEST_UTILS
+    CombineFailure combineFailure() const { return fCombineFailure; }
+#endif
+
     const SkRect& bounds() const {
         SkASSERT(kUninitialized_BoundsFlag != fBoundsFlags);
         return fBounds;
@@ -291,6 +307,14 @@ protected:
 
     static uint32_t GenOpClassID() { return GenID(&gCurrOpClassID); }
 
+    // Returned from onCombineIfPossible() to refuse a combine and say why.
+    CombineResult cannotCombine(CombineFailure failure) {
+#if GR_GPU_STATS && GR_TEST_UTILS
+        fCombineFailure = failure;
+#endif
+        return CombineResult::kCannotCombine;
+    }
+
 private:
     void joinBounds(const GrOp& that) {
         if (that.hasAABloat()) {
@@ -350,6 +374,9 @@ private:
     GrOp*                               fPrevInChain = nullptr;
     const uint16_t                      fClassID;
     uint16_t                            fBoundsFlags;
+#if GR_GPU_STATS && GR_TEST_UTILS
+    CombineFailure                      fCombineFailure = CombineFailure::kOpState;
+#endif
 
     static uint32_t GenOpID() { return GenID(&gCurrOpUniqueID); }
     mutable uint32_t                    fUniqueID = SK_InvalidUniqueID;
@@ -39,13 +39,21 @@ GrDrawOp::FixedFunctionFlags GrSimpleMeshDrawOpHelper::fixedFunctionFlags() cons
 
 bool GrSimpleMeshDrawOpHelper::isCompatible(const GrSimpleMeshDrawOpHelper& that,
                                             const GrCaps& caps, const SkRect& thisBounds,
-                                            const SkRect& thatBounds, bool ignoreAAType) const {
-    if (SkToBool(fProcessors) != SkToBool(that.fProcessors)) {
+                                            const SkRect& thatBounds, bool ignoreAAType,
+                                            GrOp::CombineFailure* failure) const {
+    auto fail = [failure](GrOp::CombineFailure reason) {
+        if (failure) {
+            *failure = reason;
+        }
         return false;
+    };
+
+    if (SkToBool(fProcessors) != SkToBool(that.fProcessors)) {
+        return fail(GrOp::CombineFailure::kProcessors);
     }
     if (fProcessors) {
         if (*fProcessors != *that.fProcessors) {
-            return false;
+            return fail(GrOp::CombineFailure::kProcessors);
         }
     }
 
@@ -58,11 +66,15 @@ bool GrSimpleMeshDrawOpHelper::isCompatible(const GrSimpleMeshDrawOpHelper& that
     }
 #endif
 
-    bool result = fPipelineFlags == that.fPipelineFlags &&
-                  (ignoreAAType || fAAType == that.fAAType);
-    SkASSERT(!result || fCompatibleWithCoverageAsAlpha == that.fCompatibleWithCoverageAsAlpha);
-    SkASSERT(!result || fUsesLocalCoords == that.fUsesLocalCoords);
-    return result;
+    if (fPipelineFlags != that.fPipelineFlags) {
+        return fail(GrOp::CombineFailure::kPipelineFlags);
+    }
+    if (!ignoreAAType && fAAType != that.fAAType) {
+        return fail(GrOp::CombineFailure::kAAType);
+    }
+    SkASSERT(fCompatibleWithCoverageAsAlpha == that.fCompatibleWithCoverageAsAlpha);
+    SkASSERT(fUsesLocalCoords == that.fUsesLocalCoords);
+    return true;
 }
 
 GrProcessorSet::Analysis GrSimpleMeshDrawOpHelper::finalizeProcessors(
@@ -53,9 +53,11 @@ public:
 
     GrDrawOp::FixedFunctionFlags fixedFunctionFlags() const;
 
-    // ignoreAAType should be set to true if the op already knows the AA settings are acceptible
+    // ignoreAAType should be set to true if the op already knows the AA settings are acceptible.
+    // If the helpers are not compatible and 'failure' is non-null, it is set to the reason.
     bool isCompatible(const GrSimpleMeshDrawOpHelper& that, const GrCaps&, const SkRect& thisBounds,
-                      const SkRect& thatBounds, bool ignoreAAType = false) const;
+                      const SkRect& thatBounds, bool ignoreAAType = false,
+                      GrOp::CombineFailure* failure = nullptr) const;
 
     /**
      * Finalizes the processor set and determines whether the destination must be provided
@@ -37,9 +37,18 @@ GrProcessorSet::Analysis GrSimpleMeshDrawOpHelperWithStencil::finalizeProcessors
 
 bool GrSimpleMeshDrawOpHelperWithStencil::isCompatible(
         const GrSimpleMeshDrawOpHelperWithStencil& that, const GrCaps& caps,
-        const SkRect& thisBounds, const SkRect& thatBounds, bool ignoreAAType) const {
-    return INHERITED::isCompatible(that, caps, thisBounds, thatBounds, ignoreAAType) &&
-           fStencilSettings == that.fStencilSettings;
+        const SkRect& thisBounds, const SkRect& thatBounds, bool ignoreAAType,
+        GrOp::CombineFailure* failure) const {
+    if (!INHERITED::isCompatible(that, caps, thisBounds, thatBounds, ignoreAAType, failure)) {
+        return false;
+    }
+    if (fStencilSettings != that.fStencilSettings) {
+        if (failure) {
+            *failure = GrOp::CombineFailure::kStencil;
+        }
+        return false;
+    }
+    return true;
 }
 
 GrProgramInfo* GrSimpleMeshDrawOpHelperWithStencil::createProgramInfoWithStencil(
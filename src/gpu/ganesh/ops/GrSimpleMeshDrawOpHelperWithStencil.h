@@ -68,7 +68,8 @@ public:
 
     bool isCompatible(const GrSimpleMeshDrawOpHelperWithStencil& that, const GrCaps&,
                       const SkRect& thisBounds, const SkRect& thatBounds,
-                      bool ignoreAAType = false) const;
+                      bool ignoreAAType = false,
+                      GrOp::CombineFailure* failure = nullptr) const;
 
 #if GR_TEST_UTILS
     SkString dumpInfo() const;
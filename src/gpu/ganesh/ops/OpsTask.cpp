@@ -14,6 +14,8 @@
 #include "src/gpu/ganesh/GrAttachment.h"
 #include "src/gpu/ganesh/GrAuditTrail.h"
 #include "src/gpu/ganesh/GrCaps.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/GrDrawingManager.h"
 #include "src/gpu/ganesh/GrGpu.h"
 #include "src/gpu/ganesh/GrMemoryPool.h"
 #include "src/gpu/ganesh/GrOpFlushState.h"
@@ -37,6 +39,46 @@ static const int kMaxOpChainDistance = 10;
 
 inline bool can_reorder(const SkRect& a, const SkRect& b) { return !GrRectsOverlap(a, b); }
 
+#if GR_GPU_STATS && GR_TEST_UTILS
+#define GR_OP_BATCHING_STAT(stats, op, field)         \
+    do {                                              \
+        if (stats) {                                  \
+            (stats)->opType((op)->name()).field++;    \
+        }                                             \
+    } while (false)
+#define GR_OP_BATCHING_FAILURE(stats, op, failure)                                              \
+    do {                                                                                      \
+        if (stats) {                                                                          \
+            using Failure = BatchingStats::Failure;                                           \
+            (stats)->opType((op)->name()).fFailures[static_cast<int>(Failure::failure)]++;    \
+        }                                                                                     \
+    } while (false)
+// Records why 'combiner' refused to combine with 'op'.
+#define GR_OP_BATCHING_COMBINE_FAILURE(stats, op, combiner)                                   \
+    do {                                                                                      \
+        if (stats) {                                                                          \
+            int failure = static_cast<int>(batching_failure((combiner)->combineFailure()));   \
+            (stats)->opType((op)->name()).fFailures[failure]++;                               \
+        }                                                                                     \
+    } while (false)
+
+GrOpBatchingStats::Failure batching_failure(GrOp::CombineFailure failure) {
+    using Failure = GrOpBatchingStats::Failure;
+    switch (failure) {
+        case GrOp::CombineFailure::kOpState:       return Failure::kOpDeclined;
+        case GrOp::CombineFailure::kProcessors:    return Failure::kDifferentProcessors;
+        case GrOp::CombineFailure::kAAType:        return Failure::kDifferentAAType;
+        case GrOp::CombineFailure::kStencil:       return Failure::kDifferentStencil;
+        case GrOp::CombineFailure::kPipelineFlags: return Failure::kDifferentPipelineFlags;
+    }
+    SkUNREACHABLE;
+}
+#else
+#define GR_OP_BATCHING_STAT(stats, op, field)
+#define GR_OP_BATCHING_FAILURE(stats, op, failure)
+#define GR_OP_BATCHING_COMBINE_FAILURE(stats, op, combiner)
+#endif
+
 GrOpsRenderPass* create_render_pass(GrGpu* gpu,
                                     GrRenderTarget* rt,
                                     bool useMSAASurface,
@@ -191,7 +233,8 @@ void OpsTask::OpChain::deleteOps() {
 // the two chains are chainable. Returns the new chain.
 OpsTask::OpChain::List OpsTask::OpChain::DoConcat(List chainA, List chainB, const GrCaps& caps,
                                                   SkArenaAlloc* opsTaskArena,
-                                                  GrAuditTrail* auditTrail) {
+                                                  GrAuditTrail* auditTrail,
+                                                  BatchingStats* batchingStats) {
     // We process ops in chain b from head to tail. We attempt to merge with nodes in a, starting
     // at chain a's tail and working toward the head. We produce one of the following outcomes:
     // 1) b's head is merged into an op in a.
@@ -225,6 +268,7 @@ OpsTask::OpChain::List OpsTask::OpChain::DoConcat(List chainA, List chainB, cons
             }
             if (merged) {
                 GR_AUDIT_TRAIL_OPS_RESULT_COMBINED(auditTrail, a, chainB.head());
+                GR_OP_BATCHING_STAT(batchingStats, chainB.head(), fMerged);
                 if (canBackwardMerge) {
                     // The GrOp::Owner releases the op.
                     chainB.popHead();
@@ -258,6 +302,7 @@ OpsTask::OpChain::List OpsTask::OpChain::DoConcat(List chainA, List chainB, cons
         // If we weren't able to merge b's head then pop b's head from chain b and make it the new
         // tail of a.
         if (!merged) {
+            GR_OP_BATCHING_STAT(batchingStats, chainB.head(), fChained);
             chainA.pushTail(chainB.popHead());
             skipBounds.joinNonEmptyArg(chainA.tail()->bounds());
         }
@@ -270,24 +315,34 @@ OpsTask::OpChain::List OpsTask::OpChain::DoConcat(List chainA, List chainB, cons
 bool OpsTask::OpChain::tryConcat(
         List* list, GrProcessorSet::Analysis processorAnalysis, const GrDstProxyView& dstProxyView,
         const GrAppliedClip* appliedClip, const SkRect& bounds, const GrCaps& caps,
-        SkArenaAlloc* opsTaskArena, GrAuditTrail* auditTrail) {
+        SkArenaAlloc* opsTaskArena, GrAuditTrail* auditTrail, BatchingStats* batchingStats) {
     SkASSERT(!fList.empty());
     SkASSERT(!list->empty());
     SkASSERT(fProcessorAnalysis.requiresDstTexture() == SkToBool(fDstProxyView.proxy()));
     SkASSERT(processorAnalysis.requiresDstTexture() == SkToBool(dstProxyView.proxy()));
-    // All returns use explicit tuple constructor rather than {a, b} to work around old GCC bug.
-    if (fList.head()->classID() != list->head()->classID() ||
-        SkToBool(fAppliedClip) != SkToBool(appliedClip) ||
-        (fAppliedClip && *fAppliedClip != *appliedClip) ||
-        (fProcessorAnalysis.requiresNonOverlappingDraws() !=
+    GR_OP_BATCHING_STAT(batchingStats, list->head(), fCandidates);
+    if (fList.head()->classID() != list->head()->classID()) {
+        GR_OP_BATCHING_FAILURE(batchingStats, list->head(), kDifferentOpType);
+        return false;
+    }
+    if (SkToBool(fAppliedClip) != SkToBool(appliedClip) ||
+        (fAppliedClip && *fAppliedClip != *appliedClip)) {
+        GR_OP_BATCHING_FAILURE(batchingStats, list->head(), kDifferentClip);
+        return false;
+    }
+    if ((fProcessorAnalysis.requiresNonOverlappingDraws() !=
                 processorAnalysis.requiresNonOverlappingDraws()) ||
-        (fProcessorAnalysis.requiresNonOverlappingDraws() &&
-                // Non-overlaping draws are only required when Ganesh will either insert a barrier,
-                // or read back a new dst texture between draws. In either case, we can neither
-                // chain nor combine overlapping Ops.
-                GrRectsTouchOrOverlap(fBounds, bounds)) ||
         (fProcessorAnalysis.requiresDstTexture() != processorAnalysis.requiresDstTexture()) ||
         (fProcessorAnalysis.requiresDstTexture() && fDstProxyView != dstProxyView)) {
+        GR_OP_BATCHING_FAILURE(batchingStats, list->head(), kDifferentDstRead);
+        return false;
+    }
+    if (fProcessorAnalysis.requiresNonOverlappingDraws() &&
+        // Non-overlaping draws are only required when Ganesh will either insert a barrier,
+        // or read back a new dst texture between draws. In either case, we can neither
+        // chain nor combine overlapping Ops.
+        GrRectsTouchOrOverlap(fBounds, bounds)) {
+        GR_OP_BATCHING_FAILURE(batchingStats, list->head(), kOverlappingDstRead);
         return false;
     }
 
@@ -301,10 +356,11 @@ bool OpsTask::OpChain::tryConcat(
                 // may also be chained together. Thus, we should only hit this on the first
                 // iteration.
                 SkASSERT(first);
+                GR_OP_BATCHING_COMBINE_FAILURE(batchingStats, list->head(), fList.tail());
                 return false;
             case GrOp::CombineResult::kMayChain:
                 fList = DoConcat(std::move(fList), std::exchange(*list, List()), caps, opsTaskArena,
-                                 auditTrail);
+                                 auditTrail, batchingStats);
                 // The above exchange cleared out 'list'. The list needs to be empty now for the
                 // loop to terminate.
                 SkASSERT(list->empty());
@@ -314,6 +370,7 @@ bool OpsTask::OpChain::tryConcat(
                           list->tail()->name(), list->tail()->uniqueID(), list->head()->name(),
                           list->head()->uniqueID());
                 GR_AUDIT_TRAIL_OPS_RESULT_COMBINED(auditTrail, fList.tail(), list->head());
+                GR_OP_BATCHING_STAT(batchingStats, list->head(), fMerged);
                 // The GrOp::Owner releases the op.
                 list->popHead();
                 break;
@@ -328,9 +385,9 @@ bool OpsTask::OpChain::tryConcat(
 }
 
 bool OpsTask::OpChain::prependChain(OpChain* that, const GrCaps& caps, SkArenaAlloc* opsTaskArena,
-                                    GrAuditTrail* auditTrail) {
+                                    GrAuditTrail* auditTrail, BatchingStats* batchingStats) {
     if (!that->tryConcat(&fList, fProcessorAnalysis, fDstProxyView, fAppliedClip, fBounds, caps,
-                         opsTaskArena, auditTrail)) {
+                         opsTaskArena, auditTrail, batchingStats)) {
         this->validate();
         // append failed
         return false;
@@ -353,7 +410,7 @@ bool OpsTask::OpChain::prependChain(OpChain* that, const GrCaps& caps, SkArenaAl
 GrOp::Owner OpsTask::OpChain::appendOp(
         GrOp::Owner op, GrProcessorSet::Analysis processorAnalysis,
         const GrDstProxyView* dstProxyView, const GrAppliedClip* appliedClip, const GrCaps& caps,
-        SkArenaAlloc* opsTaskArena, GrAuditTrail* auditTrail) {
+        SkArenaAlloc* opsTaskArena, GrAuditTrail* auditTrail, BatchingStats* batchingStats) {
     const GrDstProxyView noDstProxyView;
     if (!dstProxyView) {
         dstProxyView = &noDstProxyView;
@@ -362,7 +419,7 @@ GrOp::Owner OpsTask::OpChain::appendOp(
     SkRect opBounds = op->bounds();
     List chain(std::move(op));
     if (!this->tryConcat(&chain, processorAnalysis, *dstProxyView, appliedClip, opBounds, caps,
-                         opsTaskArena, auditTrail)) {
+                         opsTaskArena, auditTrail, batchingStats)) {
         // append failed, give the op back to the caller.
         this->validate();
         return chain.popHead();
@@ -398,6 +455,12 @@ OpsTask::OpsTask(GrDrawingManager* drawingMgr,
         , fArenas{std::move(arenas)}
           SkDEBUGCODE(, fNumClips(0)) {
     this->addTarget(drawingMgr, view.detachProxy());
+#if GR_GPU_STATS && GR_TEST_UTILS
+    BatchingStats& batchingStats = drawingMgr->getContext()->priv().opBatchingStats();
+    if (batchingStats.fEnabled) {
+        fBatchingStats = &batchingStats;
+    }
+#endif
 }
 
 void OpsTask::deleteOps() {
@@ -461,6 +524,7 @@ void OpsTask::endFlush(GrDrawingManager* drawingMgr) {
     fDeferredProxies.reset();
     fSampledProxies.reset();
     fAuditTrail = nullptr;
+    fBatchingStats = nullptr;
 
     GrRenderTask::endFlush(drawingMgr);
 }
@@ -627,6 +691,25 @@ bool OpsTask::onExecute(GrOpFlushState* flushState) {
 
     GrSurfaceProxyView dstView(sk_ref_sp(this->target(0)), fTargetOrigin, fTargetSwizzle);
 
+#if GR_GPU_STATS && GR_TEST_UTILS
+    BatchingStats& batchingStats = flushState->gpu()->getContext()->priv().opBatchingStats();
+    if (batchingStats.fEnabled) {
+        int numOps = 0;
+        for (const auto& chain : fOpChains) {
+            if (chain.shouldExecute()) {
+                batchingStats.fNumOpChainsExecuted++;
+                for (const auto& op : GrOp::ChainRange<>(chain.head())) {
+                    batchingStats.opType(op.name()).fExecuted++;
+                    numOps++;
+                }
+            }
+        }
+        if (!batchingStats.fOpsExecutedPerFlush.empty()) {
+            batchingStats.fOpsExecutedPerFlush.back() += numOps;
+        }
+    }
+#endif
+
     // Draw all the generated geometry.
     for (const auto& chain : fOpChains) {
         if (!chain.shouldExecute()) {
@@ -960,6 +1043,7 @@ void OpsTask::recordOp(
     }
 
     fUsesMSAASurface |= usesMSAA;
+    GR_OP_BATCHING_STAT(fBatchingStats, op, fRecorded);
 
     // Account for this op's bounds before we attempt to combine.
     // NOTE: The caller should have already called "op->setClippedBounds()" by now, if applicable.
@@ -985,7 +1069,7 @@ void OpsTask::recordOp(
         while (true) {
             OpChain& candidate = fOpChains.fromBack(i);
             op = candidate.appendOp(std::move(op), processorAnalysis, dstProxyView, clip, caps,
-                                    fArenas->arenaAlloc(), fAuditTrail);
+                                    fArenas->arenaAlloc(), fAuditTrail, fBatchingStats);
             if (!op) {
                 return;
             }
@@ -993,10 +1077,14 @@ void OpsTask::recordOp(
             if (!can_reorder(candidate.bounds(), op->bounds())) {
                 GrOP_INFO("\t\tBackward: Intersects with chain (%s, head opID: %u)\n",
                           candidate.head()->name(), candidate.head()->uniqueID());
+                GR_OP_BATCHING_STAT(fBatchingStats, op, fStoppedAtOverlap);
                 break;
             }
             if (++i == maxCandidates) {
                 GrOP_INFO("\t\tBackward: Reached max lookback or beginning of op array %d\n", i);
+                if (maxCandidates == kMaxOpChainDistance) {
+                    GR_OP_BATCHING_STAT(fBatchingStats, op, fStoppedAtMaxDistance);
+                }
                 break;
             }
         }
@@ -1020,7 +1108,8 @@ void OpsTask::forwardCombine(const GrCaps& caps) {
         int j = i + 1;
         while (true) {
             OpChain& candidate = fOpChains[j];
-            if (candidate.prependChain(&chain, caps, fArenas->arenaAlloc(), fAuditTrail)) {
+            if (candidate.prependChain(&chain, caps, fArenas->arenaAlloc(), fAuditTrail,
+                                       fBatchingStats)) {
                 break;
             }
             // Stop traversing if we would cause a painter's order violation.
@@ -1030,11 +1119,15 @@ void OpsTask::forwardCombine(const GrCaps& caps) {
                         "Intersects with chain (%s, head opID: %u)\n",
                         i, chain.head()->name(), chain.head()->uniqueID(), candidate.head()->name(),
                         candidate.head()->uniqueID());
+                GR_OP_BATCHING_STAT(fBatchingStats, chain.head(), fStoppedAtOverlap);
                 break;
             }
             if (++j > maxCandidateIdx) {
                 GrOP_INFO("\t\t%d: chain (%s opID: %u) -> Reached max lookahead or end of array\n",
                           i, chain.head()->name(), chain.head()->uniqueID());
+                if (maxCandidateIdx == i + kMaxOpChainDistance) {
+                    GR_OP_BATCHING_STAT(fBatchingStats, chain.head(), fStoppedAtMaxDistance);
+                }
                 break;
             }
         }
@@ -33,6 +33,7 @@ class GrClearOp;
 class GrGpuBuffer;
 class GrRenderTargetProxy;
 class OpsTaskTestingAccess;
+struct GrOpBatchingStats;
 
 namespace skgpu::v1 {
 
@@ -159,6 +160,9 @@ private:
     // resolve its texture.
     void setCannotMergeBackward() { fCannotMergeBackward = true; }
 
+    // Op batching stats are only gathered (and GrOpBatchingStats only defined) in test builds.
+    using BatchingStats = GrOpBatchingStats;
+
     class OpChain {
     public:
         OpChain(GrOp::Owner, GrProcessorSet::Analysis, GrAppliedClip*, const GrDstProxyView*);
@@ -186,14 +190,15 @@ private:
         // Attempts to move the ops from the passed chain to this chain at the head. Also attempts
         // to merge ops between the chains. Upon success the passed chain is empty.
         // Fails when the chains aren't of the same op type, have different clips or dst proxies.
-        bool prependChain(OpChain*, const GrCaps&, SkArenaAlloc* opsTaskArena, GrAuditTrail*);
+        bool prependChain(OpChain*, const GrCaps&, SkArenaAlloc* opsTaskArena, GrAuditTrail*,
+                          BatchingStats*);
 
         // Attempts to add 'op' to this chain either by merging or adding to the tail. Returns
         // 'op' to the caller upon failure, otherwise null. Fails when the op and chain aren't of
         // the same op type, have different clips or dst proxies.
         GrOp::Owner appendOp(GrOp::Owner op, GrProcessorSet::Analysis, const GrDstProxyView*,
                              const GrAppliedClip*, const GrCaps&, SkArenaAlloc* opsTaskArena,
-                             GrAuditTrail*);
+                             GrAuditTrail*, BatchingStats*);
 
         bool shouldExecute() const {
             return SkToBool(this->head());
@@ -234,8 +239,9 @@ private:
 
         bool tryConcat(List*, GrProcessorSet::Analysis, const GrDstProxyView&, const GrAppliedClip*,
                        const SkRect& bounds, const GrCaps&, SkArenaAlloc* opsTaskArena,
-                       GrAuditTrail*);
-        static List DoConcat(List, List, const GrCaps&, SkArenaAlloc* opsTaskArena, GrAuditTrail*);
+                       GrAuditTrail*, BatchingStats*);
+        static List DoConcat(List, List, const GrCaps&, SkArenaAlloc* opsTaskArena, GrAuditTrail*,
+                             BatchingStats*);
 
         List fList;
         GrProcessorSet::Analysis fProcessorAnalysis;
@@ -269,6 +275,8 @@ private:
     friend class skgpu::v1::SurfaceDrawContext;
 
     GrAuditTrail* fAuditTrail;
+    // Only set while the recording context's op batching stats are enabled.
+    BatchingStats* fBatchingStats = nullptr;
 
     bool fUsesMSAASurface;
     skgpu::Swizzle fTargetSwizzle;
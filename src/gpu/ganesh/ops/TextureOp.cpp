@@ -1008,7 +1008,7 @@ private:
         bool upgradeToCoverageAAOnMerge = false;
         if (fMetadata.aaType() != that->fMetadata.aaType()) {
             if (!CanUpgradeAAOnMerge(fMetadata.aaType(), that->fMetadata.aaType())) {
-                return CombineResult::kCannotCombine;
+                return this->cannotCombine(CombineFailure::kAAType);
             }
             upgradeToCoverageAAOnMerge = true;
         }
@@ -1048,6 +1048,9 @@ private:
                 // (in propagateCoverageAAThroughoutChain) below.
                 return CombineResult::kMayChain;
             }
+            if (fMetadata.aaType() != that->fMetadata.aaType()) {
+                return this->cannotCombine(CombineFailure::kAAType);
+            }
             return CombineResult::kCannotCombine;
         }
 
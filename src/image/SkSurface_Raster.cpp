@@ -9,6 +9,7 @@
 #include "include/core/SkCapabilities.h"
 #include "include/core/SkMallocPixelRef.h"
 #include "include/private/SkImageInfoPriv.h"
+#include "src/core/SkBitmapDevice.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkImagePriv.h"
 #include "src/image/SkSurface_Base.h"
@@ -18,7 +19,8 @@ public:
     SkSurface_Raster(const SkImageInfo&, void*, size_t rb,
                      void (*releaseProc)(void* pixels, void* context), void* context,
                      const SkSurfaceProps*);
-    SkSurface_Raster(const SkImageInfo& info, sk_sp<SkPixelRef>, const SkSurfaceProps*);
+    SkSurface_Raster(const SkImageInfo& info, sk_sp<SkPixelRef>, const SkSurfaceProps*,
+                     SkExecutor* = nullptr);
 
     SkCanvas* onNewCanvas() override;
     sk_sp<SkSurface> onNewSurface(const SkImageInfo&) override;
@@ -32,6 +34,7 @@ public:
 private:
     SkBitmap    fBitmap;
     bool        fWeOwnThePixels;
+    SkExecutor* fExecutor = nullptr;
 
     using INHERITED = SkSurface_Base;
 };
@@ -70,18 +73,26 @@ SkSurface_Raster::SkSurface_Raster(const SkImageInfo& info, void* pixels, size_t
 }
 
 SkSurface_Raster::SkSurface_Raster(const SkImageInfo& info, sk_sp<SkPixelRef> pr,
-                                   const SkSurfaceProps* props)
+                                   const SkSurfaceProps* props, SkExecutor* executor)
     : INHERITED(pr->width(), pr->height(), props)
+    , fExecutor(executor)
 {
     fBitmap.setInfo(info, pr->rowBytes());
     fBitmap.setPixelRef(std::move(pr), 0, 0);
     fWeOwnThePixels = true;
 }
 
-SkCanvas* SkSurface_Raster::onNewCanvas() { return new SkCanvas(fBitmap, this->props()); }
+SkCanvas* SkSurface_Raster::onNewCanvas() {
+    if (!fExecutor) {
+        return new SkCanvas(fBitmap, this->props());
+    }
+    auto device = sk_make_sp<SkBitmapDevice>(fBitmap, this->props());
+    device->setExecutor(fExecutor);
+    return new SkCanvas(std::move(device));
+}
 
 sk_sp<SkSurface> SkSurface_Raster::onNewSurface(const SkImageInfo& info) {
-    return SkSurface::MakeRaster(info, &this->props());
+    return SkSurface::MakeRasterThreaded(info, fExecutor, &this->props());
 }
 
 void SkSurface_Raster::onDraw(SkCanvas* canvas, SkScalar x, SkScalar y,
@@ -198,6 +209,19 @@ sk_sp<SkSurface> SkSurface::MakeRaster(const SkImageInfo& info, size_t rowBytes,
     return sk_make_sp<SkSurface_Raster>(info, std::move(pr), props);
 }
 
+sk_sp<SkSurface> SkSurface::MakeRasterThreaded(const SkImageInfo& info, SkExecutor* executor,
+                                               const SkSurfaceProps* props) {
+    if (!SkSurfaceValidateRasterInfo(info)) {
+        return nullptr;
+    }
+
+    sk_sp<SkPixelRef> pr = SkMallocPixelRef::MakeAllocate(info, 0);
+    if (!pr) {
+        return nullptr;
+    }
+    return sk_make_sp<SkSurface_Raster>(info, std::move(pr), props, executor);
+}
+
 sk_sp<SkSurface> SkSurface::MakeRasterN32Premul(int width, int height,
                                                 const SkSurfaceProps* surfaceProps) {
     return MakeRaster(SkImageInfo::MakeN32Premul(width, height), surfaceProps);
@@ -2939,7 +2939,16 @@ namespace lowp {
 
 #else  // We are compiling vector code with Clang... let's make some lowp stages!
 
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#if defined(JUMPER_IS_SKX)
+    using U8  = uint8_t  __attribute__((ext_vector_type(32)));
+    using U16 = uint16_t __attribute__((ext_vector_type(32)));
+    using I16 =  int16_t __attribute__((ext_vector_type(32)));
+    using I32 =  int32_t __attribute__((ext_vector_type(32)));
+    using U32 = uint32_t __attribute__((ext_vector_type(32)));
+    using I64 =  int64_t __attribute__((ext_vector_type(32)));
+    using U64 = uint64_t __attribute__((ext_vector_type(32)));
+    using F   = float    __attribute__((ext_vector_type(32)));
+#elif defined(JUMPER_IS_HSW)
     using U8  = uint8_t  __attribute__((ext_vector_type(16)));
     using U16 = uint16_t __attribute__((ext_vector_type(16)));
     using I16 =  int16_t __attribute__((ext_vector_type(16)));
@@ -3204,7 +3213,15 @@ SI U32 trunc_(F x) { return (U32)cast<I32>(x); }
 
 // Use approximate instructions and one Newton-Raphson step to calculate 1/x.
 SI F rcp_precise(F x) {
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#if defined(JUMPER_IS_SKX)
+    auto rcp = [](__m512 v) {
+        __m512 e = _mm512_rcp14_ps(v);
+        return _mm512_mul_ps(_mm512_fnmadd_ps(v, e, _mm512_set1_ps(2.0f)), e);
+    };
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(rcp(lo), rcp(hi));
+#elif defined(JUMPER_IS_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(SK_OPTS_NS::rcp_precise(lo), SK_OPTS_NS::rcp_precise(hi));
@@ -3221,7 +3238,11 @@ SI F rcp_precise(F x) {
 #endif
 }
 SI F sqrt_(F x) {
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#if defined(JUMPER_IS_SKX)
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(_mm512_sqrt_ps(lo), _mm512_sqrt_ps(hi));
+#elif defined(JUMPER_IS_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(_mm256_sqrt_ps(lo), _mm256_sqrt_ps(hi));
@@ -3256,7 +3277,11 @@ SI F floor_(F x) {
     float32x4_t lo,hi;
     split(x, &lo,&hi);
     return join<F>(vrndmq_f32(lo), vrndmq_f32(hi));
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#elif defined(JUMPER_IS_SKX)
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(_mm512_floor_ps(lo), _mm512_floor_ps(hi));
+#elif defined(JUMPER_IS_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
     return join<F>(_mm256_floor_ps(lo), _mm256_floor_ps(hi));
@@ -3276,7 +3301,9 @@ SI F floor_(F x) {
 // The result is a number on [-1, 1).
 // Note: on neon this is a saturating multiply while the others are not.
 SI I16 scaled_mult(I16 a, I16 b) {
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#if defined(JUMPER_IS_SKX)
+    return _mm512_mulhrs_epi16(a, b);
+#elif defined(JUMPER_IS_HSW)
     return _mm256_mulhrs_epi16(a, b);
 #elif defined(JUMPER_IS_SSE41) || defined(JUMPER_IS_AVX)
     return _mm_mulhrs_epi16(a, b);
@@ -3317,6 +3344,8 @@ STAGE_GG(seed_shader, Ctx::None) {
     static const float iota[] = {
         0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f,
         8.5f, 9.5f,10.5f,11.5f,12.5f,13.5f,14.5f,15.5f,
+       16.5f,17.5f,18.5f,19.5f,20.5f,21.5f,22.5f,23.5f,
+       24.5f,25.5f,26.5f,27.5f,28.5f,29.5f,30.5f,31.5f,
     };
     x = cast<F>(I32(dx)) + sk_unaligned_load<F>(iota);
     y = cast<F>(I32(dy)) + 0.5f;
@@ -3515,6 +3544,45 @@ SI U32 ix_and_ptr(T** ptr, const SkRasterPipeline_GatherCtx* ctx, I32 x, I32 y)
     return ay * ctx->stride + ax;
 }
 
+#if defined(JUMPER_IS_SKX)
+// AVX-512 loads and stores any partial vector with one masked instruction,
+// and masked-off lanes never fault, so we don't need to walk the tail.
+SI __mmask32 tail_mask(size_t tail) {
+    tail &= N-1;
+    return tail ? (__mmask32)((1u << tail) - 1) : (__mmask32)~0u;
+}
+
+template <typename V, typename T>
+SI V load(const T* ptr, size_t tail) {
+    static_assert(sizeof(V) == N*sizeof(T), "");
+    const __mmask32 mask = tail_mask(tail);
+    if constexpr (sizeof(T) == 1) {
+        return sk_bit_cast<V>(_mm256_maskz_loadu_epi8(mask, ptr));
+    } else if constexpr (sizeof(T) == 2) {
+        return sk_bit_cast<V>(_mm512_maskz_loadu_epi16(mask, ptr));
+    } else {
+        static_assert(sizeof(T) == 4, "");
+        return join<V>(_mm512_maskz_loadu_epi32((__mmask16)(mask      ), ptr +  0),
+                       _mm512_maskz_loadu_epi32((__mmask16)(mask >> 16), ptr + 16));
+    }
+}
+template <typename V, typename T>
+SI void store(T* ptr, size_t tail, V v) {
+    static_assert(sizeof(V) == N*sizeof(T), "");
+    const __mmask32 mask = tail_mask(tail);
+    if constexpr (sizeof(T) == 1) {
+        _mm256_mask_storeu_epi8(ptr, mask, sk_bit_cast<__m256i>(v));
+    } else if constexpr (sizeof(T) == 2) {
+        _mm512_mask_storeu_epi16(ptr, mask, sk_bit_cast<__m512i>(v));
+    } else {
+        static_assert(sizeof(T) == 4, "");
+        __m512i lo, hi;
+        split(v, &lo, &hi);
+        _mm512_mask_storeu_epi32(ptr +  0, (__mmask16)(mask      ), lo);
+        _mm512_mask_storeu_epi32(ptr + 16, (__mmask16)(mask >> 16), hi);
+    }
+}
+#else
 template <typename V, typename T>
 SI V load(const T* ptr, size_t tail) {
     V v = 0;
@@ -3563,8 +3631,39 @@ SI void store(T* ptr, size_t tail, V v) {
         case  1: ptr[ 0] = v[ 0];
     }
 }
+#endif
 
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#if defined(JUMPER_IS_SKX)
+    template <typename V, typename T>
+    SI V gather(const T* ptr, U32 ix) {
+        return V{ ptr[ix[ 0]], ptr[ix[ 1]], ptr[ix[ 2]], ptr[ix[ 3]],
+                  ptr[ix[ 4]], ptr[ix[ 5]], ptr[ix[ 6]], ptr[ix[ 7]],
+                  ptr[ix[ 8]], ptr[ix[ 9]], ptr[ix[10]], ptr[ix[11]],
+                  ptr[ix[12]], ptr[ix[13]], ptr[ix[14]], ptr[ix[15]],
+                  ptr[ix[16]], ptr[ix[17]], ptr[ix[18]], ptr[ix[19]],
+                  ptr[ix[20]], ptr[ix[21]], ptr[ix[22]], ptr[ix[23]],
+                  ptr[ix[24]], ptr[ix[25]], ptr[ix[26]], ptr[ix[27]],
+                  ptr[ix[28]], ptr[ix[29]], ptr[ix[30]], ptr[ix[31]], };
+    }
+
+    template<>
+    F gather(const float* ptr, U32 ix) {
+        __m512i lo, hi;
+        split(ix, &lo, &hi);
+
+        return join<F>(_mm512_i32gather_ps(lo, ptr, 4),
+                       _mm512_i32gather_ps(hi, ptr, 4));
+    }
+
+    template<>
+    U32 gather(const uint32_t* ptr, U32 ix) {
+        __m512i lo, hi;
+        split(ix, &lo, &hi);
+
+        return join<U32>(_mm512_i32gather_epi32(lo, ptr, 4),
+                         _mm512_i32gather_epi32(hi, ptr, 4));
+    }
+#elif defined(JUMPER_IS_HSW)
     template <typename V, typename T>
     SI V gather(const T* ptr, U32 ix) {
         return V{ ptr[ix[ 0]], ptr[ix[ 1]], ptr[ix[ 2]], ptr[ix[ 3]],
@@ -3602,7 +3701,8 @@ SI void store(T* ptr, size_t tail, V v) {
 // ~~~~~~ 32-bit memory loads and stores ~~~~~~ //
 
 SI void from_8888(U32 rgba, U16* r, U16* g, U16* b, U16* a) {
-#if 1 && defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+// (On SKX, cast<U16>() is a single vpmovdw per 16 lanes, with no lane crossing to undo.)
+#if 1 && defined(JUMPER_IS_HSW)
     // Swap the middle 128-bit lanes to make _mm256_packus_epi32() in cast_U16() work out nicely.
     __m256i _01,_23;
     split(rgba, &_01, &_23);
@@ -4082,7 +4182,26 @@ SI void gradient_lookup(const SkRasterPipeline_GradientCtx* c, U32 idx, F t,
                         U16* r, U16* g, U16* b, U16* a) {
 
     F fr, fg, fb, fa, br, bg, bb, ba;
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_SKX)
+#if defined(JUMPER_IS_SKX)
+    if (c->stopCount <= 16) {
+        __m512i lo, hi;
+        split(idx, &lo, &hi);
+
+        auto lookup = [&](const float* table) {
+            __m512 t = _mm512_loadu_ps(table);
+            return join<F>(_mm512_permutexvar_ps(lo, t),
+                           _mm512_permutexvar_ps(hi, t));
+        };
+        fr = lookup(c->fs[0]);
+        br = lookup(c->bs[0]);
+        fg = lookup(c->fs[1]);
+        bg = lookup(c->bs[1]);
+        fb = lookup(c->fs[2]);
+        bb = lookup(c->bs[2]);
+        fa = lookup(c->fs[3]);
+        ba = lookup(c->bs[3]);
+    } else
+#elif defined(JUMPER_IS_HSW)
     if (c->stopCount <=8) {
         __m256i lo, hi;
         split(idx, &lo, &hi);
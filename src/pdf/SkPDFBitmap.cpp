@@ -282,11 +282,17 @@ SkPDFIndirectReference SkPDFSerializeImage(const SkImage* img,
     SkPDFIndirectReference ref = doc->reserveRef();
     if (SkExecutor* executor = doc->executor()) {
         SkRef(img);
-        doc->incrementJobCount();
-        executor->add([img, encodingQuality, doc, ref]() {
+        // Unless its JPEG data can be passed through, the job decodes the image; count the
+        // larger of its encoded data and its pixels against the document's pending budget.
+        size_t pendingBytes = img->imageInfo().computeMinByteSize();
+        if (sk_sp<SkData> data = img->refEncodedData()) {
+            pendingBytes = std::max(pendingBytes, data->size());
+        }
+        doc->incrementJobCount(pendingBytes);
+        executor->add([img, encodingQuality, doc, ref, pendingBytes]() {
             serialize_image(img, encodingQuality, doc, ref);
             SkSafeUnref(img);
-            doc->signalJobComplete();
+            doc->signalJobComplete(pendingBytes);
         });
         return ref;
     }
@@ -608,9 +608,20 @@ void SkPDFDocument::onClose(SkWStream* stream) {
     }
 }
 
-void SkPDFDocument::incrementJobCount() { fJobCount++; }
+void SkPDFDocument::incrementJobCount(size_t pendingBytes) {
+    // Every semaphore signal we consume here is one fewer for waitForJobs() to wait on.
+    while (fPendingJobBytes.load() > kMaxPendingJobBytes && fJobCount > 0) {
+        fSemaphore.wait();
+        --fJobCount;
+    }
+    fPendingJobBytes += pendingBytes;
+    fJobCount++;
+}
 
-void SkPDFDocument::signalJobComplete() { fSemaphore.signal(); }
+void SkPDFDocument::signalJobComplete(size_t pendingBytes) {
+    fPendingJobBytes -= pendingBytes;
+    fSemaphore.signal();
+}
 
 void SkPDFDocument::waitForJobs() {
      // fJobCount can increase while we wait.
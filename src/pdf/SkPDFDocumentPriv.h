@@ -133,8 +133,12 @@ public:
     SkString nextFontSubsetTag();
 
     SkExecutor* executor() const { return fExecutor; }
-    void incrementJobCount();
-    void signalJobComplete();
+    // Call before handing a job to executor(), from the thread using the document.
+    // pendingBytes is the memory the job holds until it completes; once the jobs
+    // in flight hold more than kMaxPendingJobBytes, this waits for some to finish.
+    void incrementJobCount(size_t pendingBytes = 0);
+    // Call from the job when it completes, with the same pendingBytes.
+    void signalJobComplete(size_t pendingBytes = 0);
     size_t currentPageIndex() { return fPages.size(); }
     size_t pageCount() { return fPageRefs.size(); }
 
@@ -167,6 +171,8 @@ private:
     sk_sp<SkPDFDevice> fPageDevice;
     std::atomic<int> fNextObjectNumber = {1};
     std::atomic<int> fJobCount = {0};
+    std::atomic<size_t> fPendingJobBytes = {0};
+    static constexpr size_t kMaxPendingJobBytes = 64 << 20;
     uint32_t fNextFontSubsetTag = {0};
     SkUUID fUUID;
     SkPDFIndirectReference fInfoDict;
@@ -7,6 +7,7 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontMetrics.h"
 #include "include/core/SkFontTypes.h"
@@ -294,6 +295,35 @@ static sk_sp<SkData> stream_to_data(std::unique_ptr<SkStreamAsset> stream) {
     return SkData::MakeFromStream(stream.get(), size);
 }
 
+// Emits the (subset, if possible) TrueType font program in fontData into ref.
+static void emit_font_file2(const SkPDFFont& font,
+                            const SkAdvancedTypefaceMetrics& metrics,
+                            sk_sp<SkData> fontData,
+                            int ttcIndex,
+                            SkPDFDocument* doc,
+                            SkPDFIndirectReference ref) {
+    SkASSERT(fontData && fontData->size() > 0);
+    if (!SkToBool(metrics.fFlags & SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
+        SkASSERT(font.firstGlyphID() == 1);
+        sk_sp<SkData> subsetFontData = SkPDFSubsetFont(
+                fontData, font.glyphUsage(),
+                doc->metadata().fSubsetter,
+                metrics.fFontName.c_str(), ttcIndex);
+        if (subsetFontData) {
+            std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
+            tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
+            SkPDFSerializeStream(std::move(tmp), SkMemoryStream::Make(std::move(subsetFontData)),
+                                 doc, ref, true);
+            return;
+        }
+        // If subsetting fails, fall back to original font data.
+    }
+    std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
+    tmp->insertInt("Length1", SkToInt(fontData->size()));
+    SkPDFSerializeStream(std::move(tmp), SkMemoryStream::Make(std::move(fontData)), doc, ref,
+                         true);
+}
+
 static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     const SkAdvancedTypefaceMetrics* metricsPtr =
         SkPDFFont::GetMetrics(font.typeface(), doc);
@@ -319,34 +349,28 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     } else {
         switch (type) {
             case SkAdvancedTypefaceMetrics::kTrueType_Font: {
-                if (!SkToBool(metrics.fFlags &
-                              SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
-                    SkASSERT(font.firstGlyphID() == 1);
-                    sk_sp<SkData> subsetFontData = SkPDFSubsetFont(
-                            stream_to_data(std::move(fontAsset)), font.glyphUsage(),
-                            doc->metadata().fSubsetter,
-                            metrics.fFontName.c_str(), ttcIndex);
-                    if (subsetFontData) {
-                        std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
-                        tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
-                        descriptor->insertRef(
-                                "FontFile2",
-                                SkPDFStreamOut(std::move(tmp),
-                                               SkMemoryStream::Make(std::move(subsetFontData)),
-                                               doc, true));
-                        break;
-                    }
-                    // If subsetting fails, fall back to original font data.
-                    fontAsset = face->openStream(&ttcIndex);
-                    SkASSERT(fontAsset);
-                    SkASSERT(fontAsset->getLength() == fontSize);
-                    if (!fontAsset || fontAsset->getLength() == 0) { break; }
+                SkPDFIndirectReference fontFileRef = doc->reserveRef();
+                descriptor->insertRef("FontFile2", fontFileRef);
+                // Hold on to the whole font, so that the font file can fall back to it if
+                // subsetting fails. It's never empty, so fontFileRef is always a real font.
+                sk_sp<SkData> fontData = stream_to_data(std::move(fontAsset));
+                if (SkExecutor* executor = doc->executor()) {
+                    // Subsetting dominates closing a document with many fonts, so do it in
+                    // parallel. fFontMap is no longer modified once onClose() emits fonts, so
+                    // font outlives the job, as does metrics, which fTypefaceMetrics owns.
+                    const SkPDFFont* fontPtr = &font;
+                    const size_t pendingBytes = fontData->size();
+                    doc->incrementJobCount(pendingBytes);
+                    executor->add([fontPtr, metricsPtr, fontData, ttcIndex, doc, fontFileRef,
+                                   pendingBytes]() mutable {
+                        emit_font_file2(*fontPtr, *metricsPtr, std::move(fontData), ttcIndex,
+                                        doc, fontFileRef);
+                        doc->signalJobComplete(pendingBytes);
+                    });
+                } else {
+                    emit_font_file2(font, metrics, std::move(fontData), ttcIndex,
+                                    doc, fontFileRef);
                 }
-                std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
-                tmp->insertInt("Length1", fontSize);
-                descriptor->insertRef("FontFile2",
-                                      SkPDFStreamOut(std::move(tmp), std::move(fontAsset),
-                                                     doc, true));
                 break;
             }
             case SkAdvancedTypefaceMetrics::kType1CID_Font: {
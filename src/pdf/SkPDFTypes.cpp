@@ -583,17 +583,28 @@ SkPDFIndirectReference SkPDFStreamOut(std::unique_ptr<SkPDFDict> dict,
     if (SkExecutor* executor = doc->executor()) {
         SkPDFDict* dictPtr = dict.release();
         SkStreamAsset* contentPtr = content.release();
+        // The uncompressed content stays in memory until the job runs; count it against
+        // the document's budget for pending jobs.
+        const size_t pendingBytes = contentPtr->getLength();
         // Pass ownership of both pointers into a std::function, which should
         // only be executed once.
-        doc->incrementJobCount();
-        executor->add([dictPtr, contentPtr, deflate, doc, ref]() {
+        doc->incrementJobCount(pendingBytes);
+        executor->add([dictPtr, contentPtr, deflate, doc, ref, pendingBytes]() {
             serialize_stream(dictPtr, contentPtr, deflate, doc, ref);
             delete dictPtr;
             delete contentPtr;
-            doc->signalJobComplete();
+            doc->signalJobComplete(pendingBytes);
         });
         return ref;
     }
     serialize_stream(dict.get(), content.get(), deflate, doc, ref);
     return ref;
 }
+
+void SkPDFSerializeStream(std::unique_ptr<SkPDFDict> dict,
+                          std::unique_ptr<SkStreamAsset> content,
+                          SkPDFDocument* doc,
+                          SkPDFIndirectReference ref,
+                          bool deflate) {
+    serialize_stream(dict.get(), content.get(), deflate, doc, ref);
+}
@@ -209,4 +209,12 @@ SkPDFIndirectReference SkPDFStreamOut(std::unique_ptr<SkPDFDict> dict,
                                       std::unique_ptr<SkStreamAsset> stream,
                                       SkPDFDocument* doc,
                                       bool deflate = kSkPDFDefaultDoDeflate);
+
+// Like SkPDFStreamOut(), but always serializes on the calling thread, into a reference already
+// reserved with SkPDFDocument::reserveRef(). For use by jobs running on the document's executor.
+void SkPDFSerializeStream(std::unique_ptr<SkPDFDict> dict,
+                          std::unique_ptr<SkStreamAsset> stream,
+                          SkPDFDocument* doc,
+                          SkPDFIndirectReference ref,
+                          bool deflate = kSkPDFDefaultDoDeflate);
 #endif
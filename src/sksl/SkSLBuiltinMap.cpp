@@ -9,9 +9,11 @@
 #include "include/private/SkSLProgramElement.h"
 #include "include/private/SkSLStatement.h"
 #include "src/sksl/SkSLBuiltinMap.h"
+#include "src/sksl/SkSLModuleImage.h"
 #include "src/sksl/ir/SkSLFunctionDeclaration.h"
 #include "src/sksl/ir/SkSLFunctionDefinition.h"
 #include "src/sksl/ir/SkSLInterfaceBlock.h"
+#include "src/sksl/ir/SkSLSymbolTable.h"
 #include "src/sksl/ir/SkSLVarDeclarations.h"
 #include "src/sksl/ir/SkSLVariable.h"
 
@@ -62,6 +64,19 @@ BuiltinMap::BuiltinMap(const BuiltinMap* parent,
     }
 }
 
+BuiltinMap::~BuiltinMap() {
+    if (fImage) {
+        fSymbolTable->setLazySymbolSource(nullptr);
+    }
+}
+
+void BuiltinMap::setModuleImage(std::unique_ptr<ModuleImage> image) {
+    SkASSERT(!fImage);
+    fImage = std::move(image);
+    fImage->attachTo(this);
+    fSymbolTable->setLazySymbolSource(fImage.get());
+}
+
 void BuiltinMap::insertOrDie(const Symbol* symbol, std::unique_ptr<ProgramElement> element) {
     SkASSERT(!fElements.find(symbol));
     fElements.set(symbol, std::move(element));
@@ -71,6 +86,11 @@ const ProgramElement* BuiltinMap::find(const Symbol* symbol) const {
     if (std::unique_ptr<ProgramElement>* elem = fElements.find(symbol)) {
         return elem->get();
     }
+    if (fImage) {
+        if (const ProgramElement* elem = fImage->find(symbol)) {
+            return elem;
+        }
+    }
     return fParent ? fParent->find(symbol) : nullptr;
 }
 
@@ -78,6 +98,9 @@ void BuiltinMap::foreach(const std::function<void(const Symbol*,const ProgramEle
     fElements.foreach([&](const Symbol* symbol, const std::unique_ptr<ProgramElement>& elem) {
         fn(symbol, *elem);
     });
+    if (fImage) {
+        fImage->foreach(fn);
+    }
     if (fParent) {
         fParent->foreach(fn);
     }
@@ -17,6 +17,7 @@
 
 namespace SkSL {
 
+class ModuleImage;
 class Symbol;
 class SymbolTable;
 
@@ -29,6 +30,14 @@ public:
                std::shared_ptr<SymbolTable> symbolTable,
                SkSpan<std::unique_ptr<ProgramElement>> elements);
 
+    ~BuiltinMap();
+
+    /**
+     * Attaches the module's not-yet-compiled functions. They are added to the symbol table (and to
+     * this map) the first time their name is looked up.
+     */
+    void setModuleImage(std::unique_ptr<ModuleImage> image);
+
     void insertOrDie(const Symbol* key, std::unique_ptr<ProgramElement> element);
 
     const ProgramElement* find(const Symbol* key) const;
@@ -41,6 +50,7 @@ private:
     const BuiltinMap* fParent = nullptr;
     std::shared_ptr<SymbolTable> fSymbolTable;
     SkTHashMap<const Symbol*, std::unique_ptr<ProgramElement>> fElements;
+    std::unique_ptr<ModuleImage> fImage;
 };
 
 } // namespace SkSL
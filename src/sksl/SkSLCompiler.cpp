@@ -10,9 +10,11 @@
 #include "include/core/SkSpan.h"
 #include "include/private/SkSLDefines.h"
 #include "include/private/SkSLSymbol.h"
+#include "include/private/SkTo.h"
 #include "include/sksl/DSLCore.h"
 #include "include/sksl/DSLModifiers.h"
 #include "include/sksl/DSLType.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/sksl/SkSLAnalysis.h"
 #include "src/sksl/SkSLBuiltinMap.h"
@@ -36,6 +38,7 @@
 #include "src/sksl/ir/SkSLVariableReference.h"
 #include "src/sksl/transform/SkSLTransform.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <memory>
@@ -170,7 +173,6 @@ LoadedModule Compiler::compileModule(ProgramKind kind,
                                      ModifiersPool& modifiersPool,
                                      bool shouldInline) {
     SkASSERT(base);
-    SkASSERT(!moduleSource.empty());
     SkASSERT(this->errorCount() == 0);
 
     // Modules are shared and cannot rely on shader caps.
@@ -253,6 +255,42 @@ std::unique_ptr<Program> Compiler::convertProgram(ProgramKind kind,
     return Parser(this, settings, kind, std::move(text)).program();
 }
 
+std::vector<std::unique_ptr<Program>> Compiler::ConvertPrograms(
+        SkExecutor& executor,
+        const ShaderCaps* caps,
+        ProgramKind kind,
+        SkSpan<const std::string> sources,
+        const ProgramSettings& settings,
+        std::vector<std::string>* errors) {
+    TRACE_EVENT0("skia.shaders", "SkSL::Compiler::ConvertPrograms");
+
+    // Each task converts a run of programs, so the cost of creating its Compiler is shared.
+    static constexpr int kProgramsPerTask = 8;
+
+    const int count = SkToInt(sources.size());
+    std::vector<std::unique_ptr<Program>> programs(count);
+    if (errors) {
+        errors->assign(count, std::string());
+    }
+
+    // Load the module up front, rather than having every task wait on the first one to do so.
+    Compiler(caps).moduleForProgramKind(kind);
+
+    SkTaskGroup taskGroup(executor);
+    taskGroup.batch((count + kProgramsPerTask - 1) / kProgramsPerTask, [&](int task) {
+        Compiler compiler(caps);
+        const int end = std::min(count, (task + 1) * kProgramsPerTask);
+        for (int index = task * kProgramsPerTask; index < end; ++index) {
+            programs[index] = compiler.convertProgram(kind, sources[index], settings);
+            if (!programs[index] && errors) {
+                (*errors)[index] = compiler.errorText();
+            }
+        }
+    });
+    taskGroup.wait();
+    return programs;
+}
+
 std::unique_ptr<Expression> Compiler::convertIdentifier(Position pos, std::string_view name) {
     const Symbol* result = fSymbolTable->find(name);
     if (!result) {
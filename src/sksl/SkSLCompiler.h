@@ -9,6 +9,7 @@
 #define SKSL_COMPILER
 
 #include "include/core/SkSize.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkSLProgramElement.h"
 #include "include/private/SkSLProgramKind.h"
@@ -37,6 +38,8 @@
 #define SK_POSITION_BUILTIN                0
 #define SK_POINTSIZE_BUILTIN               1
 
+class SkExecutor;
+
 namespace SkSL {
 
 namespace dsl {
@@ -138,6 +141,21 @@ public:
                                             std::string text,
                                             ProgramSettings settings);
 
+    /**
+     * Converts each of `sources` into a Program, spreading the work across `executor`. Every task
+     * compiles on a Compiler of its own, so the programs share nothing but the built-in modules,
+     * which are safe to use from many threads at once. Returns one Program per source, in order;
+     * a source which fails to compile yields null, and its error text is stored at the same index
+     * of `errors` (if non-null). The caps, and any fExternalFunctions, must be safe to share.
+     */
+    static std::vector<std::unique_ptr<Program>> ConvertPrograms(
+            SkExecutor& executor,
+            const ShaderCaps* caps,
+            ProgramKind kind,
+            SkSpan<const std::string> sources,
+            const ProgramSettings& settings,
+            std::vector<std::string>* errors = nullptr);
+
     std::unique_ptr<Expression> convertIdentifier(Position pos, std::string_view name);
 
     bool toSPIRV(Program& program, OutputStream& out);
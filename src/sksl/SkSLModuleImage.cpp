@@ -0,0 +1,200 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/sksl/SkSLModuleImage.h"
+
+#include "include/core/SkTypes.h"
+#include "src/sksl/SkSLBuiltinMap.h"
+#include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLLexer.h"
+#include "src/sksl/SkSLModuleLoader.h"
+#include "src/sksl/SkSLThreadContext.h"
+#include "src/sksl/SkSLUtil.h"
+#include "src/sksl/ir/SkSLFunctionDeclaration.h"
+#include "src/sksl/ir/SkSLFunctionDefinition.h"
+
+#include <utility>
+
+namespace SkSL {
+
+ModuleImage::ModuleImage(ProgramKind kind, const char* moduleName)
+        : fKind(kind)
+        , fModuleName(moduleName) {}
+
+ModuleImage::~ModuleImage() = default;
+
+std::string ModuleImage::addFunctions(std::string_view moduleSource) {
+    std::string globals;
+    Lexer lexer;
+    lexer.start(moduleSource);
+
+    // We only need to find where each top-level declaration ends, and whether it declares a
+    // function. A function declaration is the first `identifier identifier (` at the top level,
+    // before any initializer; everything else is a global variable or an interface block.
+    int32_t declStart = 0;
+    int parenDepth = 0;
+    int braceDepth = 0;
+    bool hasInitializer = false;
+    std::string_view functionName;
+    Token prev, prevPrev;
+
+    auto endDeclaration = [&](int32_t declEnd) {
+        std::string_view decl = moduleSource.substr(declStart, declEnd - declStart);
+        if (functionName.empty()) {
+            globals.append(decl);
+        } else {
+            std::unique_ptr<Entry>* entry = fEntries.find(functionName);
+            if (!entry) {
+                auto newEntry = std::make_unique<Entry>();
+                newEntry->fName = functionName;
+                std::string_view key = newEntry->fName;
+                entry = fEntries.set(key, std::move(newEntry));
+            }
+            // Overloads (and a prototype followed by its definition) are kept in source order.
+            (*entry)->fSource.append(decl);
+        }
+        declStart = declEnd;
+        hasInitializer = false;
+        functionName = {};
+        prev = prevPrev = Token();
+    };
+
+    for (;;) {
+        Token token = lexer.next();
+        switch (token.fKind) {
+            case Token::Kind::TK_END_OF_FILE:
+                // Anything left over is trailing whitespace or comments.
+                return globals;
+
+            case Token::Kind::TK_WHITESPACE:
+            case Token::Kind::TK_LINE_COMMENT:
+            case Token::Kind::TK_BLOCK_COMMENT:
+                continue;
+
+            case Token::Kind::TK_LPAREN:
+                if (parenDepth == 0 && braceDepth == 0 && !hasInitializer &&
+                    functionName.empty() && prev.fKind == Token::Kind::TK_IDENTIFIER &&
+                    (prevPrev.fKind == Token::Kind::TK_IDENTIFIER ||
+                     prevPrev.fKind == Token::Kind::TK_RBRACKET)) {
+                    functionName = moduleSource.substr(prev.fOffset, prev.fLength);
+                }
+                ++parenDepth;
+                break;
+
+            case Token::Kind::TK_RPAREN:
+                --parenDepth;
+                break;
+
+            case Token::Kind::TK_EQ:
+                hasInitializer |= (parenDepth == 0 && braceDepth == 0);
+                break;
+
+            case Token::Kind::TK_LBRACE:
+                ++braceDepth;
+                break;
+
+            case Token::Kind::TK_RBRACE:
+                // A function body ends its declaration; an interface block is followed by `;`.
+                if (--braceDepth == 0 && !functionName.empty()) {
+                    endDeclaration(token.fOffset + token.fLength);
+                    continue;
+                }
+                break;
+
+            case Token::Kind::TK_SEMICOLON:
+                if (parenDepth == 0 && braceDepth == 0) {
+                    endDeclaration(token.fOffset + token.fLength);
+                    continue;
+                }
+                break;
+
+            default:
+                break;
+        }
+        prevPrev = prev;
+        prev = token;
+    }
+}
+
+Symbol* ModuleImage::lookup(std::string_view name) {
+    std::unique_ptr<Entry>* entry = fEntries.find(name);
+    if (!entry) {
+        return nullptr;
+    }
+    if (Symbol* symbol = (*entry)->fSymbol.load(std::memory_order_acquire)) {
+        return symbol;
+    }
+    return this->materialize(entry->get());
+}
+
+Symbol* ModuleImage::materialize(Entry* entry) {
+    // Materializing a function is serialized with module loading. This reenters the ModuleLoader
+    // when a function refers to another function which hasn't been materialized yet.
+    auto moduleLoader = ModuleLoader::Get();
+    if (Symbol* symbol = entry->fSymbol.load(std::memory_order_relaxed)) {
+        // Another thread materialized this function while we were waiting for the lock.
+        return symbol;
+    }
+    if (entry->fMaterializing) {
+        // We are parsing this function right now. Any existing symbol with its name must come from
+        // a parent module; e.g., the overloads which this function is about to be added to.
+        return nullptr;
+    }
+    entry->fMaterializing = true;
+
+    // The function may be looked up in the middle of compiling a program, so we set the program's
+    // ThreadContext and memory pool aside and compile it on a Compiler of its own.
+    LoadedModule module;
+    {
+        ThreadContext::AutoSuspend suspend;
+        Compiler compiler(ShaderCapsFactory::Standalone());
+        module = compiler.compileModule(fKind, fModuleName, std::move(entry->fSource), fModule,
+                                        moduleLoader.coreModifiers(), /*shouldInline=*/true);
+    }
+    Symbol* symbol = module.fSymbols->findMutable(entry->fName);
+    SkASSERT(symbol);
+
+    entry->fSymbols = std::move(module.fSymbols);
+    entry->fElements = std::move(module.fElements);
+    entry->fMaterializing = false;
+    entry->fSymbol.store(symbol, std::memory_order_release);
+    return symbol;
+}
+
+const ProgramElement* ModuleImage::find(const Symbol* symbol) const {
+    // Callers may look up a symbol which doesn't exist in this program (e.g. sk_FragColor).
+    if (!symbol || !symbol->is<FunctionDeclaration>()) {
+        return nullptr;
+    }
+    const std::unique_ptr<Entry>* entry = fEntries.find(symbol->name());
+    if (!entry || !(*entry)->fSymbol.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    for (const std::unique_ptr<ProgramElement>& element : (*entry)->fElements) {
+        if (element->is<FunctionDefinition>() &&
+            &element->as<FunctionDefinition>().declaration() == symbol) {
+            return element.get();
+        }
+    }
+    return nullptr;
+}
+
+void ModuleImage::foreach(
+        const std::function<void(const Symbol*, const ProgramElement&)>& fn) const {
+    fEntries.foreach([&](std::string_view, const std::unique_ptr<Entry>& entry) {
+        if (!entry->fSymbol.load(std::memory_order_acquire)) {
+            return;
+        }
+        for (const std::unique_ptr<ProgramElement>& element : entry->fElements) {
+            if (element->is<FunctionDefinition>()) {
+                fn(&element->as<FunctionDefinition>().declaration(), *element);
+            }
+        }
+    });
+}
+
+}  // namespace SkSL
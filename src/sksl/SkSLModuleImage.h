@@ -0,0 +1,82 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SKSL_MODULEIMAGE
+#define SKSL_MODULEIMAGE
+
+#include "include/private/SkSLProgramElement.h"
+#include "include/private/SkSLProgramKind.h"
+#include "include/private/SkTHash.h"
+#include "src/sksl/ir/SkSLSymbolTable.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SkSL {
+
+class BuiltinMap;
+class Symbol;
+
+/**
+ * Holds the functions of a built-in module as unparsed SkSL, indexed by function name. A function
+ * (along with every overload that shares its name) is only parsed and optimized the first time a
+ * program looks its name up, so a program which calls a handful of intrinsics does not pay to
+ * build the rest of the module.
+ *
+ * Materialized symbols are never removed, and a materialized name is published atomically, so
+ * lookups of names that have already been materialized don't take a lock.
+ */
+class ModuleImage : public LazySymbolSource {
+public:
+    ModuleImage(ProgramKind kind, const char* moduleName);
+    ~ModuleImage() override;
+
+    /**
+     * Splits module source into top-level declarations. Function declarations are added to the
+     * image; everything else (global variables, interface blocks) is returned, in order, so that
+     * it can be compiled up front.
+     */
+    std::string addFunctions(std::string_view moduleSource);
+
+    /** The image materializes its functions on top of `module`, which must own this image. */
+    void attachTo(const BuiltinMap* module) { fModule = module; }
+
+    Symbol* lookup(std::string_view name) override;
+
+    /** Returns the definition of a function which has already been materialized, if any. */
+    const ProgramElement* find(const Symbol* symbol) const;
+
+    /** Calls `fn` for every element that has been materialized so far. */
+    void foreach(const std::function<void(const Symbol*, const ProgramElement&)>& fn) const;
+
+private:
+    struct Entry {
+        std::string fName;
+        std::string fSource;
+        // Set, with release semantics, once fSymbols and fElements are complete.
+        std::atomic<Symbol*> fSymbol{nullptr};
+        bool fMaterializing = false;
+        std::shared_ptr<SymbolTable> fSymbols;
+        std::vector<std::unique_ptr<ProgramElement>> fElements;
+    };
+
+    Symbol* materialize(Entry* entry);
+
+    const ProgramKind fKind;
+    const char* fModuleName;
+    const BuiltinMap* fModule = nullptr;
+    // Keys point into Entry::fName. The map is not modified once the module has been loaded.
+    SkTHashMap<std::string_view, std::unique_ptr<Entry>> fEntries;
+};
+
+}  // namespace SkSL
+
+#endif
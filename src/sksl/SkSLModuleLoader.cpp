@@ -14,6 +14,7 @@
 #include "src/sksl/SkSLBuiltinTypes.h"
 #include "src/sksl/SkSLCompiler.h"
 #include "src/sksl/SkSLModifiersPool.h"
+#include "src/sksl/SkSLModuleImage.h"
 #include "src/sksl/SkSLModuleLoader.h"
 #include "src/sksl/ir/SkSLSymbolTable.h"
 #include "src/sksl/ir/SkSLType.h"
@@ -164,12 +165,23 @@ ModuleLoader ModuleLoader::Get() {
     return ModuleLoader(*sModuleLoaderImpl);
 }
 
-ModuleLoader::ModuleLoader(ModuleLoader::Impl& m) : fModuleLoader(m) {
-    fModuleLoader.fMutex.acquire();
+// Set while the current thread holds the ModuleLoader mutex.
+static thread_local bool sHoldsModuleLoaderMutex = false;
+
+ModuleLoader::ModuleLoader(ModuleLoader::Impl& m)
+        : fModuleLoader(m)
+        , fOwnsMutex(!sHoldsModuleLoaderMutex) {
+    if (fOwnsMutex) {
+        fModuleLoader.fMutex.acquire();
+        sHoldsModuleLoaderMutex = true;
+    }
 }
 
 ModuleLoader::~ModuleLoader() {
-    fModuleLoader.fMutex.release();
+    if (fOwnsMutex) {
+        sHoldsModuleLoaderMutex = false;
+        fModuleLoader.fMutex.release();
+    }
 }
 
 void ModuleLoader::unloadModules() {
@@ -235,9 +247,16 @@ static std::unique_ptr<BuiltinMap> compile_to_builtin_map(SkSL::Compiler* compil
                                                           std::string moduleSource,
                                                           const BuiltinMap* parent,
                                                           ModifiersPool& modifiersPool) {
-    return compiler->compileModule(kind, moduleName, std::move(moduleSource),
-                                   parent, modifiersPool, /*shouldInline=*/true)
-                   .convertToBuiltinMap(parent);
+    // Set the module's functions aside in an image, to be compiled on first use, and compile its
+    // global variables and interface blocks right away.
+    auto image = std::make_unique<ModuleImage>(kind, moduleName);
+    std::string globals = image->addFunctions(moduleSource);
+    std::unique_ptr<BuiltinMap> module =
+            compiler->compileModule(kind, moduleName, std::move(globals),
+                                    parent, modifiersPool, /*shouldInline=*/true)
+                    .convertToBuiltinMap(parent);
+    module->setModuleImage(std::move(image));
+    return module;
 }
 
 const BuiltinTypes& ModuleLoader::builtinTypes() {
@@ -25,13 +25,16 @@ class ModuleLoader {
 private:
     struct Impl;
     Impl& fModuleLoader;
+    bool fOwnsMutex;
 
 public:
     ModuleLoader(ModuleLoader::Impl&);
     ~ModuleLoader();
 
     // Acquires a mutex-locked reference to the singleton ModuleLoader. When the ModuleLoader is
-    // allowed to fall out of scope, the mutex will be released.
+    // allowed to fall out of scope, the mutex will be released. A thread which already holds the
+    // mutex may call Get() again; built-in functions are materialized this way while a module or
+    // another built-in function is being compiled.
     static ModuleLoader Get();
 
     // The built-in types and root module are universal, immutable, and shared by every Compiler.
@@ -47,7 +50,8 @@ public:
     ModifiersPool& coreModifiers();
 
     // These modules are loaded on demand; once loaded, they are kept for the lifetime of the
-    // process.
+    // process. Only a module's global variables are compiled when it is loaded; each of its
+    // functions is compiled the first time a program looks up its name.
     const BuiltinMap* loadSharedModule(SkSL::Compiler* compiler);
     const BuiltinMap* loadGPUModule(SkSL::Compiler* compiler);
     const BuiltinMap* loadVertexModule(SkSL::Compiler* compiler);
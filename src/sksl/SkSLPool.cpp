@@ -120,4 +120,13 @@ void Pool::FreeMemory(void* ptr) {
     ::operator delete(ptr);
 }
 
+AutoDetachPoolFromThread::AutoDetachPoolFromThread() : fMemPool(get_thread_local_memory_pool()) {
+    set_thread_local_memory_pool(nullptr);
+}
+
+AutoDetachPoolFromThread::~AutoDetachPoolFromThread() {
+    SkASSERT(get_thread_local_memory_pool() == nullptr);
+    set_thread_local_memory_pool(fMemPool);
+}
+
 }  // namespace SkSL
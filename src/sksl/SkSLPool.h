@@ -90,6 +90,18 @@ private:
     Pool* fPool = nullptr;
 };
 
+/**
+ * Temporarily detaches whichever pool is attached to the current thread (if any) within a scope.
+ * Allocations made inside the scope use the system allocator, so they can outlive the pool.
+ */
+class AutoDetachPoolFromThread {
+public:
+    AutoDetachPoolFromThread();
+    ~AutoDetachPoolFromThread();
+
+private:
+    MemoryPool* fMemPool;
+};
 
 }  // namespace SkSL
 
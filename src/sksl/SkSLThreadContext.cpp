@@ -132,4 +132,13 @@ void ThreadContext::SetInstance(std::unique_ptr<ThreadContext> newInstance) {
     instance = newInstance.release();
 }
 
+ThreadContext::AutoSuspend::AutoSuspend() : fSuspended(instance) {
+    instance = nullptr;
+}
+
+ThreadContext::AutoSuspend::~AutoSuspend() {
+    SkASSERT(instance == nullptr);
+    instance = fSuspended;
+}
+
 } // namespace SkSL
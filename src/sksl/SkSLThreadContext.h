@@ -12,6 +12,7 @@
 #include "include/private/SkSLProgramKind.h"
 #include "include/sksl/SkSLErrorReporter.h"
 #include "src/sksl/SkSLContext.h"
+#include "src/sksl/SkSLPool.h"
 #include "src/sksl/SkSLProgramSettings.h"
 #include "src/sksl/ir/SkSLProgram.h"
 
@@ -24,7 +25,6 @@ namespace SkSL {
 class BuiltinMap;
 class Compiler;
 class ModifiersPool;
-class Pool;
 class Position;
 class ProgramElement;
 class SymbolTable;
@@ -147,6 +147,21 @@ public:
 
     static void SetInstance(std::unique_ptr<ThreadContext> instance);
 
+    /**
+     * Detaches the current thread's ThreadContext and memory pool (if any) for the lifetime of this
+     * object, so that an unrelated compilation can start a ThreadContext of its own. This is used
+     * to materialize built-in functions in the middle of compiling a program.
+     */
+    class AutoSuspend {
+    public:
+        AutoSuspend();
+        ~AutoSuspend();
+
+    private:
+        ThreadContext* fSuspended;
+        AutoDetachPoolFromThread fDetachPool;
+    };
+
 private:
     class DefaultErrorReporter : public ErrorReporter {
         void handleError(std::string_view msg, Position pos) override;
@@ -31,6 +31,13 @@ Symbol* SymbolTable::lookup(const SymbolKey& key) const {
         return *symbolPPtr;
     }
 
+    // Symbols which have not been materialized yet are created on demand.
+    if (fLazySymbols) {
+        if (Symbol* symbol = fLazySymbols->lookup(key.fName)) {
+            return symbol;
+        }
+    }
+
     // The symbol wasn't found; recurse into the parent symbol table.
     return fParent ? fParent->lookup(key) : nullptr;
 }
@@ -27,6 +27,19 @@ namespace SkSL {
 
 class Type;
 
+/**
+ * Supplies symbols which are created on first lookup, rather than up front. Built-in modules use
+ * this to parse each of their functions only once a program refers to it by name. Implementations
+ * must be safe to call from multiple threads at once.
+ */
+class LazySymbolSource {
+public:
+    virtual ~LazySymbolSource() = default;
+
+    /** Returns the symbol with the given name, creating it if necessary. */
+    virtual Symbol* lookup(std::string_view name) = 0;
+};
+
 /**
  * Maps identifiers to symbols.
  */
@@ -153,6 +166,14 @@ public:
 
     const std::string* takeOwnershipOfString(std::string n);
 
+    /**
+     * Consults the passed-in source, after this table's own symbols, when a name is not found. The
+     * caller is responsible for keeping the source alive while it is attached.
+     */
+    void setLazySymbolSource(LazySymbolSource* source) {
+        fLazySymbols = source;
+    }
+
     /**
      * Indicates that this symbol table's parent is in a different module than this one.
      */
@@ -184,6 +205,7 @@ private:
 
     bool fBuiltin = false;
     bool fAtModuleBoundary = false;
+    LazySymbolSource* fLazySymbols = nullptr;
     std::forward_list<std::string> fOwnedStrings;
     SkTHashMap<SymbolKey, Symbol*, SymbolKey::Hash> fSymbols;
 };
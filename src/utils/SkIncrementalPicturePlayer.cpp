@@ -0,0 +1,130 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkIncrementalPicturePlayer.h"
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkSurface.h"
+#include "include/private/SkTemplates.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkPicturePriv.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
+
+static int64_t area(const SkIRect& r) {
+    return (int64_t)r.width() * r.height();
+}
+
+// Merges any two rects whose union costs no more pixels than redrawing them separately,
+// so that ops straddling them are replayed once rather than once per rect.
+static void coalesce(std::vector<SkIRect>* rects) {
+    for (bool merged = true; merged; ) {
+        merged = false;
+        for (size_t i = 0; i < rects->size(); i++) {
+            for (size_t j = i + 1; j < rects->size(); ) {
+                SkIRect joined = (*rects)[i];
+                joined.join((*rects)[j]);
+                if (area(joined) <= area((*rects)[i]) + area((*rects)[j])) {
+                    (*rects)[i] = joined;
+                    rects->erase(rects->begin() + j);
+                    merged = true;
+                } else {
+                    j++;
+                }
+            }
+        }
+    }
+}
+
+SkIncrementalPicturePlayer::SkIncrementalPicturePlayer(sk_sp<SkSurface> surface,
+                                                       SkColor4f clearColor)
+    : fSurface(std::move(surface))
+    , fClearColor(clearColor) {
+    SkASSERT(fSurface);
+}
+
+SkIncrementalPicturePlayer::~SkIncrementalPicturePlayer() = default;
+
+void SkIncrementalPicturePlayer::setPicture(sk_sp<SkPicture> picture) {
+    if (picture == fPicture) {
+        return;
+    }
+    fPicture = std::move(picture);
+    fBigPicture = fPicture ? SkPicturePriv::AsSkBigPicture(fPicture) : nullptr;
+    fBBH = nullptr;
+
+    if (!fBigPicture) {
+        return;
+    }
+    if (fBigPicture->bbh()) {
+        fBBH = sk_ref_sp(fBigPicture->bbh());
+        return;
+    }
+
+    // Build the same R-Tree SkPictureRecorder would have, had it been given an SkRTreeFactory.
+    const SkRecord& record = *fBigPicture->record();
+    SkAutoTMalloc<SkRect> bounds(record.count());
+    SkAutoTMalloc<SkBBoxHierarchy::Metadata> meta(record.count());
+    SkRecordFillBounds(fBigPicture->cullRect(), record, bounds, meta);
+
+    sk_sp<SkBBoxHierarchy> bbh = SkRTreeFactory()();
+    bbh->insert(bounds, meta, record.count());
+    fBBH = std::move(bbh);
+}
+
+void SkIncrementalPicturePlayer::drawInto(const SkIRect& deviceRect) {
+    SkCanvas* canvas = fSurface->getCanvas();
+    SkAutoCanvasRestore acr(canvas, true);
+    canvas->resetMatrix();
+    canvas->clipIRect(deviceRect);
+    canvas->clear(fClearColor);
+
+    if (fBigPicture) {
+        // Querying the BBH with the clip keeps this proportional to deviceRect.
+        fBigPicture->playbackWithBBH(canvas, fBBH.get());
+    } else if (fPicture) {
+        fPicture->playback(canvas);
+    }
+}
+
+void SkIncrementalPicturePlayer::draw(sk_sp<SkPicture> picture) {
+    this->setPicture(std::move(picture));
+    this->drawInto(SkIRect::MakeSize(fSurface->imageInfo().dimensions()));
+}
+
+int64_t SkIncrementalPicturePlayer::update(sk_sp<SkPicture> picture,
+                                           const SkRect dirty[], int count) {
+    if (!fPicture) {
+        this->draw(std::move(picture));
+        return area(SkIRect::MakeSize(fSurface->imageInfo().dimensions()));
+    }
+    this->setPicture(std::move(picture));
+    return this->update(dirty, count);
+}
+
+int64_t SkIncrementalPicturePlayer::update(const SkRect dirty[], int count) {
+    const SkIRect surfaceBounds = SkIRect::MakeSize(fSurface->imageInfo().dimensions());
+
+    fDamage.clear();
+    for (int i = 0; i < count; i++) {
+        // Round out so anti-aliased edges of the dirty area are redrawn too.
+        SkIRect r = dirty[i].roundOut();
+        if (r.intersect(surfaceBounds)) {
+            fDamage.push_back(r);
+        }
+    }
+    coalesce(&fDamage);
+
+    int64_t pixels = 0;
+    for (const SkIRect& r : fDamage) {
+        this->drawInto(r);
+        pixels += area(r);
+    }
+    return pixels;
+}
@@ -907,6 +907,247 @@ void Write(const Value& v, SkWStream* stream) {
     }
 }
 
+// Binary encoding (see DOM::writeBinary): a header followed by the root value, where each value
+// is a one byte type followed by its payload.  Sizes, counts and ints (zigzag) use the
+// SkWStream::writePackedUInt encoding.
+static constexpr char kBinaryMagic[] = { '\xff', 's', 'k', 'j', 's', 'o', 'n', '1' };
+
+enum BinaryType : uint8_t {
+    kBinaryNull,
+    kBinaryFalse,
+    kBinaryTrue,
+    kBinaryInt,     // packed zigzag int32
+    kBinaryFloat,   // float bits
+    kBinaryString,  // packed size, chars
+    kBinaryArray,   // packed count, values
+    kBinaryObject,  // packed count, (packed key size, key chars, value) members
+};
+
+void WriteBinaryString(const StringValue& str, SkWStream* stream) {
+    stream->writePackedUInt(str.size());
+    stream->write(str.begin(), str.size());
+}
+
+void WriteBinary(const Value& v, SkWStream* stream) {
+    switch (v.getType()) {
+    case Value::Type::kNull:
+        stream->write8(kBinaryNull);
+        break;
+    case Value::Type::kBool:
+        stream->write8(*v.as<BoolValue>() ? kBinaryTrue : kBinaryFalse);
+        break;
+    case Value::Type::kNumber: {
+        // Numbers are either int32s or floats, and round-trip through doubles exactly.
+        const auto d = *v.as<NumberValue>();
+        if (d >= std::numeric_limits<int32_t>::min() &&
+            d <= std::numeric_limits<int32_t>::max() &&
+            d == static_cast<int32_t>(d) && !(d == 0 && std::signbit(d))) {
+            const auto i = static_cast<uint32_t>(static_cast<int32_t>(d));
+            stream->write8(kBinaryInt);
+            stream->writePackedUInt((i << 1) ^ (0 - (i >> 31)));
+        } else {
+            const auto f = static_cast<float>(d);
+            stream->write8(kBinaryFloat);
+            stream->write(&f, sizeof(f));
+        }
+        break;
+    }
+    case Value::Type::kString:
+        stream->write8(kBinaryString);
+        WriteBinaryString(v.as<StringValue>(), stream);
+        break;
+    case Value::Type::kArray: {
+        const auto& array = v.as<ArrayValue>();
+        stream->write8(kBinaryArray);
+        stream->writePackedUInt(array.size());
+        for (const auto& entry : array) {
+            WriteBinary(entry, stream);
+        }
+        break;
+    }
+    case Value::Type::kObject:
+        const auto& object = v.as<ObjectValue>();
+        stream->write8(kBinaryObject);
+        stream->writePackedUInt(object.size());
+        for (const auto& member : object) {
+            WriteBinaryString(member.fKey, stream);
+            WriteBinary(member.fValue, stream);
+        }
+        break;
+    }
+}
+
+// Array/object records with uninitialized storage, filled in place by the BinaryReader (which
+// knows the element counts up front, and so doesn't need to stage them like the parser).
+class UninitializedVector final : public Value {
+public:
+    static Value MakeArray(size_t size, SkArenaAlloc& alloc, Value** data) {
+        return UninitializedVector(Tag::kArray, size, sizeof(Value), alloc,
+                                   reinterpret_cast<void**>(data));
+    }
+
+    static Value MakeObject(size_t size, SkArenaAlloc& alloc, Member** data) {
+        return UninitializedVector(Tag::kObject, size, sizeof(Member), alloc,
+                                   reinterpret_cast<void**>(data));
+    }
+
+private:
+    UninitializedVector(Tag tag, size_t size, size_t rec_size, SkArenaAlloc& alloc,
+                        void** data) {
+        // The caller has checked size against the input size.
+        auto* size_ptr = reinterpret_cast<size_t*>(
+                alloc.makeBytesAlignedTo(sizeof(size_t) + size * rec_size, kRecAlign));
+        *size_ptr = size;
+        *data = size_ptr + 1;
+        this->init_tagged_pointer(tag, size_ptr);
+    }
+};
+
+// Rebuilds a DOM from its binary encoding.  Nothing is tokenized or converted, so this is mostly
+// copying into the arena -- but the input is untrusted, and fully validated.
+class BinaryReader {
+public:
+    explicit BinaryReader(SkArenaAlloc& alloc) : fAlloc(alloc) {}
+
+    Value read(const char* data, size_t size) {
+        SkASSERT(size >= sizeof(kBinaryMagic));
+        fCurrent = data + sizeof(kBinaryMagic);
+        fEnd     = data + size;
+
+        Value root;
+        if (!this->readValue(&root, 0) || fCurrent != fEnd) {
+            return NullValue();
+        }
+
+        return root;
+    }
+
+private:
+    // Deeper inputs are rejected (they would need an unreasonable amount of stack).
+    inline static constexpr int kMaxDepth = 512;
+
+    SkArenaAlloc& fAlloc;
+    const char*   fCurrent = nullptr;
+    const char*   fEnd     = nullptr;
+
+    size_t remaining() const { return SkToSizeT(fEnd - fCurrent); }
+
+    bool readBytes(void* dst, size_t size) {
+        if (size > this->remaining()) {
+            return false;
+        }
+        memcpy(dst, fCurrent, size);
+        fCurrent += size;
+        return true;
+    }
+
+    bool readByte(uint8_t* byte) {
+        if (fCurrent == fEnd) {
+            return false;
+        }
+        *byte = static_cast<uint8_t>(*fCurrent++);
+        return true;
+    }
+
+    // Mirrors SkWStream::writePackedUInt.
+    bool readPackedUInt(uint32_t* value) {
+        uint8_t byte;
+        if (!this->readByte(&byte)) {
+            return false;
+        }
+        if (byte == 0xFE) {
+            uint16_t value16;
+            if (!this->readBytes(&value16, sizeof(value16))) {
+                return false;
+            }
+            *value = value16;
+        } else if (byte == 0xFF) {
+            return this->readBytes(value, sizeof(*value));
+        } else {
+            *value = byte;
+        }
+        return true;
+    }
+
+    bool readString(Value* dst) {
+        uint32_t size;
+        if (!this->readPackedUInt(&size) || size > this->remaining()) {
+            return false;
+        }
+        *dst = StringValue(fCurrent, size, fAlloc);
+        fCurrent += size;
+        return true;
+    }
+
+    bool readValue(Value* dst, int depth) {
+        uint8_t type;
+        if (depth > kMaxDepth || !this->readByte(&type)) {
+            return false;
+        }
+
+        switch (type) {
+        case kBinaryNull:
+            *dst = NullValue();
+            return true;
+        case kBinaryFalse:
+        case kBinaryTrue:
+            *dst = BoolValue(type == kBinaryTrue);
+            return true;
+        case kBinaryInt: {
+            uint32_t zigzag;
+            if (!this->readPackedUInt(&zigzag)) {
+                return false;
+            }
+            *dst = NumberValue(static_cast<int32_t>((zigzag >> 1) ^ (0 - (zigzag & 1))));
+            return true;
+        }
+        case kBinaryFloat: {
+            float f;
+            if (!this->readBytes(&f, sizeof(f))) {
+                return false;
+            }
+            *dst = NumberValue(f);
+            return true;
+        }
+        case kBinaryString:
+            return this->readString(dst);
+        case kBinaryArray: {
+            uint32_t count;
+            // Each value takes at least one byte.
+            if (!this->readPackedUInt(&count) || count > this->remaining()) {
+                return false;
+            }
+            Value* values;
+            *dst = UninitializedVector::MakeArray(count, fAlloc, &values);
+            for (uint32_t i = 0; i < count; ++i) {
+                if (!this->readValue(values + i, depth + 1)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case kBinaryObject: {
+            uint32_t count;
+            // Each member takes at least two bytes.
+            if (!this->readPackedUInt(&count) || count > this->remaining() / 2) {
+                return false;
+            }
+            Member* members;
+            *dst = UninitializedVector::MakeObject(count, fAlloc, &members);
+            for (uint32_t i = 0; i < count; ++i) {
+                if (!this->readString(&members[i].fKey) ||
+                    !this->readValue(&members[i].fValue, depth + 1)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+};
+
 } // namespace
 
 SkString Value::toString() const {
@@ -921,6 +1162,12 @@ static constexpr size_t kMinChunkSize = 4096;
 
 DOM::DOM(const char* data, size_t size)
     : fAlloc(kMinChunkSize) {
+    if (IsBinary(data, size)) {
+        BinaryReader reader(fAlloc);
+        fRoot = reader.read(data, size);
+        return;
+    }
+
     DOMParser parser(fAlloc);
 
     fRoot = parser.parse(data, size);
@@ -930,4 +1177,13 @@ void DOM::write(SkWStream* stream) const {
     Write(fRoot, stream);
 }
 
+void DOM::writeBinary(SkWStream* stream) const {
+    stream->write(kBinaryMagic, sizeof(kBinaryMagic));
+    WriteBinary(fRoot, stream);
+}
+
+bool DOM::IsBinary(const char* data, size_t size) {
+    return size >= sizeof(kBinaryMagic) && !memcmp(data, kBinaryMagic, sizeof(kBinaryMagic));
+}
+
 } // namespace skjson
@@ -339,12 +339,26 @@ public:
 
 class DOM final : public SkNoncopyable {
 public:
+    /**
+     * Parses JSON text, or loads the binary encoding produced by writeBinary()
+     * (recognized by its header).
+     *
+     * The root is a NullValue on errors.
+     */
     DOM(const char*, size_t);
 
     const Value& root() const { return fRoot; }
 
     void write(SkWStream*) const;
 
+    /**
+     * Writes a compact, pre-parsed encoding of the DOM, which loads faster than the equivalent
+     * JSON text (no tokenizing or number conversion).  It is not portable across endianness.
+     */
+    void writeBinary(SkWStream*) const;
+
+    static bool IsBinary(const char*, size_t);
+
 private:
     SkArenaAlloc fAlloc;
     Value        fRoot;
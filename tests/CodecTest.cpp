@@ -19,6 +19,7 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
 #include "include/core/SkEncodedImageFormat.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageEncoder.h"
 #include "include/core/SkImageGenerator.h"
@@ -52,7 +53,9 @@
 #include <png.h>
 
 #include <setjmp.h>
+#include <atomic>
 #include <cstring>
+#include <functional>
 #include <initializer_list>
 #include <memory>
 #include <utility>
@@ -1062,6 +1065,94 @@ DEF_TEST(Codec_jpeg_rewind, r) {
     REPORTER_ASSERT(r, SkCodec::kIncompleteInput == result);
 }
 
+static SkCodec::Result decode_with_executor(sk_sp<SkData> data, const SkImageInfo& info,
+                                            SkExecutor* executor, SkBitmap* bm) {
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(std::move(data));
+    if (!codec) {
+        return SkCodec::kInvalidInput;
+    }
+    bm->allocPixels(info);
+    bm->eraseColor(SK_ColorTRANSPARENT);
+    SkCodec::Options opts;
+    opts.fExecutor = executor;
+    return codec->getPixels(bm->pixmap(), &opts);
+}
+
+// Forwards work to another executor, counting how much work it was given.
+class CountingExecutor final : public SkExecutor {
+public:
+    explicit CountingExecutor(SkExecutor* executor) : fExecutor(executor) {}
+
+    void add(std::function<void(void)> work) override {
+        fAdded++;
+        fExecutor->add(std::move(work));
+    }
+    void borrow() override { fExecutor->borrow(); }
+
+    int added() const { return fAdded.load(); }
+
+private:
+    SkExecutor* fExecutor;
+    std::atomic<int> fAdded{0};
+};
+
+// Decoding with SkCodec::Options::fExecutor must match a serial decode exactly, and must actually
+// use the executor, rather than quietly falling back to a serial decode.
+static void check_executor_decode(skiatest::Reporter* r, const char* path) {
+    sk_sp<SkData> data(GetResourceAsData(path));
+    if (!data) {
+        return;
+    }
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+    if (!codec) {
+        ERRORF(r, "Unable to create codec '%s'.", path);
+        return;
+    }
+    std::unique_ptr<SkExecutor> threadPool = SkExecutor::MakeFIFOThreadPool(4);
+
+    const SkImageInfo info = codec->getInfo();
+    std::vector<SkImageInfo> infos = {
+        info.makeColorType(kN32_SkColorType).makeAlphaType(kPremul_SkAlphaType),
+        info.makeColorType(kRGBA_F16_SkColorType)
+            .makeAlphaType(kPremul_SkAlphaType)
+            .makeColorSpace(SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2,
+                                                  SkNamedGamut::kAdobeRGB)),
+    };
+    if (info.isOpaque()) {
+        infos.push_back(info.makeColorType(kRGB_565_SkColorType));
+    }
+    for (const SkImageInfo& dstInfo : infos) {
+        SkBitmap serial, parallel;
+        CountingExecutor executor(threadPool.get());
+        REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                           decode_with_executor(data, dstInfo, nullptr, &serial));
+        REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                           decode_with_executor(data, dstInfo, &executor, &parallel));
+        REPORTER_ASSERT(r, executor.added() > 0, "%s decoded serially", path);
+        REPORTER_ASSERT(r, ToolUtils::equal_pixels(serial, parallel), "%s", path);
+    }
+
+    // Truncated data should report the same rows as a serial decode.
+    sk_sp<SkData> truncated = SkData::MakeSubset(data.get(), 0, data->size() / 2);
+    SkBitmap serial, parallel;
+    REPORTER_ASSERT(r, SkCodec::kIncompleteInput ==
+                       decode_with_executor(truncated, infos[0], nullptr, &serial));
+    REPORTER_ASSERT(r, SkCodec::kIncompleteInput ==
+                       decode_with_executor(truncated, infos[0], threadPool.get(), &parallel));
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(serial, parallel), "%s", path);
+}
+
+DEF_TEST(Codec_jpeg_parallel, r) {
+    // A baseline jpeg with a restart marker after every row of MCUs, so SkJpegCodec can
+    // decode it in bands.
+    check_executor_decode(r, "images/restart_markers.jpg");
+}
+
+DEF_TEST(Codec_png_pipelined, r) {
+    check_executor_decode(r, "images/mandrill_512.png");
+    check_executor_decode(r, "images/color_wheel.png");
+}
+
 static void check_color_xform(skiatest::Reporter* r, const char* path) {
     std::unique_ptr<SkAndroidCodec> codec(SkAndroidCodec::MakeFromStream(GetResourceAsStream(path)));
 
@@ -9,10 +9,13 @@
 #include "include/core/SkPoint.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkTypes.h"
+#include "include/private/SkTo.h"
 #include "src/core/SkGeometry.h"
 #include "src/pathops/SkPathOpsCubic.h"
 #include "tests/Test.h"
 
+#include <vector>
+
 static float accurate_t(float A, float B, float C, float D) {
     double roots[3];
     SkDEBUGCODE(int count =) SkDCubic::RootsValidT(A, B, C, D, roots);
@@ -73,3 +76,37 @@ DEF_TEST(CubicMap, r) {
         }
     }
 }
+
+DEF_TEST(CubicMap_batch, r) {
+    const SkPoint pts[] = {
+        {0, 0}, {1, 1}, {0.5f, 0}, {0.42f, 0}, {0.58f, 1}, {0.25f, 0.1f}, {1, 0}, {0, 1},
+    };
+
+    std::vector<SkCubicMap> cmaps;
+    for (const auto& p1 : pts) {
+        for (const auto& p2 : pts) {
+            cmaps.emplace_back(p1, p2);
+        }
+    }
+
+    // Mixes all map types, and includes out-of-range and near-endpoint x values.
+    std::vector<const SkCubicMap*> maps;
+    std::vector<float> xs;
+    for (const auto& cmap : cmaps) {
+        for (float x = -0.1f; x <= 1.1f; x += 1.0f / 64) {
+            maps.push_back(&cmap);
+            xs.push_back(x);
+        }
+        maps.push_back(&cmap);
+        xs.push_back(0.000001f);
+    }
+
+    std::vector<float> ys(xs.size());
+    SkCubicMap::ComputeYFromX(maps.data(), xs.data(), ys.data(), SkToInt(xs.size()));
+
+    for (size_t i = 0; i < xs.size(); ++i) {
+        const auto y = maps[i]->computeYFromX(xs[i]);
+        REPORTER_ASSERT(r, SkScalarAbs(y - ys[i]) < 0.0001f, "x: %g, y: %g, batch y: %g",
+                        xs[i], y, ys[i]);
+    }
+}
@@ -7,6 +7,7 @@
 
 #include "tests/Test.h"
 
+#include "include/core/SkData.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "src/core/SkArenaAlloc.h"
@@ -468,3 +469,65 @@ DEF_TEST(JSON_ParseNumber, reporter) {
         REPORTER_ASSERT(reporter, SkScalarNearlyEqual(**jnumber, test.value, test.tolerance));
     }
 }
+
+DEF_TEST(JSON_DOM_binary, reporter) {
+    static constexpr char json[] = R"({
+        "null": null, "true": true, "false": false,
+        "ints": [0, 1, -1, 253, 254, 65535, 65536, -2147483648, 2147483647],
+        "floats": [0.5, -0.25, 1e20, -3.40282e38],
+        "strings": ["", "short", "a longer string", "key with \"escapes\""],
+        "nested": [[], {}, [[1], {"a": {"b": [true]}}]],
+        "a key longer than seven chars": "v"
+    })";
+
+    const DOM text_dom(json, strlen(json));
+    REPORTER_ASSERT(reporter, text_dom.root().is<ObjectValue>());
+
+    SkDynamicMemoryWStream stream;
+    text_dom.writeBinary(&stream);
+    const auto binary = stream.detachAsData();
+    const auto* data = static_cast<const char*>(binary->data());
+
+    REPORTER_ASSERT(reporter, DOM::IsBinary(data, binary->size()));
+    REPORTER_ASSERT(reporter, !DOM::IsBinary(json, strlen(json)));
+
+    const DOM binary_dom(data, binary->size());
+    REPORTER_ASSERT(reporter, binary_dom.root().toString() == text_dom.root().toString());
+
+    // Truncated or corrupt inputs fail to load, rather than reading past the end.
+    for (size_t size = 0; size < binary->size(); ++size) {
+        const DOM dom(data, size);
+        REPORTER_ASSERT(reporter, dom.root().is<NullValue>());
+    }
+
+    auto corrupt = SkData::MakeWithCopy(data, binary->size());
+    static_cast<char*>(corrupt->writable_data())[8] = '\x7f';
+    const DOM corrupt_dom(static_cast<const char*>(corrupt->data()), corrupt->size());
+    REPORTER_ASSERT(reporter, corrupt_dom.root().is<NullValue>());
+}
+
+DEF_TEST(JSON_DOM_binary_numbers, reporter) {
+    // -16777217 has no exact float, so it only round-trips as an int.
+    static constexpr char json[] = "[-1, -16777217, -2147483648, 0]";
+    static constexpr double expected[] = { -1, -16777217, -2147483648.0, 0 };
+
+    const DOM text_dom(json, strlen(json));
+    SkDynamicMemoryWStream stream;
+    text_dom.writeBinary(&stream);
+    const auto binary = stream.detachAsData();
+
+    const DOM binary_dom(static_cast<const char*>(binary->data()), binary->size());
+    const ArrayValue* array = binary_dom.root();
+    REPORTER_ASSERT(reporter, array && array->size() == SK_ARRAY_COUNT(expected));
+    if (!array || array->size() != SK_ARRAY_COUNT(expected)) {
+        return;
+    }
+
+    for (size_t i = 0; i < SK_ARRAY_COUNT(expected); ++i) {
+        const NumberValue* number = (*array)[i];
+        REPORTER_ASSERT(reporter, number);
+        if (number) {
+            REPORTER_ASSERT(reporter, **number == expected[i], "%g != %g", **number, expected[i]);
+        }
+    }
+}
@@ -5,6 +5,9 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkCanvas.h"
+#include "include/core/SkShader.h"
+#include "include/core/SkSurface.h"
 #include "include/gpu/GrDirectContext.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrMemoryPool.h"
@@ -259,3 +262,55 @@ DEF_GANESH_TEST(OpChainTest, reporter, /*ctxInfo*/, CtsEnforcement::kApiLevel_T)
         }
     }
 }
+
+DEF_GANESH_TEST(OpChainBatchingStats, reporter, /*ctxInfo*/, CtsEnforcement::kNever) {
+    sk_sp<GrDirectContext> dContext = GrDirectContext::MakeMock(nullptr);
+    SkASSERT(dContext);
+    using Failure = GrRecordingContextPriv::OpBatchingStats::Failure;
+    auto& stats = dContext->priv().opBatchingStats();
+
+    const SkImageInfo ii = SkImageInfo::Make(64, 64, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(dContext.get(), SkBudgeted::kNo, ii);
+    SkCanvas* canvas = surface->getCanvas();
+
+    // Nothing is recorded unless the stats are enabled.
+    canvas->drawRect(SkRect::MakeXYWH(0, 0, 4, 4), SkPaint());
+    surface->flushAndSubmit();
+    REPORTER_ASSERT(reporter, stats.fOpTypes.empty());
+    REPORTER_ASSERT(reporter, stats.fOpsExecutedPerFlush.empty());
+
+    stats.fEnabled = true;
+    // Three rects with the same paint merge into a single op.
+    SkPaint paint;
+    for (int i = 0; i < 3; ++i) {
+        canvas->drawRect(SkRect::MakeXYWH(8 * i, 0, 4, 4), paint);
+    }
+    // A paint with a shader needs a different processor set, so FillRectOp refuses to merge it.
+    SkPaint shaderPaint;
+    shaderPaint.setShader(SkShaders::Color(SK_ColorRED));
+    canvas->drawRect(SkRect::MakeXYWH(32, 0, 4, 4), shaderPaint);
+    surface->flushAndSubmit();
+    stats.fEnabled = false;
+
+    auto fillRect = stats.fOpTypes.find("FillRectOp");
+    REPORTER_ASSERT(reporter, fillRect != stats.fOpTypes.end());
+    if (fillRect == stats.fOpTypes.end()) {
+        return;
+    }
+    const auto& fillRectStats = fillRect->second;
+    REPORTER_ASSERT(reporter, fillRectStats.fRecorded == 4);
+    REPORTER_ASSERT(reporter, fillRectStats.fMerged == 2);
+    REPORTER_ASSERT(reporter, fillRectStats.fExecuted == 2);
+    REPORTER_ASSERT(reporter, fillRectStats.fFailures[(int)Failure::kDifferentProcessors] >= 1);
+    REPORTER_ASSERT(reporter, fillRectStats.fFailures[(int)Failure::kOpDeclined] == 0);
+
+    // Every recorded op is either merged into another op or executed, once, in the one flush.
+    REPORTER_ASSERT(reporter, stats.fOpsExecutedPerFlush.count() == 1);
+    int executed = 0;
+    for (const auto& [name, op] : stats.fOpTypes) {
+        REPORTER_ASSERT(reporter, op.fRecorded == op.fMerged + op.fExecuted, "%s", name.c_str());
+        executed += op.fExecuted;
+    }
+    REPORTER_ASSERT(reporter, stats.fOpsExecutedPerFlush.count() == 1 &&
+                              stats.fOpsExecutedPerFlush[0] == executed);
+}
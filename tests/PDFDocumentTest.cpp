@@ -9,7 +9,9 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkExecutor.h"
+#include "include/core/SkFont.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkTypeface.h"
 #include "include/docs/SkPDFDocument.h"
 #include "src/core/SkOSFile.h"
 #include "src/utils/SkOSPath.h"
@@ -17,6 +19,10 @@
 
 #include "tools/ToolUtils.h"
 
+#include <map>
+#include <string>
+#include <string_view>
+
 static void test_empty(skiatest::Reporter* reporter) {
     SkDynamicMemoryWStream stream;
 
@@ -256,3 +262,67 @@ DEF_TEST(SkPDF_abort_jobs, rep) {
     doc->abort();
 }
 
+
+// Returns each indirect object's contents, keyed by object number. Jobs run on an executor finish
+// in any order, so the objects' offsets differ from one run to the next, but their contents don't.
+static std::map<int, std::string> pdf_objects(const SkData& data) {
+    std::string_view pdf(static_cast<const char*>(data.data()), data.size());
+    std::map<int, std::string> objects;
+    size_t start = 0;
+    while ((start = pdf.find(" 0 obj\n", start)) != std::string_view::npos) {
+        size_t lineStart = pdf.rfind('\n', start);
+        lineStart = lineStart == std::string_view::npos ? 0 : lineStart + 1;
+        int objectNumber = atoi(std::string(pdf.substr(lineStart, start - lineStart)).c_str());
+        size_t end = pdf.find("\nendobj\n", start);
+        if (end == std::string_view::npos) {
+            break;
+        }
+        objects[objectNumber] = std::string(pdf.substr(start, end - start));
+        start = end;
+    }
+    return objects;
+}
+
+static sk_sp<SkData> make_multipage_pdf(SkExecutor* executor) {
+    sk_sp<SkTypeface> typeface = MakeResourceAsTypeface("fonts/Roboto-Regular.ttf");
+    SkFont font(typeface, 12);
+    SkPDF::Metadata metadata;
+    metadata.fExecutor = executor;
+    SkDynamicMemoryWStream stream;
+    auto doc = SkPDF::MakeDocument(&stream, metadata);
+    for (int page = 0; page < 8; ++page) {
+        SkCanvas* canvas = doc->beginPage(612, 792);
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(64, 64);
+        bitmap.eraseColor(SkColorSetARGB(0xFF, 0x20 * page, 0x80, 0xFF - 0x20 * page));
+        canvas->drawImage(bitmap.asImage(), 36, 36);
+        for (int line = 0; line < 10; ++line) {
+            canvas->drawString("The quick brown fox jumps over the lazy dog.",
+                               36, 200 + 14 * line, font, SkPaint());
+        }
+        canvas->drawCircle(306, 700, 20 + page, SkPaint());
+    }
+    doc->close();
+    return stream.detachAsData();
+}
+
+// The objects written by a document with an executor (content streams, images and font files)
+// match the ones written serially.
+DEF_TEST(SkPDF_executor_matches_serial, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_executor_matches_serial, r);
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    sk_sp<SkData> serial = make_multipage_pdf(nullptr);
+    sk_sp<SkData> threaded = make_multipage_pdf(executor.get());
+    REPORTER_ASSERT(r, serial->size() == threaded->size());
+
+    std::map<int, std::string> serialObjects = pdf_objects(*serial);
+    std::map<int, std::string> threadedObjects = pdf_objects(*threaded);
+    REPORTER_ASSERT(r, !serialObjects.empty());
+    REPORTER_ASSERT(r, serialObjects.size() == threadedObjects.size());
+    for (const auto& [objectNumber, contents] : serialObjects) {
+        auto found = threadedObjects.find(objectNumber);
+        REPORTER_ASSERT(r, found != threadedObjects.end() && found->second == contents,
+                        "object %d differs", objectNumber);
+    }
+    REPORTER_ASSERT(r, contains(serial->bytes(), serial->size(), "/FontFile2"));
+}
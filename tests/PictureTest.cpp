@@ -25,8 +25,10 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
+#include "include/utils/SkIncrementalPicturePlayer.h"
 #include "include/utils/SkRandom.h"
 #include "src/core/SkBigPicture.h"
 #include "src/core/SkPicturePriv.h"
@@ -943,3 +945,100 @@ DEF_TEST(Picture_nested_op_count, r) {
     check(make_pic(10, leaf1),  10,  10);
     check(make_pic(10, leaf10), 10, 100);
 }
+
+DEF_TEST(Picture_IncrementalPlayer, r) {
+    // A grid of anti-aliased circles, one of which changes color from frame to frame.
+    auto make_pic = [](SkColor highlight, SkBBHFactory* factory) {
+        SkPictureRecorder rec;
+        SkCanvas* c = rec.beginRecording({0,0, 200,200}, factory);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int y = 0; y < 10; y++) {
+            for (int x = 0; x < 10; x++) {
+                paint.setColor(x == 3 && y == 7 ? highlight : SK_ColorBLUE);
+                c->drawCircle(20*x + 10.5f, 20*y + 10.5f, 9, paint);
+            }
+        }
+        return rec.finishRecordingAsPicture();
+    };
+    const SkRect dirty = SkRect::MakeXYWH(60, 140, 21.5f, 21.5f);
+
+    SkRTreeFactory factory;
+    for (SkBBHFactory* f : {static_cast<SkBBHFactory*>(nullptr),
+                            static_cast<SkBBHFactory*>(&factory)}) {
+        auto info = SkImageInfo::MakeN32Premul(200, 200);
+        SkIncrementalPicturePlayer player(SkSurface::MakeRaster(info), SkColors::kWhite);
+        player.draw(make_pic(SK_ColorRED, f));
+        int64_t pixels = player.update(make_pic(SK_ColorGREEN, f), &dirty, 1);
+        REPORTER_ASSERT(r, pixels == 22*22, "%lld", (long long)pixels);
+
+        sk_sp<SkSurface> expected = SkSurface::MakeRaster(info);
+        expected->getCanvas()->clear(SK_ColorWHITE);
+        expected->getCanvas()->drawPicture(make_pic(SK_ColorGREEN, f));
+
+        SkBitmap got, want;
+        got .allocPixels(info);
+        want.allocPixels(info);
+        REPORTER_ASSERT(r, player.surface()->readPixels(got, 0, 0));
+        REPORTER_ASSERT(r, expected->readPixels(want, 0, 0));
+        REPORTER_ASSERT(r, !memcmp(got.getPixels(), want.getPixels(), got.computeByteSize()));
+    }
+}
+
+DEF_TEST(Picture_MakeFromMappedData, r) {
+    auto make_pic = [](const SkRect& bounds, SkColor color) {
+        SkPictureRecorder rec;
+        SkCanvas* c = rec.beginRecording(bounds);
+        SkPaint paint;
+        paint.setColor(color);
+        c->drawRect(bounds.makeInset(5, 5), paint);
+        return rec.finishRecordingAsPicture();
+    };
+
+    auto surface = SkSurface::MakeRasterN32Premul(16, 16);
+    surface->getCanvas()->clear(SK_ColorMAGENTA);
+    sk_sp<SkImage> image = surface->makeImageSnapshot();
+
+    SkPictureRecorder rec;
+    SkCanvas* c = rec.beginRecording({0,0, 100,100});
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(SK_ColorBLUE);
+    c->drawPath(SkPath::Circle(50, 50, 30), paint);
+    c->save();
+        c->translate(60, 10);
+        c->drawImage(image, 0, 0);
+    c->restore();
+    c->drawPicture(make_pic({0,0, 30,30}, SK_ColorGREEN));
+    sk_sp<SkData> data = rec.finishRecordingAsPicture()->serialize();
+
+    sk_sp<SkPicture> copied = SkPicture::MakeFromData(data.get());
+    sk_sp<SkPicture> mapped = SkPicture::MakeFromMappedData(data);
+    REPORTER_ASSERT(r, copied && mapped);
+    // The mapped picture plays back from data, so must keep it alive.
+    REPORTER_ASSERT(r, !data->unique());
+    REPORTER_ASSERT(r, mapped->cullRect() == copied->cullRect());
+    REPORTER_ASSERT(r, mapped->approximateOpCount() > 0);
+
+    auto draw = [](const SkPicture* pic) {
+        SkBitmap bm;
+        bm.allocN32Pixels(100, 100);
+        SkCanvas canvas(bm);
+        canvas.clear(SK_ColorWHITE);
+        canvas.drawPicture(pic);
+        return bm;
+    };
+    SkBitmap want = draw(copied.get()),
+             got  = draw(mapped.get());
+    REPORTER_ASSERT(r, !memcmp(got.getPixels(), want.getPixels(), got.computeByteSize()));
+
+    // Round trips through serialization like any other picture.
+    sk_sp<SkPicture> reserialized = SkPicture::MakeFromData(mapped->serialize().get());
+    REPORTER_ASSERT(r, reserialized);
+    got = draw(reserialized.get());
+    REPORTER_ASSERT(r, !memcmp(got.getPixels(), want.getPixels(), got.computeByteSize()));
+
+    // Truncated data fails to load, just as it would with MakeFromData().
+    REPORTER_ASSERT(r, !SkPicture::MakeFromMappedData(SkData::MakeSubset(data.get(), 0,
+                                                                         data->size() / 2)));
+}
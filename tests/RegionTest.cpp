@@ -516,3 +516,46 @@ DEF_TEST(region_empty_iter, reporter) {
     REPORTER_ASSERT(reporter, !left);
     REPORTER_ASSERT(reporter, !right);
 }
+
+// Checks every op against a per-pixel reference, on regions mixing rects and complex shapes so
+// that both the general span merge and its single-interval fast paths are exercised.
+DEF_TEST(Region_ops_pixels, reporter) {
+    constexpr int kSize = 40;
+    SkRandom rand;
+    auto rand_region = [&](SkRegion* rgn) {
+        rgn->setEmpty();
+        for (int i = rand.nextU() % 6; i > 0; i--) {
+            SkIRect r = SkIRect::MakeXYWH(rand.nextU() % kSize, rand.nextU() % kSize,
+                                          rand.nextRangeU(1, 16), rand.nextRangeU(1, 16));
+            rgn->op(r, (SkRegion::Op)(rand.nextU() % 4));
+        }
+    };
+
+    for (int i = 0; i < 200; i++) {
+        SkRegion a, b;
+        rand_region(&a);
+        rand_region(&b);
+        for (int op = 0; op < SkRegion::kOpCnt; op++) {
+            SkRegion result;
+            result.op(a, b, (SkRegion::Op)op);
+            for (int y = 0; y < kSize + 16; y++)
+            for (int x = 0; x < kSize + 16; x++) {
+                const bool inA = a.contains(x, y),
+                           inB = b.contains(x, y);
+                bool expected = false;
+                switch ((SkRegion::Op)op) {
+                    case SkRegion::kDifference_Op:        expected =  inA && !inB; break;
+                    case SkRegion::kIntersect_Op:         expected =  inA &&  inB; break;
+                    case SkRegion::kUnion_Op:             expected =  inA ||  inB; break;
+                    case SkRegion::kXOR_Op:               expected =  inA !=  inB; break;
+                    case SkRegion::kReverseDifference_Op: expected = !inA &&  inB; break;
+                    case SkRegion::kReplace_Op:           expected =          inB; break;
+                }
+                if (result.contains(x, y) != expected) {
+                    ERRORF(reporter, "op %d differs at (%d, %d)", op, x, y);
+                    return;
+                }
+            }
+        }
+    }
+}
@@ -891,3 +891,35 @@ DEF_TEST(ReadBuffer_empty, reporter) {
     REPORTER_ASSERT(reporter, data->size() == 0);
     REPORTER_ASSERT(reporter, reader.readInt() == 321);
 }
+
+DEF_TEST(ReadBuffer_reuse, reporter) {
+    auto write = [](const char* str) {
+        SkBinaryWriteBuffer writer;
+        writer.writeInt(123);
+        writer.writeDataAsByteArray(SkData::MakeWithCString(str).get());
+        return writer.snapshotAsData();
+    };
+    sk_sp<SkData> shared = write("shared");
+    sk_sp<SkData> copied = write("copied, at another offset");
+    auto check = [&](SkReadBuffer* reader, const char* str) {
+        REPORTER_ASSERT(reporter, reader->readInt() == 123);
+        sk_sp<SkData> data = reader->readByteArrayAsData();
+        REPORTER_ASSERT(reporter, data && data->size() == strlen(str) + 1 &&
+                                  !memcmp(data->data(), str, data->size()), "%s", str);
+    };
+
+    // Byte arrays come from whichever memory the buffer was last given, whether or not it
+    // was given an SkData before.
+    SkReadBuffer reader;
+    reader.setMemory(shared);
+    check(&reader, "shared");
+    reader.setMemory(copied->data(), copied->size());
+    check(&reader, "copied, at another offset");
+    reader.setMemory(shared);
+    check(&reader, "shared");
+    reader.setMemory(nullptr);
+    REPORTER_ASSERT(reporter, reader.eof());
+    reader.setMemory(copied->data(), copied->size());
+    check(&reader, "copied, at another offset");
+    REPORTER_ASSERT(reporter, reader.isValid());
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkExecutor.h"
+#include "src/core/SkTaskGroup.h"
+
+#include "tests/Test.h"
+
+#include <atomic>
+
+static void test_batch(skiatest::Reporter* r, SkExecutor& executor) {
+    static constexpr int kN = 10000;
+    std::atomic<int> counts[kN];
+    for (std::atomic<int>& count : counts) {
+        count = 0;
+    }
+
+    SkTaskGroup group(executor);
+    group.batch(kN, [&](int i) {
+        counts[i]++;
+        // Nested groups on the same executor must not deadlock.
+        if (i % 1000 == 0) {
+            SkTaskGroup inner(executor);
+            inner.batch(10, [&](int) { counts[i]++; });
+        }
+    });
+    group.wait();
+
+    for (int i = 0; i < kN; i++) {
+        REPORTER_ASSERT(r, counts[i] == (i % 1000 == 0 ? 11 : 1), "i=%d", i);
+    }
+
+    // Empty batches are allowed and leave the group done.
+    group.batch(0, [&](int) { REPORTER_ASSERT(r, false); });
+    REPORTER_ASSERT(r, group.done());
+}
+
+DEF_TEST(SkExecutor_Batch, r) {
+    test_batch(r, SkExecutor::GetDefault());
+    test_batch(r, *SkExecutor::MakeFIFOThreadPool(4));
+    test_batch(r, *SkExecutor::MakeLIFOThreadPool(4));
+    test_batch(r, *SkExecutor::MakeWorkStealingThreadPool(4));
+    test_batch(r, *SkExecutor::MakeWorkStealingThreadPool(1));
+}
+
+DEF_TEST(SkExecutor_BatchOrder, r) {
+    // An executor that runs work as soon as it's added, like the default one when no thread pool
+    // is installed. A batch on it still runs its indices in order, as it always has.
+    class InlineExecutor final : public SkExecutor {
+    public:
+        void add(std::function<void(void)> work) override { work(); }
+    } executor;
+
+    int next = 0;
+    SkTaskGroup(executor).batch(100, [&](int i) {
+        REPORTER_ASSERT(r, i == next, "i=%d, expected %d", i, next);
+        next++;
+    });
+    REPORTER_ASSERT(r, next == 100);
+}
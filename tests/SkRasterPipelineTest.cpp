@@ -495,6 +495,43 @@ DEF_TEST(SkRasterPipeline_lowp, r) {
     }
 }
 
+DEF_TEST(SkRasterPipeline_lowp_tail, r) {
+    // Every width up to a few times the widest lowp stride must touch exactly width pixels.
+    for (int width = 1; width <= 100; width++) {
+        uint32_t rgba[128];
+        uint8_t  a8[128];
+        for (int i = 0; i < 128; i++) {
+            rgba[i] = 0x01020304 * (i+1);
+            a8[i]   = (uint8_t)(i+1);
+        }
+
+        SkRasterPipeline_MemoryCtx rgbaPtr = { rgba, 0 },
+                                     a8Ptr = {   a8, 0 };
+
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipeline::load_8888,  &rgbaPtr);
+        p.append(SkRasterPipeline::swap_rb);
+        p.append(SkRasterPipeline::store_8888, &rgbaPtr);
+        p.append(SkRasterPipeline::load_a8,    &a8Ptr);
+        p.append(SkRasterPipeline::store_a8,   &a8Ptr);
+        p.run(0,0,width,1);
+
+        for (int i = 0; i < 128; i++) {
+            uint32_t orig = 0x01020304 * (i+1),
+                     want = i < width ? (orig & 0xff00ff00)
+                                      | (orig & 0x00ff0000) >> 16
+                                      | (orig & 0x000000ff) << 16
+                                      : orig;
+            if (rgba[i] != want) {
+                ERRORF(r, "width %d, pixel %d: got %08x, want %08x\n", width, i, rgba[i], want);
+            }
+            if (a8[i] != (uint8_t)(i+1)) {
+                ERRORF(r, "width %d, pixel %d: got %02x, want %02x\n", width, i, a8[i], i+1);
+            }
+        }
+    }
+}
+
 DEF_TEST(SkRasterPipeline_swizzle, r) {
     // This takes the lowp code path
     {
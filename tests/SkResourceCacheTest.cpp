@@ -14,6 +14,7 @@
 #include "src/core/SkBitmapCache.h"
 #include "src/core/SkMipmap.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/image/SkImage_Base.h"
 #include "src/lazy/SkDiscardableMemoryPool.h"
 #include "tests/Test.h"
@@ -290,3 +291,35 @@ DEF_TEST(ResourceCache_purge, reporter) {
         }
     }
 }
+
+/*
+ *  Test the global (sharded) cache from many threads at once.
+ */
+DEF_TEST(ResourceCache_globalConcurrent, reporter) {
+    // Other tests may be using the global cache, so tag our recs to find and purge just them.
+    const int sharedID = 0x5ca1ab1e;
+    const int kThreads = 16;
+    const int kRecsPerThread = 64;
+    auto visitor = [](const SkResourceCache::Rec&, void*) { return true; };
+
+    int flags[kThreads] = {};
+    SkTaskGroup().batch(kThreads, [&](int t) {
+        for (int i = 0; i < kRecsPerThread; ++i) {
+            auto rec = std::make_unique<TestRec>(sharedID, t * kRecsPerThread + i, &flags[t]);
+            rec->fCanBePurged = true;
+            TestKey key = rec->fKey;
+            SkResourceCache::Add(rec.release());
+            // Our recs are tiny compared to the default budget, so they should still be there.
+            REPORTER_ASSERT(reporter, SkResourceCache::Find(key, visitor, nullptr));
+        }
+    });
+    for (int t = 0; t < kThreads; ++t) {
+        REPORTER_ASSERT(reporter, flags[t] & TestRec::kDidInstall);
+    }
+
+    SkResourceCache::PostPurgeSharedID(sharedID);
+    SkResourceCache::CheckMessages();
+    for (int i = 0; i < kThreads * kRecsPerThread; ++i) {
+        REPORTER_ASSERT(reporter, !SkResourceCache::Find(TestKey(sharedID, i), visitor, nullptr));
+    }
+}
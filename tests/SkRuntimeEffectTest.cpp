@@ -5,10 +5,12 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlender.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkData.h"
+#include "include/core/SkM44.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
@@ -16,6 +18,7 @@
 #include "include/effects/SkGradientShader.h"
 #include "include/effects/SkRuntimeEffect.h"
 #include "include/gpu/GrDirectContext.h"
+#include "include/private/SkMutex.h"
 #include "include/sksl/SkSLDebugTrace.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkRuntimeEffectPriv.h"
@@ -31,6 +34,7 @@
 #include "tests/Test.h"
 
 #include <algorithm>
+#include <map>
 #include <thread>
 
 #ifdef SK_GRAPHITE_ENABLED
@@ -1211,6 +1215,132 @@ DEF_TEST(SkRuntimeEffectThreaded, r) {
     }
 }
 
+DEF_TEST(SkRuntimeEffectPersistentCache, r) {
+    static constexpr char kSource[] =
+            "uniform half4 color;"
+            "uniform shader child;"
+            "half4 scale(half4 c) { return c * (false ? 0.25 : 0.5); }"
+            "half4 main(float2 p) { return scale(child.eval(p)) + color; }";
+
+    // Other tests may create effects concurrently, so only look at the entries for kSource.
+    class TestCache final : public SkRuntimeEffect::PersistentCache {
+    public:
+        sk_sp<SkData> load(const SkData& key) override {
+            SkAutoMutexExclusive lock(fMutex);
+            fLoads += IsTestKey(key);
+            auto found = fEntries.find(AsString(key));
+            return found != fEntries.end() ? found->second : nullptr;
+        }
+
+        void store(const SkData& key, const SkData& data) override {
+            SkAutoMutexExclusive lock(fMutex);
+            fStores += IsTestKey(key);
+            fEntries[AsString(key)] = SkData::MakeWithCopy(data.data(), data.size());
+        }
+
+        // Replaces (or removes, when null) the kSource entry.
+        void replace(sk_sp<SkData> data) {
+            SkAutoMutexExclusive lock(fMutex);
+            for (auto it = fEntries.begin(); it != fEntries.end();) {
+                if (!IsTestKey(*SkData::MakeWithoutCopy(it->first.data(), it->first.size()))) {
+                    ++it;
+                } else if (data) {
+                    (it++)->second = data;
+                } else {
+                    it = fEntries.erase(it);
+                }
+            }
+        }
+
+        // Returns the kSource entry, if any.
+        sk_sp<SkData> find() {
+            SkAutoMutexExclusive lock(fMutex);
+            for (const auto& [key, data] : fEntries) {
+                if (IsTestKey(*SkData::MakeWithoutCopy(key.data(), key.size()))) {
+                    return data;
+                }
+            }
+            return nullptr;
+        }
+
+        int loads()  { SkAutoMutexExclusive lock(fMutex); return fLoads;  }
+        int stores() { SkAutoMutexExclusive lock(fMutex); return fStores; }
+
+    private:
+        static std::string AsString(const SkData& data) {
+            return std::string(static_cast<const char*>(data.data()), data.size());
+        }
+        static bool IsTestKey(const SkData& key) {
+            const std::string k = AsString(key);
+            return k.size() >= strlen(kSource) &&
+                   k.compare(k.size() - strlen(kSource), std::string::npos, kSource) == 0;
+        }
+
+        SkMutex fMutex;
+        std::map<std::string, sk_sp<SkData>> fEntries;
+        int fLoads  = 0,
+            fStores = 0;
+    };
+
+    // Effects may be in the middle of being created on other threads when the cache is unset.
+    static auto* cache = new TestCache;
+    SkRuntimeEffect::SetPersistentCache(cache);
+    cache->replace(nullptr);
+    const int loads  = cache->loads(),
+              stores = cache->stores();
+
+    auto [effect, err] = SkRuntimeEffect::MakeForShader(SkString(kSource));
+    REPORTER_ASSERT(r, effect, "%s", err.c_str());
+    REPORTER_ASSERT(r, cache->loads() == loads + 1 && cache->stores() == stores + 1);
+
+    // The second effect is made from the cache entry, but is indistinguishable from the first.
+    // It only compiles its program when it is drawn.
+    auto [cached, cachedErr] = SkRuntimeEffect::MakeForShader(SkString(kSource));
+    REPORTER_ASSERT(r, cached, "%s", cachedErr.c_str());
+    REPORTER_ASSERT(r, cache->loads() == loads + 2 && cache->stores() == stores + 1);
+    if (effect && cached) {
+        REPORTER_ASSERT(r, cached->source() == effect->source());
+        REPORTER_ASSERT(r, SkRuntimeEffectPriv::Hash(*cached) ==
+                           SkRuntimeEffectPriv::Hash(*effect));
+        REPORTER_ASSERT(r, SkRuntimeEffectPriv::InterfaceData(*cached)->equals(
+                                   SkRuntimeEffectPriv::InterfaceData(*effect).get()));
+
+        auto draw = [](sk_sp<SkRuntimeEffect> e, SkBitmap* bitmap) {
+            SkRuntimeShaderBuilder builder(std::move(e));
+            builder.uniform("color") = SkV4{0.25f, 0.125f, 0, 0.25f};
+            builder.child("child") = SkShaders::Color(SK_ColorBLUE);
+            SkPaint paint;
+            paint.setShader(builder.makeShader());
+            bitmap->allocN32Pixels(4, 4);
+            SkCanvas(*bitmap).drawPaint(paint);
+        };
+        SkBitmap expected, actual;
+        draw(effect, &expected);
+        draw(cached, &actual);
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                       expected.computeByteSize()));
+    }
+
+    // Unusable entries are compiled again, and replaced.
+    cache->replace(SkData::MakeWithCString("garbage"));
+    auto [recompiled, recompiledErr] = SkRuntimeEffect::MakeForShader(SkString(kSource));
+    REPORTER_ASSERT(r, recompiled, "%s", recompiledErr.c_str());
+    REPORTER_ASSERT(r, cache->loads() == loads + 3 && cache->stores() == stores + 2);
+
+    // So are entries which fail their checksum (here, because of a bit flipped in the flags which
+    // follow the tag, version and checksum).
+    if (sk_sp<SkData> entry = cache->find()) {
+        auto mismatched = SkData::MakeWithCopy(entry->data(), entry->size());
+        static_cast<uint8_t*>(mismatched->writable_data())[sizeof("SkRuntimeEffect") + 8] ^= 0x80;
+        cache->replace(std::move(mismatched));
+    }
+    auto [rebuilt, rebuiltErr] = SkRuntimeEffect::MakeForShader(SkString(kSource));
+    REPORTER_ASSERT(r, rebuilt, "%s", rebuiltErr.c_str());
+    REPORTER_ASSERT(r, cache->loads() == loads + 4 && cache->stores() == stores + 3);
+
+    SkRuntimeEffect::SetPersistentCache(nullptr);
+}
+
 DEF_TEST(SkRuntimeColorFilterSingleColor, r) {
     // Test runtime colorfilters support filterColor4f().
     auto [effect, err] =
@@ -9,6 +9,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkM44.h"
 #include "include/core/SkPaint.h"
@@ -26,19 +27,25 @@
 #include "include/sksl/DSLCore.h"
 #include "include/sksl/SkSLVersion.h"
 #include "src/core/SkRuntimeEffectPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrShaderCaps.h"
 #include "src/sksl/SkSLCompiler.h"
 #include "src/sksl/SkSLStringStream.h"
 #include "src/sksl/SkSLUtil.h"
+#include "src/sksl/ir/SkSLFunctionDeclaration.h"
+#include "src/sksl/ir/SkSLFunctionDefinition.h"
 #include "src/sksl/ir/SkSLProgram.h"
 #include "tests/Test.h"
 #include "tests/TestHarness.h"
 #include "tools/Resources.h"
 #include "tools/gpu/GrContextFactory.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <vector>
@@ -536,3 +543,68 @@ SKSL_TEST(CPU + GPU, kApiLevel_T, VectorConstructors,              "shared/Vecto
 SKSL_TEST(CPU + GPU, kApiLevel_T, VectorToMatrixCast,              "shared/VectorToMatrixCast.sksl")
 SKSL_TEST(CPU + GPU, kApiLevel_T, VectorScalarMath,                "shared/VectorScalarMath.sksl")
 SKSL_TEST(GPU_ES3,   kNever,      WhileLoopControlFlow,            "shared/WhileLoopControlFlow.sksl")
+
+DEF_TEST(SkSLBuiltinFunctionsMaterializeConcurrently, r) {
+    // Built-in functions are compiled the first time a program looks them up. Compile programs
+    // which share some of them on many threads at once.
+    static constexpr const char* kSources[] = {
+        "half4 main(float2 p) { return unpremul(half4(sin(p.x))); }",
+        "half4 main(float2 p) { return half4(toLinearSrgb(half3(cos(p.y))), 1); }",
+        "half4 main(float2 p) { return unpremul(half4(fromLinearSrgb(half3(p.xyx)), 1)); }",
+        "half4 main(float2 p) { return half4(half3(distance(p, float2(1))), 1); }",
+    };
+    std::atomic<int> failures{0};
+    SkTaskGroup().batch(32, [&](int i) {
+        SkSL::Compiler compiler(SkSL::ShaderCapsFactory::Standalone());
+        SkSL::ProgramSettings settings;
+        if (!compiler.convertProgram(SkSL::ProgramKind::kRuntimeShader,
+                                     kSources[i % std::size(kSources)], settings)) {
+            failures++;
+        }
+    });
+    REPORTER_ASSERT(r, failures == 0);
+
+    // `unpremul` has a body in the shared module, so its definition is pulled into the program.
+    SkSL::Compiler compiler(SkSL::ShaderCapsFactory::Standalone());
+    SkSL::ProgramSettings settings;
+    settings.fOptimize = false;
+    std::unique_ptr<SkSL::Program> program =
+            compiler.convertProgram(SkSL::ProgramKind::kRuntimeShader, kSources[0], settings);
+    REPORTER_ASSERT(r, program, "%s", compiler.errorText().c_str());
+    if (program) {
+        bool foundUnpremul = false;
+        for (const SkSL::ProgramElement* element : program->fSharedElements) {
+            foundUnpremul |= element->is<SkSL::FunctionDefinition>() &&
+                             element->as<SkSL::FunctionDefinition>().declaration().name() ==
+                                     "unpremul";
+        }
+        REPORTER_ASSERT(r, foundUnpremul);
+    }
+}
+
+DEF_TEST(SkSLConvertPrograms, r) {
+    // Enough sources to be split across several tasks, with a failure in the middle of one.
+    std::vector<std::string> sources;
+    for (int i = 0; i < 20; ++i) {
+        sources.push_back(SkStringPrintf("half4 main(float2 p) { return half4(%d); }", i).c_str());
+    }
+    sources[13] = "half4 main(float2 p) { return undeclared; }";
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    std::vector<std::string> errors;
+    std::vector<std::unique_ptr<SkSL::Program>> programs = SkSL::Compiler::ConvertPrograms(
+            *executor, SkSL::ShaderCapsFactory::Standalone(), SkSL::ProgramKind::kRuntimeShader,
+            SkSpan(sources), SkSL::ProgramSettings(), &errors);
+    REPORTER_ASSERT(r, programs.size() == sources.size());
+    REPORTER_ASSERT(r, errors.size() == sources.size());
+    for (size_t i = 0; i < std::min(programs.size(), errors.size()); ++i) {
+        if (i == 13) {
+            REPORTER_ASSERT(r, !programs[i]);
+            REPORTER_ASSERT(r, errors[i].find("undeclared") != std::string::npos,
+                            "%s", errors[i].c_str());
+        } else {
+            REPORTER_ASSERT(r, programs[i], "%s", errors[i].c_str());
+            REPORTER_ASSERT(r, errors[i].empty());
+        }
+    }
+}
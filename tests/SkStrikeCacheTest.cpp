@@ -7,6 +7,7 @@
 
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkStrikeSpec.h"
+#include "src/core/SkTaskGroup.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 
@@ -48,6 +49,32 @@ DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
         REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
     }
     REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
+}
+
+DEF_TEST(SkStrikeCache_ConcurrentPurge, Reporter) {
+    SkStrikeCache cache;
+    cache.setCacheCountLimit(8);
 
+    sk_sp<SkTypeface> typeface =
+            ToolUtils::create_portable_typeface("serif", SkFontStyle::Italic());
 
+    // Many threads creating strikes spread over the shards, while the count budget forces
+    // purges from whichever thread goes over it.
+    SkTaskGroup().batch(64, [&](int i) {
+        SkFont font(typeface, 8 + i);
+        SkPaint defaultPaint;
+        SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+                font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I());
+        sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+        REPORTER_ASSERT(Reporter, strike != nullptr);
+    });
+
+    // Purges skipped while another thread was purging are left to that thread, so once every
+    // thread is done the cache is back within its budgets.
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() <= cache.getCacheCountLimit());
+    REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() <= cache.getCacheSizeLimit());
+    cache.purgeAll();
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 0);
+    REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
 }
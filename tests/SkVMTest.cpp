@@ -6,6 +6,7 @@
  */
 
 #include "include/core/SkColorPriv.h"
+#include "include/core/SkData.h"
 #include "include/core/SkStream.h"
 #include "include/private/SkColorData.h"
 #include "src/core/SkCpu.h"
@@ -114,6 +115,42 @@ DEF_TEST(SkVM_allow_jit, r) {
     }
 }
 
+DEF_TEST(SkVM_flatten, r) {
+    skvm::Builder b;
+    {
+        skvm::UPtr uniforms = b.uniform();
+        skvm::Ptr  buf      = b.varying<int>();
+        skvm::I32  x        = b.load32(buf);
+        b.store32(buf, b.add(b.mul(x, b.uniform32(uniforms, 0)), b.splat(1)));
+    }
+
+    sk_sp<SkData> flattened;
+    skvm::Program original = b.doneAndFlatten(&flattened);
+    REPORTER_ASSERT(r, flattened);
+    if (!flattened) {
+        return;
+    }
+
+    skvm::Program program = skvm::Program::MakeFromFlattened(*flattened);
+    REPORTER_ASSERT(r, !program.empty());
+    REPORTER_ASSERT(r, program.instructions().size() == original.instructions().size());
+
+    int uniforms[] = {3};
+    int buf[] = {0,1,2,3,4,5,6,7,8,9,10};
+    program.eval(std::size(buf), uniforms, buf);
+    for (int i = 0; i < (int)std::size(buf); i++) {
+        REPORTER_ASSERT(r, buf[i] == 3*i+1);
+    }
+
+    // Truncated or corrupted programs should be rejected.
+    sk_sp<SkData> truncated = SkData::MakeSubset(flattened.get(), 0, flattened->size() - 4);
+    REPORTER_ASSERT(r, skvm::Program::MakeFromFlattened(*truncated).empty());
+
+    sk_sp<SkData> corrupt = SkData::MakeWithCopy(flattened->data(), flattened->size());
+    static_cast<uint32_t*>(corrupt->writable_data())[0] ^= 1;
+    REPORTER_ASSERT(r, skvm::Program::MakeFromFlattened(*corrupt).empty());
+}
+
 DEF_TEST(SkVM_LoopCounts, r) {
     // Make sure we cover all the exact N we want.
 
@@ -8,12 +8,14 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkOverdrawCanvas.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkRRect.h"
 #include "include/core/SkRegion.h"
 #include "include/core/SkSurface.h"
 #include "include/effects/SkColorMatrix.h"
+#include "include/effects/SkGradientShader.h"
 #include "include/gpu/GrBackendSurface.h"
 #include "include/gpu/GrDirectContext.h"
 #include "src/core/SkAutoPixmapStorage.h"
@@ -1282,3 +1284,84 @@ DEF_TEST(VMBlitterInfiniteColorShader, r) {
     auto surface = SkSurface::MakeRasterN32Premul(8, 8);
     surface->getCanvas()->drawPaint(paint);
 }
+
+DEF_TEST(Surface_RasterThreaded, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(1000, 900);
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    auto draw = [](SkCanvas* canvas) {
+        canvas->clear(SK_ColorWHITE);
+
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setDither(true);
+        const SkPoint pts[] = {{0, 0}, {1000, 900}};
+        const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+        paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                     SkTileMode::kClamp));
+        canvas->drawPaint(paint);
+
+        paint.setShader(nullptr);
+        paint.setColor(0x8000FF00);
+        canvas->drawCircle(500, 450, 400.5f, paint);
+        canvas->drawRRect(SkRRect::MakeRectXY({37.3f, 611.7f, 950, 890}, 20, 30), paint);
+
+        canvas->save();
+        canvas->rotate(17);
+        canvas->clipRect({100, 100, 800, 700}, true);
+        paint.setColor(0x800000FF);
+        paint.setStyle(SkPaint::kStroke_Style);
+        paint.setStrokeWidth(9);
+        canvas->drawOval({50, 50, 900, 800}, paint);
+        canvas->restore();
+
+        // Layers should inherit the executor.
+        canvas->saveLayerAlpha(nullptr, 0x80);
+        paint.setStyle(SkPaint::kFill_Style);
+        paint.setColor(SK_ColorBLACK);
+        canvas->drawRect({10.5f, 10.5f, 990.5f, 300.25f}, paint);
+        canvas->restore();
+
+        // Hairlines and points crossing the band seams (every 256 rows).
+        paint.setStyle(SkPaint::kStroke_Style);
+        paint.setColor(0xC0FF8000);
+        for (bool aa : {false, true}) {
+            paint.setAntiAlias(aa);
+            paint.setStrokeWidth(0);
+            canvas->drawLine(3.3f, 7.7f, 997.1f, 893.4f, paint);
+            canvas->drawPath(SkPath().moveTo(900.2f, 20.6f)
+                                     .quadTo(-300, 450, 880.9f, 870.3f)
+                                     .lineTo(120.5f, 511.5f), paint);
+            canvas->drawRect({40.5f, 200.25f, 960.75f, 780.5f}, paint);
+            canvas->drawRRect(SkRRect::MakeRectXY({60.5f, 240.5f, 940.5f, 800.5f}, 40, 30),
+                              paint);
+            paint.setStrokeWidth(0.5f);  // Thin AA strokes are drawn as hairlines too.
+            canvas->drawOval({25.5f, 30.5f, 975.5f, 870.5f}, paint);
+            const SkPoint points[] = {{10, 10}, {990.5f, 255.5f}, {20.25f, 700}, {700, 512}};
+            canvas->drawPoints(SkCanvas::kPolygon_PointMode, std::size(points), points, paint);
+        }
+    };
+
+    auto check = [&](SkSurface* serial, SkSurface* threaded) {
+        REPORTER_ASSERT(r, serial && threaded);
+        if (!serial || !threaded) {
+            return;
+        }
+        draw(serial->getCanvas());
+        draw(threaded->getCanvas());
+
+        SkBitmap expected, actual;
+        expected.allocPixels(info);
+        actual.allocPixels(info);
+        REPORTER_ASSERT(r, serial->readPixels(expected, 0, 0));
+        REPORTER_ASSERT(r, threaded->readPixels(actual, 0, 0));
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                       expected.computeByteSize()));
+    };
+
+    auto serial   = SkSurface::MakeRaster(info);
+    auto threaded = SkSurface::MakeRasterThreaded(info, executor.get());
+    check(serial.get(), threaded.get());
+    // Surfaces made from a threaded surface draw on its executor too.
+    check(serial->makeSurface(info).get(), threaded->makeSurface(info).get());
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkData.h"
+#include "include/core/SkGraphics.h"
+#include "include/core/SkStream.h"
+#include "modules/skottie/include/Skottie.h"
+#include "src/utils/SkJSON.h"
+
+#include "tools/flags/CommandLineFlags.h"
+
+// Converts a Lottie JSON animation to the pre-parsed binary encoding (see
+// skjson::DOM::writeBinary), which skottie::Animation::Builder loads directly.
+
+static DEFINE_string2(input, i, "", "skottie animation to convert");
+static DEFINE_string2(output, o, "", "binary file to create");
+static DEFINE_bool2(verbose, v, false, "verbose mode");
+
+int main(int argc, char** argv) {
+    SkGraphics::Init();
+
+    CommandLineFlags::SetUsage("Converts skottie JSON to the pre-parsed binary format");
+    CommandLineFlags::Parse(argc, argv);
+
+    if (FLAGS_input.isEmpty() || FLAGS_output.isEmpty()) {
+        SkDebugf("-i input_file.json and -o output_file arguments required\n");
+        return -1;
+    }
+
+    const auto data = SkData::MakeFromFileName(FLAGS_input[0]);
+    if (!data) {
+        SkDebugf("Can't read %s\n", FLAGS_input[0]);
+        return -1;
+    }
+
+    const skjson::DOM dom(static_cast<const char*>(data->data()), data->size());
+    if (!dom.root().is<skjson::ObjectValue>()) {
+        SkDebugf("Failed to parse %s\n", FLAGS_input[0]);
+        return -1;
+    }
+
+    SkDynamicMemoryWStream binary;
+    dom.writeBinary(&binary);
+    const auto binary_data = binary.detachAsData();
+
+    // Make sure the result still loads as an animation.
+    skottie::Animation::Builder json_builder, binary_builder;
+    const auto json_anim   = json_builder.make(static_cast<const char*>(data->data()),
+                                               data->size()),
+               binary_anim = binary_builder.make(static_cast<const char*>(binary_data->data()),
+                                                 binary_data->size());
+    if (!json_anim || !binary_anim) {
+        SkDebugf("%s is not a valid animation\n", FLAGS_input[0]);
+        return -1;
+    }
+
+    if (FLAGS_verbose) {
+        SkDebugf("JSON:   %zu bytes, parsed in %.3f ms\n",
+                 data->size(), json_builder.getStats().fJsonParseTimeMS);
+        SkDebugf("Binary: %zu bytes, loaded in %.3f ms\n",
+                 binary_data->size(), binary_builder.getStats().fJsonParseTimeMS);
+    }
+
+    SkFILEWStream ostream(FLAGS_output[0]);
+    if (!ostream.isValid() || !ostream.write(binary_data->data(), binary_data->size())) {
+        SkDebugf("Can't write output file %s\n", FLAGS_output[0]);
+        return -1;
+    }
+
+    return 0;
+}
@@ -7,6 +7,7 @@
 
 #include "experimental/ffmpeg/SkVideoEncoder.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
@@ -14,6 +15,7 @@
 #include "include/private/SkTPin.h"
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skresources/include/SkResources.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/utils/SkOSPath.h"
 
 #include "tools/flags/CommandLineFlags.h"
@@ -21,6 +23,10 @@
 
 #include "include/gpu/GrContextOptions.h"
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 static DEFINE_string2(input, i, "", "skottie animation to render");
 static DEFINE_string2(output, o, "", "mp4 file to create");
 static DEFINE_string2(assetPath, a, "", "path to assets needed for json file");
@@ -29,6 +35,7 @@ static DEFINE_bool2(verbose, v, false, "verbose mode");
 static DEFINE_bool2(loop, l, false, "loop mode for profiling");
 static DEFINE_int(set_dst_width, 0, "set destination width (height will be computed)");
 static DEFINE_bool2(gpu, g, false, "use GPU for rendering");
+static DEFINE_int(threads, 0, "Number of raster worker threads (0 -> cores count).");
 
 static void produce_frame(SkSurface* surf, skottie::Animation* anim, double frame) {
     anim->seekFrame(frame);
@@ -64,7 +71,8 @@ int main(int argc, char** argv) {
     }
     SkDebugf("assetPath %s\n", assetPath.c_str());
 
-    auto animation = skottie::Animation::Builder()
+    // Raster frames are rendered in parallel, by clones of the animation.
+    auto animation = skottie::Animation::Builder(skottie::Animation::Builder::kAllowClone)
         .setResourceProvider(skresources::FileResourceProvider::Make(assetPath))
         .makeFromFile(FLAGS_input[0]);
     if (!animation) {
@@ -97,6 +105,11 @@ int main(int argc, char** argv) {
     sk_sp<SkSurface> surf;
     sk_sp<SkData> data;
 
+    // Raster workers, rendering consecutive frames: worker 0 uses |surf| and |animation|.
+    std::unique_ptr<SkExecutor> executor;
+    std::vector<sk_sp<SkSurface>> worker_surfs;
+    std::vector<sk_sp<skottie::Animation>> worker_anims;
+
     const auto info = SkImageInfo::MakeN32Premul(dim);
     do {
         double loop_start = SkTime::GetSecs();
@@ -124,9 +137,52 @@ int main(int argc, char** argv) {
                 surf = SkSurface::MakeRaster(info);
             }
             surf->getCanvas()->scale(scale, scale);
+
+            const int threads = FLAGS_threads > 0
+                    ? FLAGS_threads
+                    : static_cast<int>(std::thread::hardware_concurrency());
+            worker_surfs.push_back(surf);
+            worker_anims.push_back(animation);
+            for (int t = 1; !grctx && t < threads; ++t) {
+                auto worker_anim = animation->clone();
+                if (!worker_anim) {
+                    break;
+                }
+                worker_surfs.push_back(SkSurface::MakeRaster(info));
+                worker_surfs.back()->getCanvas()->scale(scale, scale);
+                worker_anims.push_back(std::move(worker_anim));
+            }
+            if (worker_surfs.size() > 1) {
+                executor = SkExecutor::MakeFIFOThreadPool(static_cast<int>(worker_surfs.size()));
+            }
+        }
+
+        if (executor) {
+            const int workers = static_cast<int>(worker_surfs.size());
+            for (int batch_start = 0; batch_start <= frames; batch_start += workers) {
+                const int batch_size = std::min(workers, frames + 1 - batch_start);
+                if (FLAGS_verbose) {
+                    SkDebugf("rendering frames %g-%g\n", batch_start * fps_scale,
+                             (batch_start + batch_size - 1) * fps_scale);
+                }
+
+                SkTaskGroup tg(*executor);
+                tg.batch(batch_size, [&](int k) {
+                    produce_frame(worker_surfs[k].get(), worker_anims[k].get(),
+                                  (batch_start + k) * fps_scale);
+                });
+                tg.wait();
+
+                // The encoder wants the frames in order.
+                for (int k = 0; k < batch_size; ++k) {
+                    SkPixmap pm;
+                    SkAssertResult(worker_surfs[k]->peekPixels(&pm));
+                    encoder.addFrame(pm);
+                }
+            }
         }
 
-        for (int i = 0; i <= frames; ++i) {
+        for (int i = 0; !executor && i <= frames; ++i) {
             const double frame = i * fps_scale;
             if (FLAGS_verbose) {
                 SkDebugf("rendering frame %g\n", frame);